@@ -8,76 +8,39 @@
 // Written by Antares Husky (antares xavier kiriakov)                        //
 // Distributed under the GNU AGPLv3 license                                  //
 // xray77n@gmail.com                                                         //
-// 04 AUG 2019; Last revision: 05 AUG 2019                                   //
+// 04 AUG 2019; Last revision: 17 OCT 2026                                   //
 //***************************************************************************//
 
 
-#include<AccelStepper.h>
 
 #include "atrox.h"
+#include "hal.h"
+#include "kinematics.h"
+#include "planner.h"
+#include "stats.h"
+#include "stepper.h"
 
 
-/*  Atrox constructor Atrox(const int[6][6])
-    > constructs the system by defining default motor settings
+//ends of the per axis templates, see the bottom of this file
+template<> void Atrox::setupAxes<AXIS_COUNT>(){}
+template<> float Atrox::homingSeconds<AXIS_COUNT>(){ return 0; }
+template<> void Atrox::homingSteps<AXIS_COUNT>(long step[], const float seconds){}
+
+
+/*  Atrox constructor Atrox(Planner*, Stepper*)
+    > constructs the system with the motor settings of the machine profile
+      and the motors engaged
     arges:
-      const int[6][6]: an array of motor settings
-*/
-Atrox::Atrox(const int motorSet[6][6]){
-  xMotor.stepPerRev = motorSet[0][0];
-  xMotor.microstepFactor = motorSet[0][1];
-  xMotor.gboxReductionFactor = motorSet[0][2];
-  xMotor.gboxIncreaseFactor = motorSet[0][3];
-  xMotor.speedStep = xMotor.maxSpeedStep = motorSet[0][4];
-  xMotor.speedStep = xMotor.maxAccelStep = motorSet[0][5];
-  xMotor.motorhw.setMaxSpeed(xMotor.maxSpeedStep);
-  xMotor.motorhw.setEnablePin(MOTOR_ENABLE_PIN);
-
-  yMotor.stepPerRev = motorSet[1][0];
-  yMotor.microstepFactor = motorSet[1][1];
-  yMotor.gboxReductionFactor = motorSet[1][2];
-  yMotor.gboxIncreaseFactor = motorSet[1][3];
-  yMotor.speedStep = yMotor.maxSpeedStep = motorSet[1][4];
-  yMotor.speedStep = yMotor.maxAccelStep = motorSet[1][5];
-  yMotor.motorhw.setMaxSpeed(yMotor.maxSpeedStep);
-  yMotor.motorhw.setEnablePin(MOTOR_ENABLE_PIN);
-
-  zMotor.stepPerRev = motorSet[2][0];
-  zMotor.microstepFactor = motorSet[2][1];
-  zMotor.gboxReductionFactor = motorSet[2][2];
-  zMotor.gboxIncreaseFactor = motorSet[2][3];
-  zMotor.speedStep = zMotor.maxSpeedStep = motorSet[2][4];
-  zMotor.speedStep = zMotor.maxAccelStep = motorSet[2][5];
-  zMotor.motorhw.setMaxSpeed(zMotor.maxSpeedStep);
-  zMotor.motorhw.setEnablePin(MOTOR_ENABLE_PIN);
-
-  wMotor.stepPerRev = motorSet[3][0];
-  wMotor.microstepFactor = motorSet[3][1];
-  wMotor.gboxReductionFactor = motorSet[3][2];
-  wMotor.gboxIncreaseFactor = motorSet[3][3];
-  wMotor.speedStep = wMotor.maxSpeedStep = motorSet[3][4];
-  wMotor.speedStep = wMotor.maxAccelStep = motorSet[3][5];
-  wMotor.motorhw.setMaxSpeed(wMotor.maxSpeedStep);
-  wMotor.motorhw.setEnablePin(MOTOR_ENABLE_PIN);
-
-  pMotor.stepPerRev = motorSet[4][0];
-  pMotor.microstepFactor = motorSet[4][1];
-  pMotor.gboxReductionFactor = motorSet[4][2];
-  pMotor.gboxIncreaseFactor = motorSet[4][3];
-  pMotor.speedStep = pMotor.maxSpeedStep = motorSet[5][4];
-  pMotor.speedStep = pMotor.maxAccelStep = motorSet[5][5];
-  pMotor.motorhw.setMaxSpeed(pMotor.maxSpeedStep);
-  pMotor.motorhw.setEnablePin(MOTOR_ENABLE_PIN);
-
-  rMotor.stepPerRev = motorSet[5][0];
-  rMotor.microstepFactor = motorSet[5][1];
-  rMotor.gboxReductionFactor = motorSet[5][2];
-  rMotor.gboxIncreaseFactor = motorSet[5][3];
-  rMotor.speedStep = rMotor.maxSpeedStep = motorSet[6][4];
-  rMotor.speedStep = rMotor.maxAccelStep = motorSet[6][5];
-  rMotor.motorhw.setMaxSpeed(rMotor.maxSpeedStep);
-  rMotor.motorhw.setEnablePin(MOTOR_ENABLE_PIN);
-
-}
+      Planner* plnPtr: address of the planner queueing the moves
+      Stepper* stpPtr: address of the step generator executing the moves
+*/
+Atrox::Atrox(Planner* plnPtr, Stepper* stpPtr){
+  plannerPtr = plnPtr;
+  stepperPtr = stpPtr;
+  pinMode(MOTOR_ENABLE_PIN, OUTPUT);
+  engageSteppers();
+  setupAxes<0>();
+} //end Atrox::Atrox(Planner*, Stepper*)
 
 
 /*  void Atrox::releaseSteppers()
@@ -86,12 +49,7 @@ Atrox::Atrox(const int motorSet[6][6]){
     returns nothing
 */
 void Atrox::releaseSteppers(){
-  xMotor.motorhw.disableOutputs();
-  yMotor.motorhw.disableOutputs();
-  zMotor.motorhw.disableOutputs();
-  wMotor.motorhw.disableOutputs();
-  pMotor.motorhw.disableOutputs();
-  rMotor.motorhw.disableOutputs();
+  halPinLow<MOTOR_ENABLE_PIN>();
   return;
 } //end Atrox::releaseSteppers()
 
@@ -102,12 +60,7 @@ void Atrox::releaseSteppers(){
     returns nothing
 */
 void Atrox::engageSteppers(){
-  xMotor.motorhw.enableOutputs();
-  yMotor.motorhw.enableOutputs();
-  zMotor.motorhw.enableOutputs();
-  wMotor.motorhw.enableOutputs();
-  pMotor.motorhw.enableOutputs();
-  rMotor.motorhw.enableOutputs();
+  halPinHigh<MOTOR_ENABLE_PIN>();
   return;
 } //end Atrox::engageSteppers()
 
@@ -147,7 +100,7 @@ void Atrox::moveAxis(const Axis axis, const int val, const dynamicsData cmdDynam
 void Atrox::moveAxis(const Axis axis, const float val, const dynamicsData cmdDynamics){
   switch(angUnit){
     case STEP:
-      moveAxisStep(axis, (int)val, cmdDynamics);
+      moveAxisStep(axis, (int)lround(val), cmdDynamics);
       break;
     case DEGREE:
       moveAxisDegree(axis, val, cmdDynamics);
@@ -157,70 +110,703 @@ void Atrox::moveAxis(const Axis axis, const float val, const dynamicsData cmdDyn
 } // end Atrox::moveAxis(Axis, float)
 
 
-/*  protected void Atrox::moveAxisStep(const Axis axis, const int step, const dynamicsData cmdDynamics)
-    > moves a single axis to target position using a step command
-      this is a blocking function
+/*  void Atrox::moveAxes(const float val[], const dynamicsData cmdDynamics)
+    > moves all axes together, by an amount per axis in RELATIVE_POS or
+      to a work position per axis in ABSOLUTE_POS, see Atrox::posMode
+      axes not to be moved are given NAN
     args:
-      const Axis axis: the axis to be moved
-      const int step: the amount to move, in step
-      const dynamicsData cmdDynamics: the dynamics data of the movement
+      const float val[]: movement value per axis, indexed by Axis
+      const dynamicsData cmdDynamics: the dynamics behaviour of the movement
     returns nothing
 */
-void Atrox::moveAxisStep(const Axis axis, const int step, const dynamicsData cmdDynamics){
-  motorData* motorDataPtr;
-  switch(axis){
-    case X_AXIS:
-      motorDataPtr = &xMotor;
-      break;
-    case Y_AXIS:
-      motorDataPtr = &yMotor;
-      break;
-    case Z_AXIS:
-      motorDataPtr = &zMotor;
-      break;
-    case W_AXIS:
-      motorDataPtr = &wMotor;
-      break;
-    case P_AXIS:
-      motorDataPtr = &pMotor;
+void Atrox::moveAxes(const float val[], const dynamicsData cmdDynamics){
+  moveAxes(val, cmdDynamics, posMode);
+  return;
+} // end Atrox::moveAxes(const float[], const dynamicsData)
+
+
+/*  void Atrox::moveAxes(const float val[], const dynamicsData cmdDynamics, const PosMode mode)
+    > overloaded to take the positioning mode, for moves that are always
+      relative whatever Atrox::posMode is
+      axes not to be moved are given NAN
+    args:
+      const float val[]: movement value per axis, indexed by Axis
+      const dynamicsData cmdDynamics: the dynamics behaviour of the movement
+      const PosMode mode: ABSOLUTE_POS or RELATIVE_POS
+    returns nothing
+*/
+void Atrox::moveAxes(const float val[], const dynamicsData cmdDynamics, const PosMode mode){
+  switch(angUnit){
+    case STEP:
+      {
+        long step[AXIS_COUNT];
+        for(int axis{}; axis < AXIS_COUNT; axis++){
+          if(isnan(val[axis])){
+            step[axis] = 0;
+          }else if(mode == ABSOLUTE_POS){
+            step[axis] = lround(val[axis]) + workOffset[axis] - plannedPosition[axis];
+          }else{
+            step[axis] = lround(val[axis]); //rounded as G90 and G92 are
+          }
+        }
+        moveAxesStep(step, cmdDynamics);
+      }
       break;
-    case R_AXIS:
-      motorDataPtr = &rMotor;
+    case DEGREE:
+      moveAxesUnit(val, cmdDynamics, mode);
       break;
   }
+  return;
+} // end Atrox::moveAxes(const float[], const dynamicsData, const PosMode)
 
-  AccelStepper& motor = motorDataPtr->motorhw;
 
-  //run motor
-  bool hasAccl{true};
-  motor.move(step);
-  if(abs(cmdDynamics.angAccel) < 1.0){ //arbitrary 1step/s/s minimum
-    hasAccl = false;
-  }else{
-    motor.setAcceleration(cmdDynamics.angAccel);
+/*  void Atrox::moveTool(const float val[], const dynamicsData cmdDynamics)
+    > moves the tool to a pose, by an amount per pose axis in RELATIVE_POS
+      or to a work pose in ABSOLUTE_POS, see Atrox::posMode. the tool tip
+      goes along a straight line while the head turns, see kinematics.h
+    > X, Y, Z are the tool tip in linUnit and W, P, R the tool orientation
+      in degrees, whatever Atrox::angUnit is. speed and acceleration are
+      linear along the tip's path, or angular if the tip stands still
+    > the end pose is solved for the axes here, the path in between
+      by the step generator as it cuts the move into segments
+      axes not to be moved are given NAN. nothing is queued on a machine
+      profile without the carriage and the head, see isKinematic()
+    args:
+      const float val[]: movement value per pose axis, indexed by Axis
+      const dynamicsData cmdDynamics: the dynamics behaviour of the movement
+    returns nothing
+*/
+void Atrox::moveTool(const float val[], const dynamicsData cmdDynamics){
+  if(!isKinematic()) return;
+  float linThousandth = linUnit == IN ? 25400.0 : 1000.0;
+
+  //pose the moves queued end at, in the machine frame. the carriage
+  //becomes the tip
+  long pose[AXIS_COUNT]{};
+  long offset[3];
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(isAxisUsed(axis)) pose[axis] = stepToMilli(plannedPosition[axis], motor[axis].unitScale);
   }
-  if(abs(cmdDynamics.angSpeed < 0.00027)){ //1step/hr minimum
-    motor.setSpeed(motorDataPtr->speedStep);
-  }else{
-    motor.setSpeed(cmdDynamics.angSpeed);
+  toolOffset(pose[W_AXIS], pose[P_AXIS], offset);
+  for(int axis{}; axis <= Z_AXIS; axis++) pose[axis] += offset[axis];
+
+  long target[AXIS_COUNT];
+  float tipLengthSqr{};
+  float turnLengthSqr{};
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    float thousandth = axis <= Z_AXIS ? linThousandth : 1000.0;
+    if(isnan(val[axis]) || !isAxisUsed(axis)){
+      target[axis] = pose[axis];
+    }else if(posMode == ABSOLUTE_POS){
+      target[axis] = lround(val[axis] * thousandth) + stepToMilli(workOffset[axis], motor[axis].unitScale);
+    }else{
+      target[axis] = pose[axis] + lround(val[axis] * thousandth);
+    }
+    float change = target[axis] - pose[axis];
+    if(axis <= Z_AXIS){
+      tipLengthSqr += change * change;
+    }else{
+      turnLengthSqr += change * change;
+    }
   }
-  if(hasAccl){
-    while(motor.distanceToGo() != 0){
-      motor.run();
+
+  //the head takes the orientation as it is, the carriage the tip less
+  //the tool offset
+  long step[AXIS_COUNT]{};
+  float jointLengthSqr{};
+  toolOffset(target[W_AXIS], target[P_AXIS], offset);
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(!isAxisUsed(axis)) continue;
+    if(axis <= Z_AXIS){
+      step[axis] = milliToStep(target[axis] - offset[axis], motor[axis].unitScale) - plannedPosition[axis];
+    }else if(target[axis] != pose[axis]){
+      step[axis] = milliToStep(target[axis], motor[axis].unitScale) - plannedPosition[axis];
     }
-  }else{
-    while(motor.distanceToGo() != 0){
-      motor.runSpeedToPosition();
+    jointLengthSqr += (float)step[axis] * step[axis];
+  }
+
+  //planner takes speeds in step along the path of the axes
+  dynamicsData stepDynamics{};
+  float jointLength = sqrt(jointLengthSqr);
+  if(tipLengthSqr >= 1){
+    float stepPerUnit = jointLength / sqrt(tipLengthSqr) * linThousandth;
+    stepDynamics.angSpeed = cmdDynamics.linSpeed * stepPerUnit;
+    stepDynamics.angAccel = cmdDynamics.linAccel * stepPerUnit;
+    stepDynamics.angJerk = cmdDynamics.linJerk * stepPerUnit;
+  }else if(turnLengthSqr >= 1){
+    float stepPerUnit = jointLength / sqrt(turnLengthSqr) * 1000.0;
+    stepDynamics.angSpeed = cmdDynamics.angSpeed * stepPerUnit;
+    stepDynamics.angAccel = cmdDynamics.angAccel * stepPerUnit;
+    stepDynamics.angJerk = cmdDynamics.angJerk * stepPerUnit;
+  }
+  moveAxesStep(step, stepDynamics, true);
+  return;
+} // end Atrox::moveTool(const float[], const dynamicsData)
+
+
+/*  bool Atrox::moveArc(const float val[], const float center[], const bool isClockwise, const dynamicsData cmdDynamics)
+    > moves x and y along an arc about a center to an end, by an amount
+      per axis in RELATIVE_POS or to a work position in ABSOLUTE_POS, see
+      Atrox::posMode. z goes along with it, a helix. positions are in
+      linUnit, whatever Atrox::angUnit is. speed and acceleration are
+      linear along the arc
+    > the arc is cut into straight segments no longer than the chord that
+      cuts arcTolerance inside it. they are queued one by one as the
+      planner has room, see Atrox::run(), each turned from the last by a
+      small angle approximation and every ARC_CORRECTION_SEGMENTS exactly,
+      so the rounding does not build up. the last lands on the end given
+    > an end the same as the start is a full circle
+      axes not given are not moved, the center is an offset from the start
+    args:
+      const float val[]: movement value per axis, indexed by Axis, x, y and z only
+      const float center[]: the center, x and y offset from the start
+      const bool isClockwise: true to turn clockwise seen from +z, false counterclockwise
+      const dynamicsData cmdDynamics: the dynamics behaviour of the movement
+    returns true if the arc is being queued, false if the machine has no
+      x and y or the end is off the radius of the start
+*/
+bool Atrox::moveArc(const float val[], const float center[], const bool isClockwise,
+                    const dynamicsData cmdDynamics){
+  if(isEstop || !isAxisUsed(X_AXIS) || !isAxisUsed(Y_AXIS)) return false;
+  float linThousandth = linUnit == IN ? 25400.0 : 1000.0;
+
+  long start[3]{};
+  for(int axis{}; axis <= Z_AXIS; axis++){
+    if(!isAxisUsed(axis)) continue;
+    start[axis] = stepToMilli(plannedPosition[axis], motor[axis].unitScale);
+    if(isnan(val[axis])){
+      arcTarget[axis] = start[axis];
+    }else if(posMode == ABSOLUTE_POS){
+      arcTarget[axis] = lround(val[axis] * linThousandth) + stepToMilli(workOffset[axis], motor[axis].unitScale);
+    }else{
+      arcTarget[axis] = start[axis] + lround(val[axis] * linThousandth);
     }
   }
+
+  float endRadial[2];
+  for(int axis{}; axis <= Y_AXIS; axis++){
+    arcCenter[axis] = start[axis] + (isnan(center[axis]) ? 0 : center[axis] * linThousandth);
+    arcStartRadial[axis] = start[axis] - arcCenter[axis];
+    endRadial[axis] = arcTarget[axis] - arcCenter[axis];
+  }
+  float radius = sqrt(arcStartRadial[0] * arcStartRadial[0] + arcStartRadial[1] * arcStartRadial[1]);
+  float endRadius = sqrt(endRadial[0] * endRadial[0] + endRadial[1] * endRadial[1]);
+  if(radius < 1 || fabs(endRadius - radius) > max(ARC_RADIUS_ERROR, 0.001f * radius)) return false;
+
+  //angle from the start to the end, the long way round if the turn says so
+  float angle = atan2(arcStartRadial[0] * endRadial[1] - arcStartRadial[1] * endRadial[0],
+                      arcStartRadial[0] * endRadial[0] + arcStartRadial[1] * endRadial[1]);
+  if(isClockwise){
+    if(angle >= -1e-6) angle -= 2 * M_PI;
+  }else{
+    if(angle <= 1e-6) angle += 2 * M_PI;
+  }
+
+  //chord that cuts arcTolerance inside the arc
+  float tolerance = min((float)arcTolerance, radius);
+  float chord = 2 * sqrt(tolerance * (2 * radius - tolerance));
+  float segmentCount = min(ceil(fabs(angle) * radius / chord), 30000.0f);
+  arcSegmentsLeft = max((int)segmentCount, 1);
+  arcSegmentIndex = 0;
+  arcSegmentAngle = angle / arcSegmentsLeft;
+  float angleSqr = arcSegmentAngle * arcSegmentAngle;
+  arcCos = 1 - angleSqr / 2;
+  arcSin = arcSegmentAngle * (1 - angleSqr / 6);
+  arcRadial[0] = arcStartRadial[0];
+  arcRadial[1] = arcStartRadial[1];
+  arcStartZ = start[Z_AXIS];
+  arcSegmentZ = (float)(arcTarget[Z_AXIS] - start[Z_AXIS]) / arcSegmentsLeft;
+  float segmentChord = 2 * radius * sin(fabs(arcSegmentAngle) / 2);
+  arcSegmentLength = sqrt(segmentChord * segmentChord + arcSegmentZ * arcSegmentZ);
+
+  arcDynamics.linSpeed = cmdDynamics.linSpeed * linThousandth;
+  arcDynamics.linAccel = cmdDynamics.linAccel * linThousandth;
+  arcDynamics.linJerk = cmdDynamics.linJerk * linThousandth;
+  queueArcSegment();
+  return true;
+} // end Atrox::moveArc(const float[], const float[], const bool, const dynamicsData)
+
+
+/*  long Atrox::machinePosition(const Axis axis)
+    > gets the position of an axis as stepped so far, from the origin
+      the system started at. can be read while moving
+    args:
+      const Axis axis: the axis
+    returns the position in step
+*/
+long Atrox::machinePosition(const Axis axis){
+  return stepperPtr->position(axis);
+} // end Atrox::machinePosition(const Axis)
+
+
+/*  float Atrox::workPosition(const Axis axis)
+    > gets the position of an axis as stepped so far, from its work
+      origin, in the unit of moves. can be read while moving
+    args:
+      const Axis axis: the axis
+    returns the position in step, or in degrees or linUnit in DEGREE
+*/
+float Atrox::workPosition(const Axis axis){
+  long step = stepperPtr->position(axis) - workOffset[axis];
+  if(angUnit == STEP) return step;
+  return stepToUnit(axis, step);
+} // end Atrox::workPosition(const Axis)
+
+
+/*  void Atrox::setWorkPosition(const Axis axis, const float val)
+    > moves the work origin of an axis so that the end of the moves
+      queued is at a work position. nothing moves
+    args:
+      const Axis axis: the axis
+      const float val: the work position, in the unit of moves
+    returns nothing
+*/
+void Atrox::setWorkPosition(const Axis axis, const float val){
+  long step = angUnit == STEP ? lround(val) : unitToStepPosition(axis, val);
+  workOffset[axis] = plannedPosition[axis] - step;
+  return;
+} // end Atrox::setWorkPosition(const Axis, const float)
+
+
+/*  bool Atrox::isLinear(const Axis axis)
+    > checks whether an axis is linear, ie has a travel per rev set
+      in DEGREE, linear axes move in linUnit and rotary axes in degrees
+    args:
+      const Axis axis: the axis to check
+    returns true if the axis is linear
+*/
+bool Atrox::isLinear(const Axis axis){
+  return motor[axis].travelPerRev > 0;
+} // end Atrox::isLinear(const Axis)
+
+
+/*  void Atrox::run()
+    > feeds the moves queued in the planner to the step generator
+      steps are sent by the step generator's timer isr, this only prepares
+      the step segments ahead of it. an arc being cut queues its next
+      segment when the planner has room. the planner and the motion are
+      sampled into stats, see stats.h
+      this is a non-blocking function and must be called on every loop
+    no args
+    returns nothing
+*/
+void Atrox::run(){
+  if(stepperPtr->isAborted()){
+    //emergency stop, the timer was stopped in the interrupt
+    stepperPtr->reset();
+    plannerPtr->clear();
+    syncPlannedPosition();
+    releaseSteppers();
+    arcSegmentsLeft = 0;
+    isStopRequested = false;
+    if(homingPhase != HM_IDLE) endHoming(-1);
+  }else if(isStopRequested && stepperPtr->isHeld()){
+    stepperPtr->reset();
+    plannerPtr->clear();
+    syncPlannedPosition();
+    arcSegmentsLeft = 0;
+    isStopRequested = false;
+    if(homingPhase != HM_IDLE) endHoming(-1);
+  }else if(homingPhase != HM_IDLE){
+    runHoming();
+  }else if(stepperPtr->isJogging()){
+    runJog();
+  }else if(arcSegmentsLeft > 0 && !isStopRequested && !plannerPtr->isFull()){
+    queueArcSegment(); //one per pass, the step generator is fed in between
+  }
+  stepperPtr->prepare();
+  stats.sample(plannerPtr->blockCount(), isMoving());
+  return;
+} // end Atrox::run()
+
+
+/*  void Atrox::feedHold(const bool isLineWaiting)
+    > brakes the moving axes to a stop along the planned ramp, the moves
+      left are kept and go on with resume()
+      a stream cannot be braked nor go on from rest, it is stopped instead
+      ignored when nothing is moving and no line is waiting to be parsed,
+      a hold kept at rest would stall the next move without a word
+      safe to call from an interrupt, see Stepper::hold()
+    args:
+      const bool isLineWaiting: a line received ahead of the hold is not
+        parsed yet, it may be the move the hold is meant for
+    returns nothing
+*/
+void Atrox::feedHold(const bool isLineWaiting){
+  if(!isMoving() && !isLineWaiting) return;
+  if(stepperPtr->isStreaming()) isStopRequested = true;
+  stepperPtr->hold();
+  return;
+} // end Atrox::feedHold(const bool)
+
+
+/*  void Atrox::resume()
+    > goes on with the moves after a feed hold
+      a stop being braked for is not undone
+      safe to call from an interrupt
+    no args
+    returns nothing
+*/
+void Atrox::resume(){
+  if(!isStopRequested) stepperPtr->resume();
+  return;
+} // end Atrox::resume()
+
+
+/*  void Atrox::stop()
+    > brakes the moving axes to a stop along the planned ramp, then
+      drops every move queued. moves queued once isStopping() is false
+      run as usual, the moves are dropped by run()
+      safe to call from an interrupt
+    no args
+    returns nothing
+*/
+void Atrox::stop(){
+  isStopRequested = true;
+  stepperPtr->hold();
+  return;
+} // end Atrox::stop()
+
+
+/*  void Atrox::emergencyStop()
+    > stops stepping at once, whatever the speed, then drops every move
+      and releases the steppers. moves are refused until
+      clearEmergencyStop()
+      the step timer is stopped right here, the rest is done by run()
+      safe to call from an interrupt
+    no args
+    returns nothing
+*/
+void Atrox::emergencyStop(){
+  isEstop = true;
+  stepperPtr->abort();
+  return;
+} // end Atrox::emergencyStop()
+
+
+/*  void Atrox::clearEmergencyStop()
+    > accepts moves again after an emergency stop
+      the steppers stay released until engaged
+    no args
+    returns nothing
+*/
+void Atrox::clearEmergencyStop(){
+  isEstop = false;
+  return;
+} // end Atrox::clearEmergencyStop()
+
+
+/*  bool Atrox::isHeld()
+    > checks whether a feed hold has come to a stop
+    no args
+    returns true if held
+*/
+bool Atrox::isHeld(){
+  return stepperPtr->isHeld();
+} // end Atrox::isHeld()
+
+
+/*  bool Atrox::isStopping()
+    > checks whether a stop is still braking. moves must wait for it to
+      end, they would be dropped with the ones it stops
+    no args
+    returns true if stopping
+*/
+bool Atrox::isStopping(){
+  return isStopRequested;
+} //end Atrox::isStopping()
+
+
+/*  bool Atrox::isEstopped()
+    > checks whether an emergency stop is latched
+    no args
+    returns true if moves are refused
+*/
+bool Atrox::isEstopped(){
+  return isEstop;
+} // end Atrox::isEstopped()
+
+
+/*  bool Atrox::home(const uint8_t axisBits)
+    > starts homing the axes given that have a limit switch, all of them
+      together. each axis seeks its switch at its seek speed, backs off,
+      comes back at its latch speed, takes the latch as machine position
+      0 and backs off again, see axisHoming in machine.h
+      an axis stops on its switch while the others go on
+      call with no move queued. this is a non-blocking function, homing
+      is carried out by Atrox::run(), see homingResult()
+    args:
+      const uint8_t axisBits: bit set for axes to home, ALL_AXES for all
+    returns true if homing started
+      false if no axis given has a switch, homing is under way or an
+      emergency stop is latched
+*/
+bool Atrox::home(const uint8_t axisBits){
+  uint8_t bits{};
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if((axisBits & (1 << axis)) && isAxisHomed(axis)) bits |= 1 << axis;
+  }
+  if(bits == 0 || homingPhase != HM_IDLE || isEstop) return false;
+
+  homingBits = bits;
+  homingStatus = 1;
+  homingPhase = HM_SEEK;
+  stepperPtr->watchLimits(homingBits);
+  queueHomingMove();
+  return true;
+} // end Atrox::home(const uint8_t)
+
+
+/*  bool Atrox::isHoming()
+    > checks whether homing is under way, moves must wait for it to end
+    no args
+    returns true if homing
+*/
+bool Atrox::isHoming(){
+  return homingPhase != HM_IDLE;
+} // end Atrox::isHoming()
+
+
+/*  int Atrox::homingResult()
+    > gets how homing ended. an end is given once, later calls get 0
+    no args
+    returns int of homing status
+      status -1 indicates a switch was not found within its travel, did
+                not release, or homing was stopped
+      status 0 indicates nothing new
+      status 1 indicates homing is under way
+      status 8 indicates the axes were homed
+*/
+int Atrox::homingResult(){
+  int status = homingStatus;
+  if(status != 1) homingStatus = 0;
+  return status;
+} // end Atrox::homingResult()
+
+
+/*  bool Atrox::startJog()
+    > jogs the axes that have a joystick in the machine profile, see
+      axisJog. each stick is read every JOG_SAMPLE_US and sets the speed
+      its axis heads for, reached within the axis' acceleration. no move
+      is planned, the step generator follows the sticks segment by
+      segment, see Stepper::startJog()
+      the jog runs until a stop or an emergency stop, the planned
+      position is then taken from where the axes came to rest
+    no args
+    returns true if the jog started, false if the axes are moving or
+      homing, an emergency stop is latched or no axis has a joystick
+*/
+bool Atrox::startJog(){
+  if(isEstop || isMoving() || isHoming()) return false;
+  bool isAnyJogged{false};
+  for(int axis{}; axis < AXIS_COUNT; axis++) isAnyJogged |= isAxisJogged(axis);
+  if(!isAnyJogged) return false;
+
+  stepperPtr->startJog();
+  jogSampleAt = micros();
+  runJog();
+  return true;
+} // end Atrox::startJog()
+
+
+/*  bool Atrox::isJogging()
+    > checks whether the axes are jogged from their joystick
+    no args
+    returns true if jogging
+*/
+bool Atrox::isJogging(){
+  return stepperPtr->isJogging();
+} // end Atrox::isJogging()
+
+
+/*  bool Atrox::startStream(const SyncRole role)
+    > leaves the planner and steps the segments of a compiled stream as
+      the stream player hands them over, see stream.h and
+      Stepper::startStream(). the stream runs until endStream(), a stop
+      or an emergency stop
+      in a cell the lead ticks the sync line as it starts each segment,
+      a follower starts each one on the lead's tick, see Stepper::startSync()
+    args:
+      const SyncRole role: SY_NONE alone, SY_LEAD or SY_FOLLOW in a cell
+    returns true if the stream started, false if the axes are moving,
+      homing or jogged, an emergency stop is latched, or a cell is asked
+      of a machine profile without a sync pin
+*/
+bool Atrox::startStream(const SyncRole role){
+  if(isEstop || isMoving() || isHoming() || isJogging()) return false;
+  if(role != SY_NONE && !isSyncWired()) return false;
+  stepperPtr->startStream();
+  if(role != SY_NONE) stepperPtr->startSync(role == SY_LEAD);
+  return true;
+} // end Atrox::startStream(const SyncRole)
+
+
+/*  void Atrox::endStream()
+    > goes back to the planner once the stream is at rest, stopped or
+      not. the planned position is taken from where the axes are
+    no args
+    returns nothing
+*/
+void Atrox::endStream(){
+  stepperPtr->endStream();
+  stepperPtr->reset(); //a hold of a refused stream
+  syncPlannedPosition();
+  isStopRequested = false;
+  return;
+} // end Atrox::endStream()
+
+
+/*  bool Atrox::isStreaming()
+    > checks whether the segments of a stream are stepped
+    no args
+    returns true if streaming
+*/
+bool Atrox::isStreaming(){
+  return stepperPtr->isStreaming();
+} // end Atrox::isStreaming()
+
+
+/*  bool Atrox::isArcing()
+    > checks whether an arc still has segments to queue. moves must wait
+      for it, they would be queued among its segments
+    no args
+    returns true if an arc is being queued
+*/
+bool Atrox::isArcing(){
+  return arcSegmentsLeft > 0;
+} // end Atrox::isArcing()
+
+
+/*  bool Atrox::isMoving()
+    > checks whether any move is still queued or running, or an arc has
+      segments left to queue
+    no args
+    returns true if the system is moving
+*/
+bool Atrox::isMoving(){
+  return arcSegmentsLeft > 0 || !plannerPtr->isEmpty() || stepperPtr->isBusy();
+} // end Atrox::isMoving()
+
+
+/*  void Atrox::setupAxis(const Axis axis)
+    > derives the unit scales of an axis from its motor settings and
+      gives its limits to the planner and its scale to the step generator.
+      call after changing motor[axis]
+      this divides in 64 bit, the profile's own scales are constants,
+      see setupAxes()
+    args:
+      const Axis axis: the axis
+    returns nothing
+*/
+void Atrox::setupAxis(const Axis axis){
+  motorData& axisMotor = motor[axis];
+  //steps per output rev over thousandths of a unit per output rev
+  uint32_t stepPerRev = (uint32_t)axisMotor.stepPerRev * axisMotor.microstepFactor
+                        * axisMotor.gboxReductionFactor;
+  uint32_t unitPerRev = (uint32_t)max(axisMotor.gboxIncreaseFactor, 1)
+                        * (isLinear(axis) ? axisMotor.travelPerRev : 360000UL);
+  axisMotor.unitScale = ((uint64_t)stepPerRev << UNIT_FRAC_BITS) / unitPerRev;
+  axisMotor.stepPerUnit = 1000.0 * stepPerRev / unitPerRev;
+  axisMotor.speedStep = axisMotor.maxSpeedStep;
+  axisMotor.AccelStep = axisMotor.maxAccelStep;
+
+  if(isAxisUsed(axis)){
+    plannerPtr->setAxisLimits(axis, axisMotor.maxSpeedStep, axisMotor.maxAccelStep, axisMotor.maxJerkStep);
+    stepperPtr->setAxisScale(axis, axisMotor.unitScale);
+  }
+  return;
+} // end Atrox::setupAxis(const Axis)
+
+
+/*  void Atrox::loadProfile()
+    > restores the motor settings of the machine profile, and the units
+      and arc tolerance the system starts in
+    no args
+    returns nothing
+*/
+void Atrox::loadProfile(){
+  posMode = RELATIVE_POS;
+  linUnit = MM;
+  angUnit = STEP;
+  arcTolerance = MACHINE_ARC_TOLERANCE;
+  setupAxes<0>();
+  return;
+} // end Atrox::loadProfile()
+
+
+/*  protected void Atrox::moveAxisStep(const Axis axis, const int step, const dynamicsData cmdDynamics)
+    > queues a single axis move using a step command
+      this is a non-blocking function. the move is carried out by Atrox::run()
+    args:
+      const Axis axis: the axis to be moved
+      const int step: the amount to move, in step
+      const dynamicsData cmdDynamics: the dynamics data of the movement
+    returns nothing
+*/
+void Atrox::moveAxisStep(const Axis axis, const int step, const dynamicsData cmdDynamics){
+  long steps[AXIS_COUNT]{};
+  steps[axis] = step;
+  moveAxesStep(steps, cmdDynamics);
   return;
 } // end Atrox::moveAxisStep(const Axis, const int, const dynamicsData)
 
 
-/*  protected void Atrox::moveAxis(const Axis axis, const int degree, const dynamicsData cmdDynamics)
-    > moves a single axis to target position by a certain degree
-      will be rounded to the next valid step
-      this is a blocking function
+/*  protected void Atrox::moveAxesStep(const long step[], const dynamicsData cmdDynamics)
+    > queues a move of all axes together in the planner
+      this is a non-blocking function. the move is carried out by Atrox::run()
+    args:
+      const long step[]: the amount to move per axis, in step
+      const dynamicsData cmdDynamics: the dynamics data of the movement
+    returns nothing
+*/
+void Atrox::moveAxesStep(const long step[], const dynamicsData cmdDynamics){
+  moveAxesStep(step, cmdDynamics, false);
+  return;
+} // end Atrox::moveAxesStep(const long[], const dynamicsData)
+
+
+/*  protected void Atrox::moveAxesStep(const long step[], const dynamicsData cmdDynamics, const bool isToolPath)
+    > overloaded to take whether the move is a tool path, see planBlock
+      queues a move of all axes together in the planner
+      speed below 1step/hr, acceleration below 1step/s/s or jerk below
+      1step/s/s/s are taken as unset, the planner then uses the axes' max
+      speed, acceleration and jerk
+      this is a non-blocking function. the move is carried out by Atrox::run()
+    args:
+      const long step[]: the amount to move per axis, in step
+      const dynamicsData cmdDynamics: the dynamics data of the movement
+      const bool isToolPath: true to step the tool tip along a straight line
+    returns nothing
+*/
+void Atrox::moveAxesStep(const long step[], const dynamicsData cmdDynamics, const bool isToolPath){
+  if(isEstop) return; //refused until the emergency stop is cleared
+  float speed{cmdDynamics.angSpeed};
+  float accel{cmdDynamics.angAccel};
+  float jerk{cmdDynamics.angJerk};
+  if(abs(accel) < 1.0){ //arbitrary 1step/s/s minimum
+    accel = 0;
+  }
+  if(abs(jerk) < 1.0){ //arbitrary 1step/s/s/s minimum
+    jerk = 0;
+  }
+  if(abs(speed) < 0.00027){ //1step/hr minimum
+    speed = 0;
+  }
+  //axes the machine has no pins for do not move
+  long axisStep[AXIS_COUNT];
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    axisStep[axis] = isAxisUsed(axis) ? step[axis] : 0;
+  }
+  if(plannerPtr->bufferLine(axisStep, abs(speed), abs(accel), abs(jerk), isToolPath)){
+    for(int axis{}; axis < AXIS_COUNT; axis++) plannedPosition[axis] += axisStep[axis];
+  }
+  return;
+} // end Atrox::moveAxesStep(const long[], const dynamicsData, const bool)
+
+
+/*  protected void Atrox::moveAxisDegree(const Axis axis, const float degree, const dynamicsData cmdDynamics)
+    > moves a single axis by an amount in degrees, or in linUnit for a linear axis
+      this is a non-blocking function. the move is carried out by Atrox::run()
     args:
       const Axis axis: the axis to be moved
       const float degree: the amount to move, in degrees
@@ -228,7 +814,381 @@ void Atrox::moveAxisStep(const Axis axis, const int step, const dynamicsData cmd
     returns nothing
 */
 void Atrox::moveAxisDegree(const Axis axis, const float degree, const dynamicsData cmdDynamics){
-  //TODO: convert degree to step
-  //TODO: call function to move axis
+  float val[AXIS_COUNT]{};
+  val[axis] = degree;
+  moveAxesUnit(val, cmdDynamics, RELATIVE_POS);
+  return;
+} // end Atrox::moveAxisDegree(const Axis, const float, const dynamicsData)
+
+
+/*  protected void Atrox::moveAxesUnit(const float val[], const dynamicsData cmdDynamics, const PosMode mode)
+    > queues a move of all axes together given in units
+      rotary axes move in degrees and linear axes in linUnit. speed and
+      acceleration are in the units of the axis moving the most steps,
+      angular for a rotary one and linear for a linear one
+      this is a non-blocking function. the move is carried out by Atrox::run()
+    args:
+      const float val[]: the amount to move, or the work position, per
+                         axis, indexed by Axis. NAN for axes not moved
+      const dynamicsData cmdDynamics: the dynamics data of the movement
+      const PosMode mode: ABSOLUTE_POS or RELATIVE_POS
+    returns nothing
+*/
+void Atrox::moveAxesUnit(const float val[], const dynamicsData cmdDynamics, const PosMode mode){
+  long step[AXIS_COUNT];
+  int leadAxis{X_AXIS};
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(isnan(val[axis])){
+      step[axis] = 0;
+    }else if(mode == ABSOLUTE_POS){
+      step[axis] = unitToStepPosition((Axis)axis, val[axis]) + workOffset[axis]
+                   - plannedPosition[axis];
+    }else{
+      step[axis] = unitToStep((Axis)axis, val[axis]);
+    }
+    if(labs(step[axis]) > labs(step[leadAxis])) leadAxis = axis;
+  }
+
+  //planner takes speeds in step along the path, close to the leading axis'
+  dynamicsData stepDynamics{};
+  float stepPerUnit = motor[leadAxis].stepPerUnit;
+  if(isLinear((Axis)leadAxis)){
+    if(linUnit == IN) stepPerUnit *= 25.4;
+    stepDynamics.angSpeed = cmdDynamics.linSpeed * stepPerUnit;
+    stepDynamics.angAccel = cmdDynamics.linAccel * stepPerUnit;
+    stepDynamics.angJerk = cmdDynamics.linJerk * stepPerUnit;
+  }else{
+    stepDynamics.angSpeed = cmdDynamics.angSpeed * stepPerUnit;
+    stepDynamics.angAccel = cmdDynamics.angAccel * stepPerUnit;
+    stepDynamics.angJerk = cmdDynamics.angJerk * stepPerUnit;
+  }
+  moveAxesStep(step, stepDynamics);
+  return;
+} // end Atrox::moveAxesUnit(const float[], const dynamicsData)
+
+
+/*  protected long Atrox::unitToStep(const Axis axis, const float val)
+    > converts an amount in units to steps with the axis' fixed point scale
+      the fraction of a step left is kept and added to the next move of
+      the axis, so rounding does not add up over many small moves
+    args:
+      const Axis axis: the axis to convert for
+      const float val: the amount in degrees, or in linUnit for a linear axis
+    returns the amount in step
+*/
+long Atrox::unitToStep(const Axis axis, const float val){
+  //thousandths of a unit, millidegree or um
+  float thousandth = (isLinear(axis) && linUnit == IN) ? 25400.0 : 1000.0;
+  long milli = lround(val * thousandth);
+  if(milli == 0) return 0;
+
+  int64_t scaled = (int64_t)milli * motor[axis].unitScale + unitRemainder[axis];
+  long step = (long)(scaled >> UNIT_FRAC_BITS); //floors, the remainder stays positive
+  unitRemainder[axis] = (uint32_t)(scaled - ((int64_t)step << UNIT_FRAC_BITS));
+  return step;
+} // end Atrox::unitToStep(const Axis, const float)
+
+
+/*  protected long Atrox::unitToStepPosition(const Axis axis, const float val)
+    > converts a position in units to steps with the axis' fixed point
+      scale, rounded to the nearest step. unlike unitToStep() nothing is
+      carried over, a position does not add up
+    args:
+      const Axis axis: the axis to convert for
+      const float val: the position in degrees, or in linUnit for a linear axis
+    returns the position in step
+*/
+long Atrox::unitToStepPosition(const Axis axis, const float val){
+  float thousandth = (isLinear(axis) && linUnit == IN) ? 25400.0 : 1000.0;
+  return milliToStep(lround(val * thousandth), motor[axis].unitScale);
+} // end Atrox::unitToStepPosition(const Axis, const float)
+
+
+
+/*  protected float Atrox::stepToUnit(const Axis axis, const long step)
+    > converts steps to units, for reports
+    args:
+      const Axis axis: the axis to convert for
+      const long step: the amount in step
+    returns the amount in degrees, or in linUnit for a linear axis
+*/
+float Atrox::stepToUnit(const Axis axis, const long step){
+  float thousandth = (isLinear(axis) && linUnit == IN) ? 25400.0 : 1000.0;
+  return (float)step * ((uint32_t)1 << UNIT_FRAC_BITS) / motor[axis].unitScale / thousandth;
+} // end Atrox::stepToUnit(const Axis, const long)
+
+
+/*  protected void Atrox::syncPlannedPosition()
+    > takes the planned position from the step generator once the moves
+      queued were dropped, the moves stopped short of where they were
+      planned to end
+    no args
+    returns nothing
+*/
+void Atrox::syncPlannedPosition(){
+  for(int axis{}; axis < AXIS_COUNT; axis++) plannedPosition[axis] = stepperPtr->position(axis);
+  return;
+} // end Atrox::syncPlannedPosition()
+
+
+/*  protected void Atrox::runHoming()
+    > moves homing on to its next phase once the current one is done
+      toward a switch, the phase is done once every switch is pressed.
+      off a switch, once the move ended and every switch is released
+    no args
+    returns nothing
+*/
+void Atrox::runHoming(){
+  switch(homingPhase){
+    case HM_SEEK:
+    case HM_LATCH:
+      if((stepperPtr->lockedAxes() & homingBits) == homingBits){
+        //every axis is on its switch, the rest of the move steps nothing
+        stepperPtr->reset();
+        plannerPtr->clear();
+        stepperPtr->releaseLimits();
+        if(homingPhase == HM_LATCH){
+          for(int axis{}; axis < AXIS_COUNT; axis++){
+            if(homingBits & (1 << axis)) stepperPtr->setPosition(axis, 0);
+          }
+        }
+        syncPlannedPosition();
+        homingPhase = homingPhase == HM_SEEK ? HM_PULLOFF : HM_RELEASE;
+        queueHomingMove();
+      }else if(!isMoving()){
+        endHoming(-1); //a switch was not found within its travel
+      }
+      break;
+    case HM_PULLOFF:
+    case HM_RELEASE:
+      if(isMoving()) break;
+      if(stepperPtr->readLimits() & homingBits){
+        endHoming(-1); //a switch stayed pressed
+      }else if(homingPhase == HM_PULLOFF){
+        homingPhase = HM_LATCH;
+        stepperPtr->watchLimits(homingBits);
+        queueHomingMove();
+      }else{
+        endHoming(8);
+      }
+      break;
+    case HM_IDLE:
+      break;
+  }
+  return;
+} // end Atrox::runHoming()
+
+
+/*  protected void Atrox::queueHomingMove()
+    > queues the move of the homing phase, one move for all axes homed
+      toward the switches, every axis goes at its own speed for as long
+      as the slowest axis needs to cover its travel. off the switches,
+      every axis goes its pull-off
+    no args
+    returns nothing
+*/
+void Atrox::queueHomingMove(){
+  float seconds = homingSeconds<0>();
+  long step[AXIS_COUNT]{};
+  homingSteps<0>(step, seconds);
+
+  float lengthSqr{};
+  for(int axis{}; axis < AXIS_COUNT; axis++) lengthSqr += (float)step[axis] * step[axis];
+  dynamicsData homingDynamics{};
+  homingDynamics.angSpeed = sqrt(lengthSqr) / seconds;
+  moveAxesStep(step, homingDynamics);
+  return;
+} // end Atrox::queueHomingMove()
+
+
+/*  protected void Atrox::endHoming(const int status)
+    > ends homing and stops watching the switches
+    args:
+      const int status: how homing ended, see homingResult()
+    returns nothing
+*/
+void Atrox::endHoming(const int status){
+  stepperPtr->releaseLimits();
+  homingPhase = HM_IDLE;
+  homingStatus = status;
+  return;
+} // end Atrox::endHoming(const int)
+
+
+/*  protected void Atrox::runJog()
+    > reads the joysticks once JOG_SAMPLE_US has passed since the last
+      reading, and hands their speeds to the step generator. a late pass
+      reads at once and the rate starts over from there
+    no args
+    returns nothing
+*/
+void Atrox::runJog(){
+  unsigned long now = micros();
+  if((long)(now - jogSampleAt) < 0) return;
+  jogSampleAt += JOG_SAMPLE_US;
+  if((long)(now - jogSampleAt) >= 0) jogSampleAt = now + JOG_SAMPLE_US;
+
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(!isAxisJogged(axis)) continue;
+    float speed = joystickSpeed(axis, halAnalogRead(MACHINE_JOG[axis].analogPin));
+    stepperPtr->jog(axis, speed, motor[axis].maxAccelStep);
+  }
+  return;
+} // end Atrox::runJog()
+
+
+/*  protected void Atrox::queueArcSegment()
+    > queues the next segment of the arc being cut, see moveArc()
+      the radius is turned by the small angle approximation, a few
+      multiplies, and exactly from the start every ARC_CORRECTION_SEGMENTS
+    no args
+    returns nothing
+*/
+void Atrox::queueArcSegment(){
+  arcSegmentIndex++;
+  arcSegmentsLeft--;
+  long point[3];
+  if(arcSegmentsLeft == 0){
+    for(int axis{}; axis <= Z_AXIS; axis++) point[axis] = arcTarget[axis];
+  }else{
+    if(arcSegmentIndex % ARC_CORRECTION_SEGMENTS != 0){
+      float radial = arcRadial[0] * arcCos - arcRadial[1] * arcSin;
+      arcRadial[1] = arcRadial[0] * arcSin + arcRadial[1] * arcCos;
+      arcRadial[0] = radial;
+    }else{
+      float angle = arcSegmentIndex * arcSegmentAngle;
+      float cosAngle = cos(angle);
+      float sinAngle = sin(angle);
+      arcRadial[0] = arcStartRadial[0] * cosAngle - arcStartRadial[1] * sinAngle;
+      arcRadial[1] = arcStartRadial[0] * sinAngle + arcStartRadial[1] * cosAngle;
+    }
+    point[X_AXIS] = lround(arcCenter[0] + arcRadial[0]);
+    point[Y_AXIS] = lround(arcCenter[1] + arcRadial[1]);
+    point[Z_AXIS] = lround(arcStartZ + arcSegmentIndex * arcSegmentZ);
+  }
+
+  long step[AXIS_COUNT]{};
+  float jointLengthSqr{};
+  for(int axis{}; axis <= Z_AXIS; axis++){
+    if(!isAxisUsed(axis)) continue;
+    step[axis] = milliToStep(point[axis], motor[axis].unitScale) - plannedPosition[axis];
+    jointLengthSqr += (float)step[axis] * step[axis];
+  }
+
+  //planner takes speeds in step along the path of the axes, every
+  //segment then takes the same time whatever its steps round to
+  dynamicsData stepDynamics{};
+  float stepPerMilli = sqrt(jointLengthSqr) / arcSegmentLength;
+  stepDynamics.angSpeed = arcDynamics.linSpeed * stepPerMilli;
+  stepDynamics.angAccel = arcDynamics.linAccel * stepPerMilli;
+  stepDynamics.angJerk = arcDynamics.linJerk * stepPerMilli;
+  moveAxesStep(step, stepDynamics);
+  return;
+} // end Atrox::queueArcSegment()
+
+
+/*  protected float Atrox::joystickSpeed(const int axis, const uint16_t reading)
+    > turns a stick reading into the speed of its axis. within the
+      deadband of the center the axis stands still, past it the speed
+      grows in proportion to the max speed at the end of the travel
+    args:
+      const int axis: the axis
+      const uint16_t reading: the stick, 0-1023
+    returns the speed in step per sec, negative to step backward
+*/
+float Atrox::joystickSpeed(const int axis, const uint16_t reading){
+  const axisJog& stick = MACHINE_JOG[axis];
+  int offset = (int)reading - 512;
+  int travel = abs(offset) - stick.deadband;
+  if(travel <= 0) return 0;
+  float speed = min((float)travel / (511 - stick.deadband), 1.0f) * motor[axis].maxSpeedStep;
+  return (offset < 0) == (stick.jogDirn < 0) ? speed : -speed;
+} // end Atrox::joystickSpeed(const int, const uint16_t)
+
+
+/*  protected template<int AXIS> void Atrox::setupAxes()
+    > copies the motor settings of AXIS and the axes after it from the
+      machine profile, and gives their limits to the planner and their
+      scales to the step generator
+      the unit scales are constants, nothing is divided at run time
+    no args
+    returns nothing
+*/
+template<int AXIS> void Atrox::setupAxes(){
+  constexpr axisProfile profile = MACHINE_AXES[AXIS];
+  constexpr uint32_t unitScale = axisUnitScale(AXIS);
+  constexpr float stepPerUnit = axisStepPerUnit(AXIS);
+
+  motorData& axisMotor = motor[AXIS];
+  axisMotor.stepPerRev = profile.stepPerRev;
+  axisMotor.microstepFactor = profile.microstepFactor;
+  axisMotor.gboxReductionFactor = profile.gboxReductionFactor;
+  axisMotor.gboxIncreaseFactor = profile.gboxIncreaseFactor;
+  axisMotor.travelPerRev = profile.travelPerRev;
+  axisMotor.unitScale = unitScale;
+  axisMotor.stepPerUnit = stepPerUnit;
+  axisMotor.speedStep = axisMotor.maxSpeedStep = profile.maxSpeed;
+  axisMotor.AccelStep = axisMotor.maxAccelStep = profile.maxAccel;
+  axisMotor.maxJerkStep = profile.maxJerk;
+  unitRemainder[AXIS] = (uint32_t)1 << (UNIT_FRAC_BITS - 1); //half a step, rounds to nearest
+
+  if(isAxisUsed(AXIS)){
+    plannerPtr->setAxisLimits(AXIS, profile.maxSpeed, profile.maxAccel, profile.maxJerk);
+    stepperPtr->setAxisScale(AXIS, unitScale);
+  }
+  setupAxes<AXIS + 1>();
+  return;
+} //end Atrox::setupAxes<int>()
+
+
+/*  protected template<int AXIS> float Atrox::homingSeconds()
+    > gets the time the homing phase takes for AXIS and the axes after it
+      at their homing speeds, the slowest of them
+    no args
+    returns the time in sec
+*/
+template<int AXIS> float Atrox::homingSeconds(){
+  float seconds{};
+  if(isAxisHomed(AXIS) && (homingBits & (1 << AXIS))){
+    constexpr axisHoming homing = MACHINE_HOMING[AXIS];
+    switch(homingPhase){
+      case HM_SEEK:
+        seconds = (float)homing.seekTravel / homing.seekSpeed;
+        break;
+      case HM_LATCH:
+        seconds = 2.0 * homing.pullOff / homing.latchSpeed;
+        break;
+      default:
+        seconds = (float)homing.pullOff / homing.seekSpeed;
+        break;
+    }
+  }
+  return max(seconds, homingSeconds<AXIS + 1>());
+} //end Atrox::homingSeconds<int>()
+
+
+/*  protected template<int AXIS> void Atrox::homingSteps(long step[], const float seconds)
+    > gets the steps of the homing phase for AXIS and the axes after it
+    args:
+      long step[]: gets the steps per axis, left as it is for axes not homed
+      const float seconds: time the phase takes, see homingSeconds()
+    returns nothing
+*/
+template<int AXIS> void Atrox::homingSteps(long step[], const float seconds){
+  if(isAxisHomed(AXIS) && (homingBits & (1 << AXIS))){
+    constexpr axisHoming homing = MACHINE_HOMING[AXIS];
+    switch(homingPhase){
+      case HM_SEEK:
+        step[AXIS] = homing.homeDirn * lround(homing.seekSpeed * seconds);
+        break;
+      case HM_LATCH:
+        step[AXIS] = homing.homeDirn * lround(homing.latchSpeed * seconds);
+        break;
+      default:
+        step[AXIS] = -homing.homeDirn * (long)homing.pullOff;
+        break;
+    }
+  }
+  homingSteps<AXIS + 1>(step, seconds);
   return;
-} // end Atrox::moveAxis(Axis axis)
\ No newline at end of file
+} //end Atrox::homingSteps<int>(long[], const float)
@@ -8,73 +8,150 @@
 // Written by Antares Husky (antares xavier kiriakov)                        //
 // Distributed under the GNU AGPLv3 license                                  //
 // xray77n@gmail.com                                                         //
-// 04 AUG 2019; Last revision: 05 AUG 2019                                   //
+// 04 AUG 2019; Last revision: 17 OCT 2026                                   //
 //***************************************************************************//
 
 
 #ifndef _ATROX_H
 #define _ATROX_H
 
-#include <AccelStepper.h>
 
+#include "machine.h"
+
+enum OpMode {MD_COMMAND, MD_PROGRAM, MD_JOYSTICK, MD_BINARY, MD_STREAM};
 enum PosMode {ABSOLUTE_POS, RELATIVE_POS};
 enum LinUnit {IN, MM};
 enum AngUnit {STEP, DEGREE};
 enum Axis {X_AXIS, Y_AXIS, Z_AXIS, W_AXIS, P_AXIS, R_AXIS};
+enum HomingPhase {HM_IDLE, HM_SEEK, HM_PULLOFF, HM_LATCH, HM_RELEASE};
+enum SyncRole {SY_NONE, SY_LEAD, SY_FOLLOW};
+const int AXIS_COUNT = 6;
+static_assert(sizeof(MACHINE_AXES) / sizeof(MACHINE_AXES[0]) == AXIS_COUNT,
+              "the machine profile needs a row per axis");
+static_assert(sizeof(MACHINE_HOMING) / sizeof(MACHINE_HOMING[0]) == AXIS_COUNT,
+              "the machine profile needs a homing row per axis");
+static_assert(sizeof(MACHINE_JOG) / sizeof(MACHINE_JOG[0]) == AXIS_COUNT,
+              "the machine profile needs a joystick row per axis");
+
+//bits of every axis, as taken by Atrox::home()
+const uint8_t ALL_AXES = (1 << AXIS_COUNT) - 1;
+
+//g-code letters of the axes, indexed by Axis
+const char AXIS_LETTER[AXIS_COUNT + 1] = "XYZWPR";
+
+//fraction bits of the fixed point unit scales, see motorData::unitScale
+const int UNIT_FRAC_BITS = 24;
+
+//the joysticks are read at a fixed rate, once per step segment, see stepper.h
+const unsigned long JOG_SAMPLE_US = 5000;
+
+//arc segments turned by the small angle approximation before one is turned
+//exactly, see Atrox::moveArc()
+const int ARC_CORRECTION_SEGMENTS = 12;
+//farthest the end of an arc may be off its radius, in um, or 0.1% of it
+const float ARC_RADIUS_ERROR = 50.0;
+
+class Planner;
+class Stepper;
+
+//unit scales of the machine profile, worked out by the compiler
+/*  constexpr uint32_t axisStepPerRev(const int axis)
+    > gets the steps per output rev of an axis in the machine profile
+    args:
+      const int axis: the axis
+    returns the steps per output rev
+*/
+constexpr uint32_t axisStepPerRev(const int axis){
+  return (uint32_t)MACHINE_AXES[axis].stepPerRev * MACHINE_AXES[axis].microstepFactor
+         * MACHINE_AXES[axis].gboxReductionFactor;
+} //end axisStepPerRev(const int)
+
+/*  constexpr uint32_t axisUnitPerRev(const int axis)
+    > gets the thousandths of a unit, millidegree or um, per output rev
+      of an axis in the machine profile
+    args:
+      const int axis: the axis
+    returns the thousandths of a unit per output rev
+*/
+constexpr uint32_t axisUnitPerRev(const int axis){
+  return (uint32_t)(MACHINE_AXES[axis].gboxIncreaseFactor > 1 ? MACHINE_AXES[axis].gboxIncreaseFactor : 1)
+         * (MACHINE_AXES[axis].travelPerRev > 0 ? MACHINE_AXES[axis].travelPerRev : 360000UL);
+} //end axisUnitPerRev(const int)
+
+/*  constexpr uint32_t axisUnitScale(const int axis)
+    > gets the fixed point unit scale of an axis, see motorData::unitScale
+    args:
+      const int axis: the axis
+    returns steps per thousandth of a unit with UNIT_FRAC_BITS fraction bits
+*/
+constexpr uint32_t axisUnitScale(const int axis){
+  return ((uint64_t)axisStepPerRev(axis) << UNIT_FRAC_BITS) / axisUnitPerRev(axis);
+} //end axisUnitScale(const int)
+
+/*  constexpr long milliToStep(const long milli, const uint32_t unitScale)
+    > converts a position in thousandths of a unit to steps with a fixed
+      point unit scale, rounded to the nearest step
+    args:
+      const long milli: the position in millidegree, or um for a linear axis
+      const uint32_t unitScale: the scale, see motorData::unitScale
+    returns the position in step
+*/
+constexpr long milliToStep(const long milli, const uint32_t unitScale){
+  return (long)(((int64_t)milli * unitScale + ((int64_t)1 << (UNIT_FRAC_BITS - 1))) >> UNIT_FRAC_BITS);
+} //end milliToStep(const long, const uint32_t)
 
-//motor settings
-//in the future these will be stored in the EEPROM
-const int MOTOR_ENABLE_PIN = 8;
-
-const int X_AXIS_STEP_PIN = 0;
-const int X_AXIS_DIRN_PIN = 0;
-const int Y_AXIS_STEP_PIN = 0;
-const int Y_AXIS_DIRN_PIN = 0;
-const int Z_AXIS_STEP_PIN = 0;
-const int Z_AXIS_DIRN_PIN = 0;
-const int W_AXIS_STEP_PIN = 0;
-const int W_AXIS_DIRN_PIN = 0;
-const int P_AXIS_STEP_PIN = 3;
-const int P_AXIS_DIRN_PIN = 6;
-const int R_AXIS_STEP_PIN = 0;
-const int R_AXIS_DIRN_PIN = 0;
+/*  constexpr long stepToMilli(const long step, const uint32_t unitScale)
+    > converts a position in steps to thousandths of a unit with a fixed
+      point unit scale, rounded to the nearest thousandth
+      this divides in 64 bit, keep it out of what runs per segment
+    args:
+      const long step: the position in step
+      const uint32_t unitScale: the scale, see motorData::unitScale
+    returns the position in millidegree, or um for a linear axis
+*/
+constexpr long stepToMilli(const long step, const uint32_t unitScale){
+  return (long)(((int64_t)step * ((int64_t)1 << UNIT_FRAC_BITS) + (step < 0 ? -1 : 1) * (int64_t)(unitScale / 2))
+                / unitScale);
+} //end stepToMilli(const long, const uint32_t)
+
+/*  constexpr float axisStepPerUnit(const int axis)
+    > gets the steps per degree or mm of an axis, for speeds
+    args:
+      const int axis: the axis
+    returns the steps per unit
+*/
+constexpr float axisStepPerUnit(const int axis){
+  return 1000.0f * axisStepPerRev(axis) / axisUnitPerRev(axis);
+} //end axisStepPerUnit(const int)
 
 /*  struct motorData
-    > contains information about motor
-    > upon construction, step and direction pins are initialized
+    > contains the settings of a motor, copied from the machine profile
+      by the Atrox constructor and from the eeprom at boot, see settings.h
+    > steps are sent by the timer isr of the step generator, on the pins
+      of the machine profile, and the shared MOTOR_ENABLE_PIN is driven
+      by Atrox. what the isr touches on every step is kept by the step
+      generator, see stepAxis
+    > unitScale is worked out by the compiler from the gearing, moves in
+      units are converted with it without a float division
 */
 struct motorData{
-  AccelStepper motorhw;
-
   int stepPerRev{};
   int microstepFactor{};
   int gboxReductionFactor{};
   int gboxIncreaseFactor{};
+  long travelPerRev{};         //in um per output rev, 0 for a rotary axis
+
+  //steps per thousandth of a unit (millidegree or um) in fixed point with
+  //UNIT_FRAC_BITS fraction bits
+  uint32_t unitScale{};
+  float stepPerUnit{};         //for speeds, steps per degree or mm
 
   float maxSpeedStep{};
   float maxAccelStep{};
+  float maxJerkStep{};         //0 for trapezoid ramps
 
   float speedStep{};
   float AccelStep{};
-
-  motorData(const int stepPin, const int dirnPin){
-    motorhw = AccelStepper(AccelStepper::DRIVER, stepPin, dirnPin);
-  }
-};
-
-/*  struct staticsData
-    > contains statics data
-*/
-struct staticsData{
-  float A{}; //rotational x-axis
-  float B{}; //           y-axis
-  float C{}; //           z-axis
-  float X{}; //linear x-axis
-  float Y{}; //       y-axis
-  float Z{}; //       z-axis
-  float W{}; //yaw axis rotation
-  float P{}; //pitch axis rotation
-  float R{}; //roll axis rotation
 };
 
 /*  struct dynamicsData
@@ -85,54 +162,168 @@ struct dynamicsData{
   float linAccel{};
   float angSpeed{};
   float angAccel{};
+  float linJerk{};   //0 takes the jerk limit of the axes, if any
+  float angJerk{};
 };
 
 /*  class Atrox
     > system container
     public members:
+      OpMode opMode    stores the operation mode
+                       can be MD_COMMAND, MD_PROGRAM, MD_JOYSTICK, MD_BINARY or MD_STREAM
       PosMode posMode  stores the positioning mode
                        can be either ABSOLUTE_POS or RELATIVE_POS
       LinUnit linUnit  stores the linear unit
                        can be either MM or IN
-      AngUnit angUnit  stores the angular unit
+      AngUnit angUnit  stores the unit of moves
                        can be either STEP or DEGREE
-      motor xMotor,    stores information about the x axis motor
-            yMotor,    stores information about the y axis motor
-            zMotor,    stores information about the z axis motor
-            wMotor,    stores information about the yaw axis motor
-            pMotor,    stores information about the pitch axis motor
-            rMotor;    stores information about the roll axis motor
+                       in DEGREE, rotary axes move in degrees and
+                       linear axes in linUnit
+      motorData motor[AXIS_COUNT]  stores information about the motor of
+                                   each axis, indexed by Axis
+      long arcTolerance  stores how far arc segments may cut inside
+                         the arc, in um
+    > positions are kept in step, from the origin the system started at.
+      the machine position is counted by the step generator as it steps,
+      the planned position is where the moves queued end. in ABSOLUTE_POS
+      moves go to a work position, the machine position less the work
+      offset of the axis
     public methods:
       void releaseSteppers(): disables all steppers
       void engageSteppers(): enables all steppers
       void moveAxis(const Axis, const int step, const dynamicsData): moves the specified motor a specified amount of steps
       void moveAxis(const Axis, const float degree, const dynamicsData): moves the specified motor a specified amount of degrees
+      void moveAxes(const float[], const dynamicsData): moves all axes together by the amounts, or to the positions, given per axis
+      void moveAxes(const float[], const dynamicsData, const PosMode): as above, in the positioning mode given
+      void moveTool(const float[], const dynamicsData): moves the tool tip along a straight line to, or by, a tool pose, see kinematics.h
+      bool moveArc(const float[], const float[], const bool, const dynamicsData): moves x and y along an arc about a center, z along a helix
+      bool isArcing(): checks whether an arc still has segments to queue
+      long machinePosition(const Axis): gets the position of an axis as stepped so far, in step
+      float workPosition(const Axis): gets the work position of an axis as stepped so far, in the unit of moves
+      void setWorkPosition(const Axis, const float): sets the work position of an axis at the end of the moves queued
+      bool isLinear(const Axis): checks whether an axis is linear
+      void run(): feeds the moves queued in the planner to the step generator, all axes of a move start and end together. call this on every loop
+      bool isMoving(): checks whether any move is queued or running
+      void setupAxis(const Axis): derives the unit scales and planner limits of an axis from its motor settings
+      void loadProfile(): restores the motor settings of the machine profile and the default units
+      void feedHold(const bool): brakes to a stop along the planned ramp, keeping the moves. safe in an isr
+      void resume(): goes on after a feed hold. safe in an isr
+      void stop(): brakes to a stop along the planned ramp and drops the moves. safe in an isr
+      void emergencyStop(): stops stepping at once, drops the moves and releases the steppers. safe in an isr
+      void clearEmergencyStop(): accepts moves again after an emergency stop
+      bool isHeld(): checks whether a feed hold has come to a stop
+      bool isStopping(): checks whether a stop is braking, moves queued now would be dropped
+      bool isEstopped(): checks whether an emergency stop is latched
+      bool home(const uint8_t): starts homing the axes given that have a limit switch
+      bool isHoming(): checks whether homing is under way
+      int homingResult(): gets how homing ended, once
+      bool startJog(): jogs the axes with a joystick from their stick, until a stop
+      bool isJogging(): checks whether the axes are jogged
+      bool startStream(const SyncRole): steps the segments of a compiled stream as they come, alone or in a cell, see stream.h
+      void endStream(): goes back to the planner once a stream is at rest
+      bool isStreaming(): checks whether a stream is stepped
     usage:
-      Atrox(const int[6][6]): initializes a system giving in the motors' settings
+      Atrox(Planner*, Stepper*): initializes a system of the machine profile giving in
+                                 the planner that queues its moves
+                                 and the step generator that executes them
 */
 class Atrox{
 
   public:
+    OpMode opMode{MD_COMMAND};
     PosMode posMode{RELATIVE_POS};
     LinUnit linUnit{MM};
     AngUnit angUnit{STEP};
 
-    motorData xMotor = motorData(X_AXIS_STEP_PIN, X_AXIS_DIRN_PIN);
-    motorData yMotor = motorData(Y_AXIS_STEP_PIN, Y_AXIS_DIRN_PIN);
-    motorData zMotor = motorData(Z_AXIS_STEP_PIN, Z_AXIS_DIRN_PIN);
-    motorData wMotor = motorData(W_AXIS_STEP_PIN, W_AXIS_DIRN_PIN);
-    motorData pMotor = motorData(P_AXIS_STEP_PIN, P_AXIS_DIRN_PIN);
-    motorData rMotor = motorData(R_AXIS_STEP_PIN, R_AXIS_DIRN_PIN);
+    motorData motor[AXIS_COUNT];
+    long arcTolerance{MACHINE_ARC_TOLERANCE};
 
-    Atrox(const int motorSet[6][6]);
+    Atrox(Planner* plnPtr, Stepper* stpPtr);
 
     void releaseSteppers();
     void engageSteppers();
     void moveAxis(const Axis axis, const int val, const dynamicsData cmdDynamics);
     void moveAxis(const Axis axis, const float val, const dynamicsData cmdDynamics);
+    void moveAxes(const float val[], const dynamicsData cmdDynamics);
+    void moveAxes(const float val[], const dynamicsData cmdDynamics, const PosMode mode);
+    void moveTool(const float val[], const dynamicsData cmdDynamics);
+    bool moveArc(const float val[], const float center[], const bool isClockwise,
+                 const dynamicsData cmdDynamics);
+    bool isArcing();
+    long machinePosition(const Axis axis);
+    float workPosition(const Axis axis);
+    void setWorkPosition(const Axis axis, const float val);
+    bool isLinear(const Axis axis);
+    void run();
+    bool isMoving();
+    void setupAxis(const Axis axis);
+    void loadProfile();
+    void feedHold(const bool isLineWaiting);
+    void resume();
+    void stop();
+    void emergencyStop();
+    void clearEmergencyStop();
+    bool isHeld();
+    bool isStopping();
+    bool isEstopped();
+    bool home(const uint8_t axisBits);
+    bool isHoming();
+    int homingResult();
+    bool startJog();
+    bool isJogging();
+    bool startStream(const SyncRole role);
+    void endStream();
+    bool isStreaming();
   protected:
+    Planner* plannerPtr;
+    Stepper* stepperPtr;
+
+    volatile bool isStopRequested{false}; //drop the moves once held
+    volatile bool isEstop{false};         //latched until clearEmergencyStop()
+
+    HomingPhase homingPhase{HM_IDLE};
+    uint8_t homingBits{};   //axes being homed
+    int homingStatus{};     //see homingResult()
+
+    unsigned long jogSampleAt{}; //micros() the joysticks are read next at
+
+    //arc being cut into segments, in um in the machine frame
+    int arcSegmentsLeft{};
+    int arcSegmentIndex{};    //segments queued so far
+    float arcCenter[2];
+    float arcStartRadial[2];  //from the center to the start
+    float arcRadial[2];       //from the center to the end of the last segment
+    float arcCos{};           //turn per segment, small angle approximation
+    float arcSin{};
+    float arcSegmentAngle{};  //in rad, negative clockwise
+    float arcSegmentLength{};
+    float arcStartZ{};
+    float arcSegmentZ{};      //z per segment, along the helix
+    long arcTarget[3];
+    dynamicsData arcDynamics; //linear, in um
+
+    uint32_t unitRemainder[AXIS_COUNT]; //fraction of a step not moved yet, per axis
+    long plannedPosition[AXIS_COUNT]{}; //machine position at the end of the moves queued, in step
+    long workOffset[AXIS_COUNT]{};      //machine position of the work origin, in step
+
     void moveAxisStep(const Axis axis, const int step, const dynamicsData cmdDynamics);
+    void moveAxesStep(const long step[], const dynamicsData cmdDynamics);
+    void moveAxesStep(const long step[], const dynamicsData cmdDynamics, const bool isToolPath);
     void moveAxisDegree(const Axis axis, const float degree, const dynamicsData cmdDynamics);
+    void moveAxesUnit(const float val[], const dynamicsData cmdDynamics, const PosMode mode);
+    long unitToStep(const Axis axis, const float val);
+    long unitToStepPosition(const Axis axis, const float val);
+    float stepToUnit(const Axis axis, const long step);
+    void syncPlannedPosition();
+    void runHoming();
+    void queueHomingMove();
+    void endHoming(const int status);
+    void runJog();
+    void queueArcSegment();
+    float joystickSpeed(const int axis, const uint16_t reading);
+    template<int AXIS> void setupAxes();
+    template<int AXIS> float homingSeconds();
+    template<int AXIS> void homingSteps(long step[], const float seconds);
 };
 
 #endif //_ATROX_H
\ No newline at end of file
@@ -9,7 +9,7 @@
 // Written by Antares Husky (antares xavier kiriakov)                        //
 // Distributed under the GNU AGPLv3 license                                  //
 // xray77n@gmail.com                                                         //
-// 04 AUG 2019; Last revision: 05 AUG 2019                                   //
+// 04 AUG 2019; Last revision: 17 OCT 2026                                   //
 //***************************************************************************//
 
 
@@ -24,36 +24,46 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "atrox.h"
+#include "binproto.h"
 #include "command.h"
+#include "gcode.h"
+#include "planner.h"
+#include "program.h"
+#include "settings.h"
+#include "stats.h"
+#include "stepper.h"
+#include "stream.h"
+#include "uart.h"
 
-enum OpMode {MD_COMMAND, MD_PROGRAM, MD_JOYSTICK};
-OpMode opMode{MD_COMMAND};
-
-enum ReadState {RD_CMDADDR, RD_CMDVAL, INIT_CMD, RD_CMDARG, RD_END};
-
-/*motor settings in order: steps per rev,
-                           microstepping factor,
-                           gearbox reduction factor,
-                           gearbox increase factor,
-                           max motor speed in step per sec
-                           max motor acceleration in step per sec per sec
-*/
-const int motorSet[6][6] = {{  0, 1,  1, 1, 1000, 1000},   //x axis
-                            {  0, 1,  1, 1, 1000, 1000},   //y axis
-                            {  0, 1,  1, 1, 1000, 1000},   //z axis
-                            {200, 1,  1, 1, 1000, 1000},   //w axis
-                            {200, 1, 50, 1, 1000, 1000},   //p axis
-                            {200, 1,  1, 1, 1000, 1000}};  //r axis
-
-Atrox atrox(motorSet);
+Planner planner;
+Stepper stepper(&planner);
+Atrox atrox(&planner, &stepper);
 Command command(&atrox);
+GcodeReader gcodeReader(&command);
+BinaryReader binaryReader(&command);
+StreamReader streamReader(&stepper);
+bool isCommandPending{false}; //loaded command waiting for room in the planner
+
+//prototypes, for builds other than the arduino ide's
+bool executePendingCommand();
+int loadCommandFromSerial(GcodeReader* readerPtr);
+int loadCommandFromBinary(BinaryReader* readerPtr);
+int loadCommandFromProgram(GcodeReader* readerPtr);
+int playStreamFromBinary(BinaryReader* readerPtr, StreamReader* streamPtr);
+int recordFromSerial();
+void onRealtime(const uint8_t data);
 
 void setup() {
   // put your setup code here, to run once:
-  Serial.begin(9600);
-  Serial.println(F("hello world"));
+  uart.begin(9600);
+  uart.setRealtimeHandler(onRealtime);
+  uart.println(F("hello world"));
+
+  //tuned settings over the machine profile, once, straight into the motion tables
+  if(settingsLoad(&atrox) == -1) uart.println(F("no valid settings, machine profile"));
 
-  //TODO: homing
+  //homing is carried out by the main loop, its end is reported there
+  if(HOMING_AT_BOOT && !atrox.home(ALL_AXES)) uart.println(F("HOMING FAILED"));
 }
 
 
@@ -69,28 +79,231 @@ void setup() {
 
 void loop() {
   // put your main code here, to run repeatedly:
-  switch(opMode){
+  atrox.run();
+
+  switch(atrox.homingResult()){
+    case -1:
+      uart.println(F("HOMING FAILED"));
+      break;
+    case 8:
+      uart.println(F("HOMED"));
+      break;
+  }
+
+  switch(atrox.opMode){
     case MD_COMMAND:
-        switch(loadCommandFromSerial(&command)){
+        if(program.isRecording()){
+          switch(recordFromSerial()){
+            case -1:
+              uart.println("ERR"); //the job will not be saved
+              break;
+            case 1:
+              uart.println("OK");
+              break;
+            case 3:
+              uart.println(F("JOB NOT SAVED"));
+              uart.println("ERR");
+              break;
+            case 8:
+              uart.println(F("JOB SAVED"));
+              uart.println("OK");
+              break;
+          }
+          break;
+        }
+        if(!isCommandPending){
+          switch(loadCommandFromSerial(&gcodeReader)){
+            case -1:
+              uart.println("ERR");
+              break;
+            case 1:
+              if(atrox.isEstopped() && command.isMotion()){
+                uart.println("ERR"); //refused until M999
+              }else{
+                isCommandPending = true;
+              }
+              break;
+            case 2:
+              break;
+            case 112:
+              atrox.emergencyStop();
+              uart.println("OK");
+              break;
+          }
+        }
+        if(executePendingCommand()){
+          uart.println("OK");
+          if(atrox.opMode == MD_STREAM){
+            //M721, the frames carry a stream from here on
+            binaryReader.setStreamFrames(true);
+            streamReader.begin();
+          }
+        }
+      break;
+    case MD_BINARY:
+        if(!isCommandPending){
+          switch(loadCommandFromBinary(&binaryReader)){
+            case -1:
+              uart.write(BIN_NAK);
+              break;
+            case 1:
+              isCommandPending = true;
+              break;
+            case 3:
+              uart.setRawMode(false);
+              atrox.opMode = MD_COMMAND;
+              uart.write(BIN_ACK);
+              break;
+            case 8:
+              uart.write(BIN_ACK);
+              break;
+            case 9:
+              uart.write(BIN_CAN);
+              break;
+          }
+        }
+        executePendingCommand();
+      break;
+    case MD_STREAM:
+        //the empty frame ends the stream once the axes are at rest
+        if(streamReader.isEnding()){
+          if(atrox.isMoving()) break;
+          bool isPlayed = streamReader.isPlayed(); //before lockstep is let go
+          atrox.endStream();
+          binaryReader.setStreamFrames(false);
+          uart.setRawMode(false);
+          atrox.opMode = MD_COMMAND;
+          uart.write(isPlayed ? BIN_ACK : BIN_CAN);
+          break;
+        }
+        switch(playStreamFromBinary(&binaryReader, &streamReader)){
           case -1:
-            Serial.println("ERR");
-            break;
-          case 1:
-            command.execute();
-            Serial.println("OK");
+            uart.write(BIN_NAK);
             break;
-          case 2:
+          case 3:
+            streamReader.end();
             break;
-          case 112:
-            //TODO: e-stop handling
+          case 4:
+            uart.write(BIN_ACK); //played from memory, the next frame comes meanwhile
             break;
         }
       break;
+    case MD_JOYSTICK:
+        //a stop or an emergency stop ends the jog
+        if(!atrox.isJogging()){
+          atrox.opMode = MD_COMMAND;
+          uart.println(F("JOG END"));
+          break;
+        }
+        if(!isCommandPending){
+          switch(loadCommandFromSerial(&gcodeReader)){
+            case -1:
+              uart.println("ERR");
+              break;
+            case 1:
+              if(command.isMotion() || command.isSync()){
+                uart.println("ERR"); //the axes belong to the sticks
+              }else{
+                isCommandPending = true;
+              }
+              break;
+            case 2:
+              break;
+            case 112:
+              atrox.emergencyStop();
+              uart.println("OK");
+              break;
+          }
+        }
+        if(executePendingCommand()){
+          uart.println("OK");
+        }
+      break;
     case MD_PROGRAM:
+        //a stop ends the job, the lines the host sent meanwhile are read next
+        if(atrox.isStopping() || atrox.isEstopped()){
+          program.end();
+          isCommandPending = false;
+          atrox.opMode = MD_COMMAND;
+          uart.println(F("JOB STOPPED"));
+          break;
+        }
+        program.prefetch(); //while the planner is busy, not when the line is wanted
+        if(!isCommandPending){
+          switch(loadCommandFromProgram(&gcodeReader)){
+            case -1:
+              program.end();
+              atrox.opMode = MD_COMMAND;
+              uart.print(F("JOB ERR LINE "));
+              uart.println(program.lineNumber());
+              break;
+            case 1:
+              isCommandPending = true;
+              break;
+            case 3:
+              program.end();
+              atrox.opMode = MD_COMMAND;
+              uart.println(F("JOB DONE"));
+              break;
+            case 112:
+              atrox.emergencyStop(); //the job is stopped on the next pass
+              break;
+          }
+        }
+        executePendingCommand();
       break;
   }
 }
 
+
+/*  bool executePendingCommand()
+    > executes the loaded command
+      a motion command waits for room in the planner and for a stop or
+      homing to end, a settings command for the moves queued to end. a
+      move or G92 waits for an arc to be queued in full
+      the wait and the execution are timed into stats
+    no args
+    returns true if the command was executed
+*/
+bool executePendingCommand(){
+  if(!isCommandPending) return false;
+  if(command.isMotion() && (planner.isFull() || atrox.isStopping() || atrox.isHoming())) return false;
+  if(command.isSync() && atrox.isMoving()) return false;
+  if(command.isPlanned() && atrox.isArcing()) return false;
+  unsigned long startAt = micros();
+  command.execute();
+  stats.commandExecuted(startAt);
+  isCommandPending = false;
+  return true;
+} //end executePendingCommand()
+
+
+/*  void onRealtime(const uint8_t data)
+    > acts on a real-time byte as soon as it is received, ahead of the
+      lines queued, see uart.h
+      called in the receive interrupt, only flags are set here
+    args:
+      const uint8_t data: the real-time byte
+    returns nothing
+*/
+void onRealtime(const uint8_t data){
+  switch(data){
+    case RT_FEED_HOLD:
+      atrox.feedHold(uart.lineCount() > 0);
+      break;
+    case RT_RESUME:
+      atrox.resume();
+      break;
+    case RT_STOP:
+      atrox.stop();
+      break;
+    case RT_ESTOP:
+      atrox.emergencyStop();
+      break;
+  }
+  return;
+} //end onRealtime(const uint8_t)
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 //  L        OOOO     AA    DDDD
@@ -108,167 +321,135 @@ void loop() {
 ///////////////////////////////////////////////////////////////////////////////
 
 
-/*  int loadCommandFromSerial(Command* commandPtr)
+/*  int loadCommandFromSerial(GcodeReader* readerPtr)
     > loads command from serial
+      the serial port splits lines as they arrive, only a complete line is
+      fed to the g-code reader. this returns right away if there is none
+      the parse is timed into stats
     args:
-      Command* commandPtr: pointer to command object
+      GcodeReader* readerPtr: pointer to the reader loading the command
     returns int of load status
       status -1 indicates failure
       status 1 indicates load successful
       status 2 indicates no available serial command
       status 112 indicates a need to perform emergency stop
 */
-int loadCommandFromSerial(Command* commandPtr){
-  Command& commandCurrent = *commandPtr;
-  ReadState readState{RD_CMDADDR};
-  bool isAvailable{};
-  bool isValidCommand{false};
-  bool isEmergencyStop{false};
-  String incomingString{};
-  char incoming{};
-  char cmdAddr{};
-  String cmdValString{};
-  int cmdVal{};
-  int cmdStatus{};
+int loadCommandFromSerial(GcodeReader* readerPtr){
+  if(uart.lineCount() == 0) return 2;
+
+  unsigned long startAt = micros();
+  int loadStatus{2};
+  int incoming{};
+  do{
+    incoming = uart.read();
+    loadStatus = readerPtr->feed(incoming);
+  }while(incoming != '\n');
+  stats.lineParsed(startAt);
+  return loadStatus;
+} //end loadCommandFromSerial()
 
-  int loadStatus{-1};
 
-  //get one line at a time
-  if(Serial.available()){
-    incomingString = Serial.readStringUntil('\n') + '\n';
-  }else{
-    loadStatus = 2;
+/*  int loadCommandFromBinary(BinaryReader* readerPtr)
+    > loads command from a binary frame, see binproto.h
+      bytes are fed to the binary reader until a frame is checked, its
+      records are then loaded one per call
+    args:
+      BinaryReader* readerPtr: pointer to the reader loading the command
+    returns int of load status
+      status -1 indicates a corrupt frame
+      status 1 indicates load successful
+      status 2 indicates no available record
+      status 3 indicates binary mode was left
+      status 8 indicates every record of the frame was loaded
+      status 9 indicates every record of the frame was loaded, some were skipped
+*/
+int loadCommandFromBinary(BinaryReader* readerPtr){
+  if(!readerPtr->isFrameReady()){
+    int frameStatus{2};
+    while(frameStatus == 2 && uart.available()){
+      frameStatus = readerPtr->feed(uart.read());
+    }
+    if(frameStatus != 4) return frameStatus;
   }
+  unsigned long startAt = micros();
+  int loadStatus = readerPtr->loadRecord();
+  stats.lineParsed(startAt);
+  return loadStatus;
+} //end loadCommandFromBinary()
 
-  // while(isAvailable){
-  if(incomingString.length() > 1){
-    for(int chridx{}; chridx < incomingString.length(); chridx++){
-      incoming = incomingString.charAt(chridx);
 
-      switch(readState){
-        case RD_CMDADDR:
-          //check for alphabet
-          //alphabet is start of new command address
-          if(isupper(toupper(incoming))){
-            cmdAddr = incoming;
-            readState = RD_CMDVAL;
-          }
-          break;
-        case RD_CMDVAL:
-          if(isdigit(incoming)){
-            cmdValString += incoming;
-          }
-          if(isspace(incoming) || isupper(toupper(incoming))){
-            chridx--;
-            cmdVal = cmdValString.toInt();
-            readState = INIT_CMD;
-          }
-          break; //end RD_CMDVAL
-        case INIT_CMD:
-          chridx--; //re-read the previous character
-          cmdStatus = commandCurrent.commandInit(cmdAddr, cmdVal);
-          switch(cmdStatus){
-            case -1:
-              readState = RD_END;
-              break;
-            case 2:  //need PRY
-              isValidCommand = true;
-              readState = RD_CMDARG;
-              break;
-            case 8:  //complete
-              chridx = incomingString.length()-2;
-              isValidCommand = true;
-              readState = RD_END;
-              break;
-            case 112:  //emergency stop
-              chridx = incomingString.length()-2;
-              isValidCommand = true;
-              isEmergencyStop = true;
-              readState = RD_END;
-              break;
-          }
-          break; //end INIT_CMD
-        case RD_CMDARG:
-          if(!isspace(incoming)) chridx--;
-          { // process RD_CMDARG
-            String cmdArgString{};
-            int argStatus{6};
-            float cmdArg[10] = {0};
-            
-            for(; chridx < incomingString.length(); chridx++){
-              incoming = incomingString.charAt(chridx);
-              switch(cmdStatus){
-                case 2:
-                  //figure out which move argument it is
-                  if(isupper(toupper(incoming))){
-                    switch(toupper(incoming)){
-                      case 'X': //x direction/axis
-                        argStatus = 0;
-                        break;
-                      case 'Y': //y direction/axis
-                        argStatus = 1;
-                        break;
-                      case 'Z': //z direction/axis
-                        argStatus = 2;
-                        break;
-                      case 'W': //yaw axis
-                        argStatus = 3;
-                        break;
-                      case 'P': //pitch axis
-                        argStatus = 4;
-                        break;
-                      case 'R': //roll axis
-                        argStatus = 5;
-                        break;
-                      case 'F': //linear speed
-                        argStatus = 6;
-                        break;
-                      case 'A': //linear accl
-                        argStatus = 7;
-                        break;
-                      case 'E': //angular speed
-                        argStatus = 8;
-                        break;
-                      case 'B': //angular accl
-                        argStatus = 9;
-                        break;
-                    } //end switch
-                  }
+/*  int playStreamFromBinary(BinaryReader* readerPtr, StreamReader* streamPtr)
+    > plays a step stream from binary frames, see stream.h
+      bytes are fed to the binary reader until a frame is checked, its
+      records are then played over as many calls as the step generator
+      takes to make room for them. no frame is read meanwhile, the next
+      one waits in the receive buffer
+    args:
+      BinaryReader* readerPtr: pointer to the reader of the frames
+      StreamReader* streamPtr: pointer to the player of the stream
+    returns int of play status
+      status -1 indicates a corrupt frame
+      status 2 indicates records or bytes are awaited
+      status 3 indicates the empty frame, the end of the stream
+      status 4 indicates a checked frame, to be played from the next call
+*/
+int playStreamFromBinary(BinaryReader* readerPtr, StreamReader* streamPtr){
+  if(readerPtr->isFrameReady()){
+    if(streamPtr->play(readerPtr->payload(), readerPtr->payloadLength()) == 8) readerPtr->endFrame();
+    return 2;
+  }
+  int frameStatus{2};
+  while(frameStatus == 2 && uart.available()){
+    frameStatus = readerPtr->feed(uart.read());
+  }
+  return frameStatus;
+} //end playStreamFromBinary()
 
-                  //accept negative and decimal points (floating pts)
-                  if(isdigit(incoming) || incoming == '.' || incoming == '-'){
-                    cmdArgString += incoming;
-                  }
 
-                  //insert arg to arg array
-                  if((isspace(incoming) || isupper(toupper(incoming))) && cmdArgString.length() > 0){
-                    cmdArg[argStatus] = cmdArgString.toFloat();
-                    cmdArgString = "";
-                    if(incoming == '\n'){ //EOL. push argument to command object
-                      commandCurrent.commandArgMove(cmdArg);
-                    }
-                  }
+/*  int loadCommandFromProgram(GcodeReader* readerPtr)
+    > loads command from the job being run, see program.h
+      the job is read ahead in blocks, a line is fed to the g-code reader
+      from memory without waiting on the host
+    args:
+      GcodeReader* readerPtr: pointer to the reader loading the command
+    returns int of load status
+      status -1 indicates failure
+      status 1 indicates load successful
+      status 3 indicates the end of the job
+      status 112 indicates a need to perform emergency stop
+*/
+int loadCommandFromProgram(GcodeReader* readerPtr){
+  int incoming = program.read();
+  if(incoming == -1) return 3;
 
-                  break; //end cmdStatus 2
-              } //end process RD_CMDARG
-            } //end readarg
-            chridx -= 2;
-            readState = RD_END;
-          }
-          break; //end RD_CMDARG
-        case RD_END: //end reading from serial
-          if(isValidCommand){
-            if(isEmergencyStop){
-              loadStatus = 112; //emergency stop
-            }else{
-              loadStatus = 1; //success
-            }
-          }else{
-            loadStatus = -1; //error 
-          }
-          break; //end RD_END
-      }//end readstate switch
-    } //end readcmd for-loop
-  } //end if(incomingString.length() > 1)
+  unsigned long startAt = micros();
+  int loadStatus{2};
+  while(incoming != -1){
+    loadStatus = readerPtr->feed(incoming);
+    if(incoming == '\n') break;
+    incoming = program.read();
+  }
+  if(incoming == -1) loadStatus = readerPtr->feed('\n'); //job cut short of its last newline
+  stats.lineParsed(startAt);
   return loadStatus;
-} //end loadCommandFromSerial()
+} //end loadCommandFromProgram()
+
+
+/*  int recordFromSerial()
+    > records a line from serial into the job, see Program::record(const char)
+      only a complete line is read, this returns right away if there is none
+    no args
+    returns int of record status, see Program::record(const char)
+      status 2 indicates no available serial line
+*/
+int recordFromSerial(){
+  if(uart.lineCount() == 0) return 2;
+
+  int recordStatus{2};
+  int incoming{};
+  do{
+    incoming = uart.read();
+    recordStatus = program.record(incoming);
+  }while(incoming != '\n');
+  return recordStatus;
+} //end recordFromSerial()
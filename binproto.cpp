@@ -0,0 +1,220 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// binproto.cpp                                                              //
+//                                                                           //
+// Description:                                                              //
+//      This is the implementation file for the framed binary command        //
+//      protocol.                                                            //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <Arduino.h>
+
+#include "binproto.h"
+#include "crc.h"
+
+
+/*  BinaryReader constructor BinaryReader(Command*)
+    > constructs a reader waiting for a frame
+    args:
+      Command* ptr: address of the command to load
+*/
+BinaryReader::BinaryReader(Command* ptr){
+  commandPtr = ptr;
+} //end BinaryReader::BinaryReader(Command*)
+
+
+/*  int BinaryReader::feed(const uint8_t incoming)
+    > reads one byte of a frame
+      bytes before a sync byte are skipped
+    args:
+      const uint8_t incoming: the byte read
+    returns int of frame status
+      status -1 indicates a corrupt frame, to be answered with BIN_NAK
+      status 2 indicates the frame is not complete yet
+      status 3 indicates an empty frame, leaving binary mode
+      status 4 indicates a checked frame, its records are ready to load
+*/
+int BinaryReader::feed(const uint8_t incoming){
+  switch(binState){
+    case BN_SYNC:
+      if(incoming == BIN_SYNC) binState = BN_LENGTH;
+      break;
+    case BN_LENGTH:
+      if(incoming > BINARY_FRAME_SIZE){
+        binState = BN_SYNC;
+        return -1;
+      }
+      length = incoming;
+      index = 0;
+      crc = crc16Update(CRC16_INIT, incoming);
+      binState = length > 0 ? BN_PAYLOAD : BN_CRCLO;
+      break;
+    case BN_PAYLOAD:
+      frame[index++] = incoming;
+      crc = crc16Update(crc, incoming);
+      if(index == length) binState = BN_CRCLO;
+      break;
+    case BN_CRCLO:
+      crc ^= incoming;
+      binState = BN_CRCHI;
+      break;
+    case BN_CRCHI:
+      crc ^= (uint16_t)incoming << 8;
+      binState = BN_SYNC;
+      if(crc != 0 || (!isStreamOn && !isFrameValid())) return -1;
+      if(length == 0) return 3;
+      index = 0;
+      isReady = true;
+      isSkipped = false;
+      return 4;
+  }
+  return 2;
+} //end BinaryReader::feed(const uint8_t)
+
+
+/*  bool BinaryReader::isFrameReady()
+    > checks whether a checked frame still has records to load
+    no args
+    returns true if records are left
+*/
+bool BinaryReader::isFrameReady(){
+  return isReady;
+} //end BinaryReader::isFrameReady()
+
+
+/*  int BinaryReader::loadRecord()
+    > loads the next record of the checked frame into the command
+      unknown commands and commands given args they do not take are skipped
+    no args
+    returns int of load status
+      status 1 indicates load successful
+      status 8 indicates every record was loaded, to be answered with BIN_ACK
+      status 9 indicates every record was loaded but some were skipped,
+               to be answered with BIN_CAN
+*/
+int BinaryReader::loadRecord(){
+  while(index < length){
+    uint8_t start = index;
+    index += recordLength(start);
+
+    int cmdStatus = commandPtr->commandInit(frame[start], readWord(start + 1));
+    uint16_t mask = readWord(start + 3);
+    if(cmdStatus == -1 || (mask & ~commandPtr->argBits()) != 0){
+      isSkipped = true;
+      continue;
+    }
+
+    if(mask != 0){
+      float arg[BINARY_ARG_COUNT];
+      uint8_t argStart = start + BINARY_RECORD_HEAD;
+      for(int argIndex{}; argIndex < BINARY_ARG_COUNT; argIndex++){
+        if(mask & (1 << argIndex)){
+          memcpy(&arg[argIndex], &frame[argStart], sizeof(float));
+          argStart += sizeof(float);
+        }else{
+          arg[argIndex] = NAN; //left as the command starts with
+        }
+      }
+      commandPtr->commandArgMove(arg);
+    }
+    return 1;
+  }
+
+  isReady = false;
+  return isSkipped ? 9 : 8;
+} //end BinaryReader::loadRecord()
+
+
+/*  void BinaryReader::setStreamFrames(const bool isOn)
+    > takes frames of a step stream, see stream.h, or of records. the
+      payload of a stream frame is only checked by its crc
+    args:
+      const bool isOn: true for stream frames
+    returns nothing
+*/
+void BinaryReader::setStreamFrames(const bool isOn){
+  isStreamOn = isOn;
+  isReady = false;
+  binState = BN_SYNC;
+  return;
+} //end BinaryReader::setStreamFrames(const bool)
+
+
+/*  const uint8_t* BinaryReader::payload()
+    > gets the payload of the checked frame, as long as isFrameReady()
+    no args
+    returns the address of the payload
+*/
+const uint8_t* BinaryReader::payload(){
+  return frame;
+} //end BinaryReader::payload()
+
+
+/*  uint8_t BinaryReader::payloadLength()
+    > gets the bytes of payload of the checked frame
+    no args
+    returns the length
+*/
+uint8_t BinaryReader::payloadLength(){
+  return length;
+} //end BinaryReader::payloadLength()
+
+
+/*  void BinaryReader::endFrame()
+    > lets go of the checked frame once its payload was read, the next
+      frame can be fed
+    no args
+    returns nothing
+*/
+void BinaryReader::endFrame(){
+  isReady = false;
+  return;
+} //end BinaryReader::endFrame()
+
+
+/*  protected bool BinaryReader::isFrameValid()
+    > checks that the records of the frame add up to its length
+    no args
+    returns true if the frame is valid
+*/
+bool BinaryReader::isFrameValid(){
+  int start{};
+  while(start < length){
+    if(length - start < BINARY_RECORD_HEAD) return false;
+    start += recordLength(start);
+  }
+  return start == length;
+} //end BinaryReader::isFrameValid()
+
+
+/*  protected int BinaryReader::recordLength(const uint8_t start)
+    > gets the length of a record from its argument mask
+    args:
+      const uint8_t start: index of the record in the frame
+    returns the length in bytes
+*/
+int BinaryReader::recordLength(const uint8_t start){
+  uint16_t mask = readWord(start + 3);
+  int argCount{};
+  for(int argIndex{}; argIndex < BINARY_ARG_COUNT; argIndex++){
+    if(mask & (1 << argIndex)) argCount++;
+  }
+  return BINARY_RECORD_HEAD + argCount * sizeof(float);
+} //end BinaryReader::recordLength(const uint8_t)
+
+
+/*  protected uint16_t BinaryReader::readWord(const uint8_t start)
+    > reads a little endian word of the frame
+    args:
+      const uint8_t start: index of the word in the frame
+    returns the word
+*/
+uint16_t BinaryReader::readWord(const uint8_t start){
+  return frame[start] | ((uint16_t)frame[start + 1] << 8);
+} //end BinaryReader::readWord(const uint8_t)
@@ -0,0 +1,102 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// binproto.h                                                                //
+//                                                                           //
+// Description:                                                              //
+//      This is the header file for the framed binary command protocol.      //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _BINPROTO_H
+#define _BINPROTO_H
+
+#include <stdint.h>
+
+#include "command.h"
+
+/*  binary mode, entered with M720 and left with an empty frame
+
+    frame:  SYNC | length | payload[length] | crc low | crc high
+            crc is CRC-16/CCITT-FALSE over length and payload
+            a frame of length 0 leaves binary mode
+
+    record: letter | value low | value high | mask low | mask high | args
+            letter and value are the command address, eg 'G' 291
+            bit i of mask set means arg i follows, as a little endian
+            float, in the order of COMMAND_ARG_LETTERS, see command.h:
+            X Y Z W P R linSpeed linAccel angSpeed angAccel linJerk angJerk
+            I J S
+            args left out keep the value the command starts with, an
+            axis left out is not moved. a record with an arg its command
+            does not take is skipped
+
+    every frame is answered by one byte, once all its records are queued:
+            BIN_ACK  all records accepted
+            BIN_CAN  frame valid, but unknown records were skipped
+            BIN_NAK  frame corrupt, nothing executed, send it again
+
+    stream mode, entered with M721, takes frames of a step stream instead
+    of records, see stream.h
+*/
+const uint8_t BIN_SYNC = 0xA5;
+const uint8_t BIN_ACK = 0x06;
+const uint8_t BIN_NAK = 0x15;
+const uint8_t BIN_CAN = 0x18;
+
+//largest payload of a frame, in bytes
+const int BINARY_FRAME_SIZE = 96;
+const int BINARY_RECORD_HEAD = 5;
+const int BINARY_ARG_COUNT = COMMAND_ARG_COUNT;
+
+enum BinState {BN_SYNC, BN_LENGTH, BN_PAYLOAD, BN_CRCLO, BN_CRCHI};
+
+/*  class BinaryReader
+    > reads binary frames one byte at a time and loads their records into
+      a command, one record per call once the frame is checked
+    > with stream frames on, the payload is not checked as records, it is
+      read as it is and the frame let go with endFrame()
+    public methods:
+      int feed(const uint8_t): reads one byte of a frame
+      bool isFrameReady(): checks whether a checked frame still has records to load
+      int loadRecord(): loads the next record of the checked frame into the command
+      void setStreamFrames(const bool): takes frames of a step stream instead of records, see stream.h
+      const uint8_t* payload(): gets the payload of the checked frame
+      uint8_t payloadLength(): gets the bytes of payload of the checked frame
+      void endFrame(): lets go of the checked frame, the next one can be read
+    usage:
+      BinaryReader(Command*): initializes a reader loading into a command
+*/
+class BinaryReader{
+  Command* commandPtr;
+
+  uint8_t frame[BINARY_FRAME_SIZE];
+  BinState binState{BN_SYNC};
+  uint8_t length{};
+  uint8_t index{};
+  uint16_t crc{};
+
+  bool isReady{false};
+  bool isSkipped{false};  //a record of the frame was unknown
+  bool isStreamOn{false}; //frames of a step stream
+
+  public:
+    BinaryReader(Command* ptr);
+    int feed(const uint8_t incoming);
+    bool isFrameReady();
+    int loadRecord();
+    void setStreamFrames(const bool isOn);
+    const uint8_t* payload();
+    uint8_t payloadLength();
+    void endFrame();
+  protected:
+    bool isFrameValid();
+    int recordLength(const uint8_t start);
+    uint16_t readWord(const uint8_t start);
+};
+
+#endif //_BINPROTO_H
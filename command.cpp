@@ -8,13 +8,18 @@
 // Written by Antares Husky (antares xavier kiriakov)                        //
 // Distributed under the GNU AGPLv3 license                                  //
 // xray77n@gmail.com                                                         //
-// 04 AUG 2019; Last revision: 05 AUG 2019                                   //
+// 04 AUG 2019; Last revision: 17 OCT 2026                                   //
 //***************************************************************************//
 
 
-#include <HardwareSerial.h>
+#include <Arduino.h>
 
 #include "command.h"
+#include "kinematics.h"
+#include "program.h"
+#include "settings.h"
+#include "stats.h"
+#include "uart.h"
 
 
 /*  Command::Command(Atrox* ptr)
@@ -41,184 +46,236 @@ Command::Command(Atrox* ptr, char addr, int val){
 } //end Command::Command(Atrox*, char, int)
 
 
+//the commands, in the order of command.h
+//   letter, value, arguments, flags, method
+constexpr commandEntry Command::COMMAND_TABLE[] PROGMEM = {
+  {'G', 2, ARG_XYZ | ARG_DYNAMICS | ARG_CENTER, CF_MOTION | CF_PLANNED | CF_NEEDS_XY, &Command::moveArc},
+  {'G', 3, ARG_XYZ | ARG_DYNAMICS | ARG_CENTER, CF_MOTION | CF_PLANNED | CF_NEEDS_XY, &Command::moveArc},
+  {'G', 20, 0, 0, &Command::setInch},
+  {'G', 21, 0, 0, &Command::setMillimetre},
+  {'G', 28, ARG_AXES, CF_SYNC, &Command::home},
+  {'G', 90, 0, 0, &Command::setAbsolute},
+  {'G', 91, 0, 0, &Command::setRelative},
+  {'G', 92, ARG_AXES, CF_PLANNED, &Command::setWorkPosition},
+  {'G', 200, ARG_AXES | ARG_DYNAMICS, CF_MOTION | CF_PLANNED, &Command::rotateAxes},
+  {'G', 201, ARG_AXES | ARG_DYNAMICS, CF_MOTION | CF_PLANNED | CF_NEEDS_TOOL, &Command::moveTool},
+  {'G', 220, 0, 0, &Command::setStepUnit},
+  {'G', 221, 0, 0, &Command::setDegreeUnit},
+  {'G', 291, ARG_ROTARY | ARG_DYNAMICS, CF_MOTION | CF_PLANNED, &Command::jogAxes},
+  {'M', 0, 0, 0, &Command::stop},
+  {'M', 1, 0, 0, &Command::stop},
+  {'M', 17, 0, 0, &Command::engageSteppers},
+  {'M', 18, 0, 0, &Command::releaseSteppers},
+  {'M', 24, 0, CF_SYNC_HOST, &Command::runJob},
+  {'M', 28, 0, CF_COMMAND_MODE, &Command::beginRecord},
+  {'M', 29, 0, 0, nullptr}, //ends the recording before it gets here
+  {'M', 76, 0, 0, &Command::pause},
+  {'M', 108, 0, 0, &Command::resume},
+  {'M', 112, 0, CF_ESTOP, &Command::emergencyStop},
+  {'M', 114, 0, 0, &Command::reportPosition},
+  {'M', 500, 0, CF_SYNC, &Command::saveSettings},
+  {'M', 501, 0, CF_SYNC, &Command::loadSettings},
+  {'M', 502, 0, CF_SYNC, &Command::resetSettings},
+  {'M', 503, 0, CF_SYNC, &Command::reportSettings},
+  {'M', 561, ARG_AXES, CF_SYNC, &Command::writeSetting},
+  {'M', 562, ARG_AXES, CF_SYNC, &Command::writeSetting},
+  {'M', 563, ARG_AXES, CF_SYNC, &Command::writeSetting},
+  {'M', 564, ARG_AXES, CF_SYNC, &Command::writeSetting},
+  {'M', 565, ARG_AXES, CF_SYNC, &Command::writeSetting},
+  {'M', 566, ARG_AXES, CF_SYNC, &Command::writeSetting},
+  {'M', 567, ARG_AXES, CF_SYNC, &Command::writeSetting},
+  {'M', 568, ARG_AXES, CF_SYNC, &Command::writeSetting},
+  {'M', 570, ARG_PARAM, 0, &Command::setArcTolerance},
+  {'M', 720, 0, CF_COMMAND_MODE, &Command::startBinary},
+  {'M', 721, ARG_PARAM, CF_SYNC | CF_COMMAND_MODE, &Command::startStream},
+  {'M', 730, 0, CF_SYNC | CF_COMMAND_MODE, &Command::startJog},
+  {'M', 740, 0, 0, &Command::reportStats},
+  {'M', 741, 0, 0, &Command::clearStats},
+  {'M', 999, 0, 0, &Command::clearEmergencyStop},
+};
+
+constexpr int Command::COMMAND_COUNT = sizeof(COMMAND_TABLE) / sizeof(COMMAND_TABLE[0]);
+
+static_assert(SETTING_FIRST_MCODE == 561 && SETTING_COUNT == 8, "a settings command lacks its entry");
+
+
+/*  constexpr uint8_t Command::findEntry(const int slot, const int index)
+    > finds the command hashed into a slot, from an entry of the table on
+    args:
+      const int slot: the slot, see commandHash()
+      const int index: the entry to look from
+    returns the index of the entry plus 1, 0 if none
+*/
+constexpr uint8_t Command::findEntry(const int slot, const int index){
+  return index == COMMAND_COUNT ? 0
+         : (commandHash(COMMAND_TABLE[index].addr, COMMAND_TABLE[index].val) == slot
+            ? index + 1 : findEntry(slot, index + 1));
+} //end Command::findEntry(const int, const int)
+
+
+/*  constexpr bool Command::isHashUnique(const int index)
+    > checks whether the commands from an entry of the table on are each
+      hashed into a slot no later entry is
+    args:
+      const int index: the entry to check from
+    returns true if no two share a slot
+*/
+constexpr bool Command::isHashUnique(const int index){
+  return index == COMMAND_COUNT
+         || (findEntry(commandHash(COMMAND_TABLE[index].addr, COMMAND_TABLE[index].val), index + 1) == 0
+             && isHashUnique(index + 1));
+} //end Command::isHashUnique(const int)
+
+static_assert(Command::isHashUnique(0), "two commands share a slot, change COMMAND_HASH_MUL or COMMAND_HASH_M");
+
+//entry of each slot plus 1, 0 for none, built from the table when compiled
+template<int... SLOT> struct commandSlots{
+  static const uint8_t entry[sizeof...(SLOT)];
+};
+template<int... SLOT> const uint8_t commandSlots<SLOT...>::entry[sizeof...(SLOT)] PROGMEM = {
+  Command::findEntry(SLOT, 0)...
+};
+template<int COUNT, int... SLOT> struct commandSlotList : commandSlotList<COUNT - 1, COUNT - 1, SLOT...>{};
+template<int... SLOT> struct commandSlotList<0, SLOT...>{
+  typedef commandSlots<SLOT...> slots;
+};
+typedef commandSlotList<COMMAND_HASH_SIZE>::slots COMMAND_SLOTS;
+
+
 /*  int Command::commandInit(char addr, int val)
     > prepare command for arguments
+      the command is looked up in its slot of the table, its arguments
+      start as the table declares them
     args:
       char addr: letter address of command
       int val: address value of command
     returns:
       int of command status
         status -1 indicates failure
-        status 2 indicates a need for WPR values
+        status 2 indicates a need for arguments
         status 8 indicates a complete command
+        status 112 indicates a need to perform emergency stop
 */
 int Command::commandInit(char addr, int val){
-  int status{-1};
   cmdAddr = toupper(addr);
   cmdVal = val;
-  switch(cmdAddr){
-    case 'G': 
-      switch(cmdVal){
-        case 90:
-          //G90 - ABSOLUTE POSITIONING
-          status = 8; //complete
-          break;
-        case 91:
-          //G91 - RELATIVE POSITIONING
-          status = 8; //complete
-          break;
-        case 200:
-          //G200 - ROTATE AXIS
-          //       DEFAULT CLOCKWISE
-          initStaticsData();
-          initDynamicsData();
-          status = 2; //need WPR
-          break;
-        case 220:
-          //G220 - ANGULAR UNIT: STEP
-          status = 8;
-          break;
-        case 221:
-          //G220 - ANGULAR UNIT: DEGREE
-          status = 8;
-          break;
-        case 291:
-          //G291 - JOG ROTATIONAL AXIS, ALWAYS RELATIVE
-          //       DEFAULT CLOCKWISE
-          initStaticsData();
-          initDynamicsData();
-          status = 2; //need PRY
-          break;
-      } //end switch(cmdVal) for G
-      break; //end G
-    case 'M':
-      switch(cmdVal){
-        case 0:
-          //M0 - STOP
-          status = 8; //complete
-          break;
-        case 1:
-          //M1 - MANUAL STOP
-          status = 8; //complete
-          break;
-        case 17:
-          //M17 - ENABLE STEPPERS
-          status = 8; //complete
-          break;
-        case 18:
-          //M18 - DISABLE STEPPERS
-          status = 8; //complete
-          break;
-        case 76:
-          //M76 - PAUSE
-          status = 8; //complete
-          break;
-      } //end switch(cmdVal) for M
-    default:
-      status = -1;
-      break;
-  } //end switch(cmdAddr)
-  return status;
+  cmdArgBits = 0;
+  cmdFlags = 0;
+  cmdHandler = nullptr;
+  if(val < 0) return -1;
+  uint8_t entry = pgm_read_byte(&COMMAND_SLOTS::entry[commandHash(cmdAddr, val)]);
+  if(entry == 0) return -1;
+  commandEntry command;
+  memcpy_P(&command, &COMMAND_TABLE[entry - 1], sizeof(command));
+  if(command.addr != cmdAddr || command.val != val) return -1;
+
+  if((command.flags & CF_NEEDS_XY) && !(isAxisUsed(X_AXIS) && isAxisUsed(Y_AXIS))) return -1;
+  if((command.flags & CF_NEEDS_TOOL) && !isKinematic()) return -1;
+  if((command.flags & CF_COMMAND_MODE) && atroxPtr->opMode != MD_COMMAND) return -1;
+  cmdArgBits = command.argBits;
+  cmdFlags = command.flags;
+  cmdHandler = command.handler;
+  initArgs();
+
+  if(cmdFlags & CF_ESTOP) return 112; //act on it at once
+  return cmdArgBits != 0 ? 2 : 8;
 } //end Command::commandInit(char, int)
 
 
 /*  void Command::commandArgMove(float arg[])
-    > loads move command arguments
+    > loads the arguments of a command, in the order of COMMAND_ARG_LETTERS
+      arguments given as NAN are left as commandInit() set them
     args:
-      float arg[]: list of arguments
+      float arg[]: list of COMMAND_ARG_COUNT arguments
     returns nothing
 */
 void Command::commandArgMove(float arg[]){
-  cmdStatics.X = arg[0];
-  cmdStatics.Y = arg[1];
-  cmdStatics.Z = arg[2];
-  cmdStatics.W = arg[3];
-  cmdStatics.P = arg[4];
-  cmdStatics.R = arg[5];
-  cmdDynamics.linSpeed = arg[6];
-  cmdDynamics.linAccel = arg[7];
-  cmdDynamics.angSpeed = arg[8];
-  cmdDynamics.angAccel = arg[9];
-
+  for(int index{}; index < COMMAND_ARG_COUNT; index++){
+    if(!isnan(arg[index])) cmdArgs[index] = arg[index];
+  }
   return;
 } //end Command::commandArgMove(float[])
 
 
+/*  int Command::commandArg(char letter, float val)
+    > loads a single argument of a command
+    args:
+      char letter: letter address of the argument
+      float val: value of the argument
+    returns:
+      int of argument status
+        status -1 indicates an argument the command does not take
+        status 2 indicates the argument was loaded
+*/
+int Command::commandArg(char letter, float val){
+  const char* argLetter = strchr(COMMAND_ARG_LETTERS, toupper(letter));
+  if(letter == '\0' || argLetter == nullptr) return -1;
+  int index = argLetter - COMMAND_ARG_LETTERS;
+  if(!(cmdArgBits & (1 << index))) return -1;
+  if(isSetting()){
+    //settings take axis letters only, checked as they are read
+    if(!isAxisUsed(index) || !isSettingValid(cmdVal - SETTING_FIRST_MCODE, val)) return -1;
+  }
+  cmdArgs[index] = val;
+  return 2;
+} //end Command::commandArg(char, float)
+
+
+/*  uint16_t Command::argBits()
+    > gets the arguments the loaded command takes
+    no args
+    returns bits of COMMAND_ARG_LETTERS, 0 for none
+*/
+uint16_t Command::argBits(){
+  return cmdArgBits;
+} //end Command::argBits()
+
+
+/*  bool Command::isMotion()
+    > checks whether the loaded command moves an axis
+      motion commands must wait for room in the planner
+    no args
+    returns true if the command is a motion command
+*/
+bool Command::isMotion(){
+  return cmdFlags & CF_MOTION;
+} //end Command::isMotion()
+
+
+/*  bool Command::isSync()
+    > checks whether the loaded command must wait for the moves queued
+      to end before it runs. settings change how moves are planned,
+      writing the eeprom blocks the main loop, homing, jogging and
+      streaming start at rest and so does a job started from the host, a
+      stop still braking would end it
+    no args
+    returns true if the command waits
+*/
+bool Command::isSync(){
+  return (cmdFlags & CF_SYNC) || ((cmdFlags & CF_SYNC_HOST) && atroxPtr->opMode != MD_PROGRAM);
+} //end Command::isSync()
+
+
+/*  bool Command::isPlanned()
+    > checks whether the loaded command takes the end of the moves queued,
+      the moves and G92. it must wait while an arc is queued segment by
+      segment, the end is not known until the last one
+    no args
+    returns true if the command waits for an arc
+*/
+bool Command::isPlanned(){
+  return cmdFlags & CF_PLANNED;
+} //end Command::isPlanned()
+
+
 /*  void Command::execute()
     > executes loaded command with stored arguments
+      motion commands are only queued, this returns right away
     no args
     returns nothing
 */
 void Command::execute(){
-  Serial.print(cmdAddr);
-  Serial.print(cmdVal);
-  Serial.print(' ');
-  Serial.print('W');
-  Serial.print(cmdStatics.W);
-  Serial.print('|');
-  Serial.print('P');
-  Serial.print(cmdStatics.P);
-  Serial.print('|');
-  Serial.print('R');
-  Serial.print(cmdStatics.R);
-  Serial.print(' ');
-  Serial.println(cmdDynamics.angSpeed);
-
-  switch(cmdAddr){
-    case 'G': 
-      switch(cmdVal){
-        case 90:
-          //G90 - ABSOLUTE POSITIONING
-          atroxPtr->posMode = ABSOLUTE_POS;
-          break;
-        case 91:
-          //G91 - RELATIVE POSITIONING
-          atroxPtr->posMode = RELATIVE_POS;
-          break;
-        case 200:
-          //G200 - ROTATE AXIS
-          //       DEFAULT CLOCKWISE
-          break;
-        case 220:
-          //G220 - ANGULAR UNIT: STEP
-          atroxPtr->angUnit = STEP;
-          break;
-        case 221:
-          //G220 - ANGULAR UNIT: DEGREE
-          atroxPtr->angUnit = DEGREE;
-          break;
-        case 291:
-          //G291 - JOG ROTATIONAL AXIS, ALWAYS RELATIVE
-          //       DEFAULT CLOCKWISE
-          atroxPtr->moveAxis(P_AXIS, cmdStatics.P, cmdDynamics);
-          break;
-      } //end switch(cmdVal) for G
-      break;
-    case 'M':
-      switch(cmdVal){
-        case 0:
-          //M0 - STOP
-          //TODO
-          break;
-        case 1:
-          //M1 - MANUAL STOP
-          //TODO
-          break;
-        case 17:
-          //M17 - ENABLE STEPPERS
-          atroxPtr->engageSteppers();
-          break;
-        case 18:
-          //M18 - DISABLE STEPPERS
-          atroxPtr->releaseSteppers();
-          break;
-        case 76:
-          //M76 - PAUSE
-          //TODO
-          break;
-      } //end switch(cmdVal) for M
-      break;
-  } //end switch(cmdAddr)
+  if(cmdHandler != nullptr) (this->*cmdHandler)();
   return;
 } //end Command::execute()
 
@@ -236,31 +293,499 @@ void Command::execute(char addr, int val){
 } //end Command::execute(char, int)
 
 
-/*  void Command::initStaticsData()
-    > initialises the command's statics data
+/*  void Command::initArgs()
+    > initialises the command's arguments
+      axes are NAN until given, an axis not given is not moved
+      the speeds, accelerations and jerks are 0, the machine's own
+      the arc center is at the start until given, S is NAN until given
+    no args
+    returns nothing
+*/
+void Command::initArgs(){
+  for(int index{}; index < COMMAND_ARG_COUNT; index++){
+    cmdArgs[index] = (index < AXIS_COUNT || index == ARG_INDEX_S) ? NAN : 0;
+  }
+  return;
+} //end initArgs()
+
+
+/*  dynamicsData Command::argDynamics()
+    > gets the speeds, accelerations and jerks given to the command
+    no args
+    returns the dynamics, 0 where not given
+*/
+dynamicsData Command::argDynamics(){
+  dynamicsData cmdDynamics;
+  cmdDynamics.linSpeed = cmdArgs[ARG_INDEX_F];       //F, linear speed
+  cmdDynamics.linAccel = cmdArgs[ARG_INDEX_F + 1];   //A, linear accl
+  cmdDynamics.angSpeed = cmdArgs[ARG_INDEX_F + 2];   //E, angular speed
+  cmdDynamics.angAccel = cmdArgs[ARG_INDEX_F + 3];   //B, angular accl
+  cmdDynamics.linJerk = cmdArgs[ARG_INDEX_F + 4];    //U, linear jerk
+  cmdDynamics.angJerk = cmdArgs[ARG_INDEX_F + 5];    //V, angular jerk
+  return cmdDynamics;
+} //end argDynamics()
+
+
+/*  bool Command::isSetting()
+    > checks whether the loaded command sets a motor setting, M561-M568
+    no args
+    returns true if the command is a settings command
+*/
+bool Command::isSetting(){
+  return cmdAddr == 'M' && cmdVal >= SETTING_FIRST_MCODE
+         && cmdVal < SETTING_FIRST_MCODE + SETTING_COUNT;
+} //end isSetting()
+
+
+/*  protected void Command::moveArc()
+    > G2 - ARC CLOCKWISE, G3 - ARC COUNTERCLOCKWISE
+      cut into segments as the planner takes them
+    no args
+    returns nothing
+*/
+void Command::moveArc(){
+  //W, P and R are not taken, left NAN
+  if(!atroxPtr->moveArc(cmdArgs, &cmdArgs[ARG_INDEX_I], cmdVal == 2, argDynamics())){
+    uart.println(F("ARC REFUSED"));
+  }
+  return;
+} //end Command::moveArc()
+
+
+/*  protected void Command::setInch()
+    > G20 - LINEAR UNIT: INCH
+    no args
+    returns nothing
+*/
+void Command::setInch(){
+  atroxPtr->linUnit = IN;
+  return;
+} //end Command::setInch()
+
+
+/*  protected void Command::setMillimetre()
+    > G21 - LINEAR UNIT: MM
+    no args
+    returns nothing
+*/
+void Command::setMillimetre(){
+  atroxPtr->linUnit = MM;
+  return;
+} //end Command::setMillimetre()
+
+
+/*  protected void Command::home()
+    > G28 - HOME
+      the axes given, all axes with a switch if none is given
+      the end is reported by the main loop
+    no args
+    returns nothing
+*/
+void Command::home(){
+  uint8_t axisBits{};
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(!isnan(cmdArgs[axis])) axisBits |= 1 << axis;
+  }
+  if(!atroxPtr->home(axisBits == 0 ? ALL_AXES : axisBits)) uart.println(F("HOMING FAILED"));
+  return;
+} //end Command::home()
+
+
+/*  protected void Command::setAbsolute()
+    > G90 - ABSOLUTE POSITIONING
+    no args
+    returns nothing
+*/
+void Command::setAbsolute(){
+  atroxPtr->posMode = ABSOLUTE_POS;
+  return;
+} //end Command::setAbsolute()
+
+
+/*  protected void Command::setRelative()
+    > G91 - RELATIVE POSITIONING
+    no args
+    returns nothing
+*/
+void Command::setRelative(){
+  atroxPtr->posMode = RELATIVE_POS;
+  return;
+} //end Command::setRelative()
+
+
+/*  protected void Command::setWorkPosition()
+    > G92 - SET WORK POSITION
+      the end of the moves queued is taken as the position given, all
+      axes at 0 if none is given
+    no args
+    returns nothing
+*/
+void Command::setWorkPosition(){
+  bool isAnyGiven{false};
+  for(int axis{}; axis < AXIS_COUNT; axis++) isAnyGiven |= !isnan(cmdArgs[axis]);
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(!isAxisUsed(axis)) continue;
+    if(!isAnyGiven) cmdArgs[axis] = 0;
+    if(!isnan(cmdArgs[axis])) atroxPtr->setWorkPosition((Axis)axis, cmdArgs[axis]);
+  }
+  return;
+} //end Command::setWorkPosition()
+
+
+/*  protected void Command::rotateAxes()
+    > G200 - ROTATE AXIS
+      DEFAULT CLOCKWISE
+      all six axes start and finish together
+    no args
+    returns nothing
+*/
+void Command::rotateAxes(){
+  atroxPtr->moveAxes(cmdArgs, argDynamics());
+  return;
+} //end Command::rotateAxes()
+
+
+/*  protected void Command::moveTool()
+    > G201 - MOVE TOOL
+      the tip goes straight while the head turns
+    no args
+    returns nothing
+*/
+void Command::moveTool(){
+  atroxPtr->moveTool(cmdArgs, argDynamics());
+  return;
+} //end Command::moveTool()
+
+
+/*  protected void Command::setStepUnit()
+    > G220 - ANGULAR UNIT: STEP
+    no args
+    returns nothing
+*/
+void Command::setStepUnit(){
+  atroxPtr->angUnit = STEP;
+  return;
+} //end Command::setStepUnit()
+
+
+/*  protected void Command::setDegreeUnit()
+    > G221 - ANGULAR UNIT: DEGREE
+    no args
+    returns nothing
+*/
+void Command::setDegreeUnit(){
+  atroxPtr->angUnit = DEGREE;
+  return;
+} //end Command::setDegreeUnit()
+
+
+/*  protected void Command::jogAxes()
+    > G291 - JOG ROTATIONAL AXIS, ALWAYS RELATIVE
+      DEFAULT CLOCKWISE
+      axes are queued together as one planned move
+    no args
+    returns nothing
+*/
+void Command::jogAxes(){
+  //X, Y and Z are not taken, left NAN
+  atroxPtr->moveAxes(cmdArgs, argDynamics(), RELATIVE_POS);
+  return;
+} //end Command::jogAxes()
+
+
+/*  protected void Command::stop()
+    > M0 - STOP, M1 - MANUAL STOP
+      brakes along the planned ramp, then drops the moves queued
+      no optional stop switch, M1 is the same
+    no args
+    returns nothing
+*/
+void Command::stop(){
+  atroxPtr->stop();
+  return;
+} //end Command::stop()
+
+
+/*  protected void Command::engageSteppers()
+    > M17 - ENABLE STEPPERS
+    no args
+    returns nothing
+*/
+void Command::engageSteppers(){
+  atroxPtr->engageSteppers();
+  return;
+} //end Command::engageSteppers()
+
+
+/*  protected void Command::releaseSteppers()
+    > M18 - DISABLE STEPPERS
+    no args
+    returns nothing
+*/
+void Command::releaseSteppers(){
+  atroxPtr->releaseSteppers();
+  return;
+} //end Command::releaseSteppers()
+
+
+/*  protected void Command::runJob()
+    > M24 - RUN STORED JOB
+      the job is read in place of the serial port until it ends, from
+      within a job it starts over, so a job ending in M24 loops
+    no args
+    returns nothing
+*/
+void Command::runJob(){
+  if(program.start()){
+    atroxPtr->opMode = MD_PROGRAM;
+  }else{
+    uart.println(F("NO JOB"));
+  }
+  return;
+} //end Command::runJob()
+
+
+/*  protected void Command::beginRecord()
+    > M28 - START RECORDING JOB
+      the lines sent until M29 are stored, see program.h
+    no args
+    returns nothing
+*/
+void Command::beginRecord(){
+  program.beginRecord();
+  return;
+} //end Command::beginRecord()
+
+
+/*  protected void Command::pause()
+    > M76 - PAUSE
+      brakes along the planned ramp, M108 goes on
+    no args
+    returns nothing
+*/
+void Command::pause(){
+  atroxPtr->feedHold(false); //the moves before it are planned already
+  return;
+} //end Command::pause()
+
+
+/*  protected void Command::resume()
+    > M108 - RESUME
+    no args
+    returns nothing
+*/
+void Command::resume(){
+  atroxPtr->resume();
+  return;
+} //end Command::resume()
+
+
+/*  protected void Command::emergencyStop()
+    > M112 - EMERGENCY STOP
+    no args
+    returns nothing
+*/
+void Command::emergencyStop(){
+  atroxPtr->emergencyStop();
+  return;
+} //end Command::emergencyStop()
+
+
+/*  protected void Command::reportPosition()
+    > M114 - REPORT POSITION
+      prints the position of the axes of the machine profile as stepped
+      so far, the work position in the unit of moves and the machine
+      position in step, and HOLD while a feed hold keeps the moves left
+      at rest, eg
+        WPOS W12.50 P0.00
+        MPOS W1000 P0
+        HOLD
+    no args
+    returns nothing
+*/
+void Command::reportPosition(){
+  uart.print(F("WPOS"));
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(!isAxisUsed(axis)) continue;
+    uart.print(' ');
+    uart.print(AXIS_LETTER[axis]);
+    if(atroxPtr->angUnit == STEP){
+      uart.print((long)atroxPtr->workPosition((Axis)axis));
+    }else{
+      uart.print(atroxPtr->workPosition((Axis)axis));
+    }
+  }
+  uart.println();
+  uart.print(F("MPOS"));
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(!isAxisUsed(axis)) continue;
+    uart.print(' ');
+    uart.print(AXIS_LETTER[axis]);
+    uart.print(atroxPtr->machinePosition((Axis)axis));
+  }
+  uart.println();
+  if(atroxPtr->isHeld()) uart.println(F("HOLD"));
+  return;
+} //end reportPosition()
+
+
+/*  protected void Command::saveSettings()
+    > M500 - SAVE SETTINGS TO EEPROM
+    no args
+    returns nothing
+*/
+void Command::saveSettings(){
+  settingsSave(atroxPtr);
+  return;
+} //end Command::saveSettings()
+
+
+/*  protected void Command::loadSettings()
+    > M501 - LOAD SETTINGS FROM EEPROM
+    no args
+    returns nothing
+*/
+void Command::loadSettings(){
+  if(settingsLoad(atroxPtr) == -1) uart.println(F("NO SETTINGS SAVED"));
+  return;
+} //end Command::loadSettings()
+
+
+/*  protected void Command::resetSettings()
+    > M502 - RESTORE MACHINE PROFILE SETTINGS
+    no args
+    returns nothing
+*/
+void Command::resetSettings(){
+  settingsReset(atroxPtr);
+  return;
+} //end Command::resetSettings()
+
+
+/*  protected void Command::reportSettings()
+    > M503 - REPORT SETTINGS
+    no args
+    returns nothing
+*/
+void Command::reportSettings(){
+  settingsReport(atroxPtr);
+  return;
+} //end Command::reportSettings()
+
+
+/*  protected void Command::writeSetting()
+    > M561-M568 - SET A MOTOR SETTING PER AXIS
+      axes not given are left as they are
+    no args
+    returns nothing
+*/
+void Command::writeSetting(){
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(isnan(cmdArgs[axis])) continue;
+    if(!settingsWrite(atroxPtr, cmdVal - SETTING_FIRST_MCODE, (Axis)axis, cmdArgs[axis])){
+      uart.print(F("REFUSED "));
+      uart.println(AXIS_LETTER[axis]);
+    }
+  }
+  return;
+} //end Command::writeSetting()
+
+
+/*  protected void Command::setArcTolerance()
+    > M570 - SET ARC CHORD TOLERANCE
+      the arc being queued keeps its own
+    no args
+    returns nothing
+*/
+void Command::setArcTolerance(){
+  const float tolerance = cmdArgs[ARG_INDEX_S];
+  if(tolerance >= 1 && tolerance <= 1000){
+    atroxPtr->arcTolerance = lround(tolerance);
+  }else{
+    uart.println(F("REFUSED"));
+  }
+  return;
+} //end Command::setArcTolerance()
+
+
+/*  protected void Command::startBinary()
+    > M720 - BINARY COMMAND MODE
+      the serial port takes frames until an empty frame is sent
+    no args
+    returns nothing
+*/
+void Command::startBinary(){
+  atroxPtr->opMode = MD_BINARY;
+  uart.setRawMode(true);
+  return;
+} //end Command::startBinary()
+
+
+/*  protected void Command::startStream()
+    > M721 - STEP STREAM MODE
+      the serial port takes frames of a compiled stream, played straight
+      into the step generator until an empty frame
+      S1 leads a cell on the sync line, S2 follows its lead, alone if none
+    no args
+    returns nothing
+*/
+void Command::startStream(){
+  const float role = isnan(cmdArgs[ARG_INDEX_S]) ? (float)SY_NONE : cmdArgs[ARG_INDEX_S];
+  if(role >= SY_NONE && role <= SY_FOLLOW && atroxPtr->startStream((SyncRole)lround(role))){
+    atroxPtr->opMode = MD_STREAM;
+    uart.setRawMode(true);
+  }else{
+    uart.println(F("REFUSED"));
+  }
+  return;
+} //end Command::startStream()
+
+
+/*  protected void Command::startJog()
+    > M730 - JOYSTICK JOG MODE
+      the axes follow their stick until M0 or a stop byte
+    no args
+    returns nothing
+*/
+void Command::startJog(){
+  if(atroxPtr->startJog()){
+    atroxPtr->opMode = MD_JOYSTICK;
+  }else{
+    uart.println(F("NO JOYSTICK"));
+  }
+  return;
+} //end Command::startJog()
+
+
+/*  protected void Command::reportStats()
+    > M740 - REPORT STATISTICS
+      while moving, see stats.h
+    no args
+    returns nothing
+*/
+void Command::reportStats(){
+  stats.report();
+  return;
+} //end Command::reportStats()
+
+
+/*  protected void Command::clearStats()
+    > M741 - CLEAR STATISTICS
     no args
     returns nothing
 */
-void Command::initStaticsData(){
-  cmdStatics.X = 0;
-  cmdStatics.Y = 0;
-  cmdStatics.Z = 0;
-  cmdStatics.W = 0;
-  cmdStatics.P = 0;
-  cmdStatics.R = 0;
+void Command::clearStats(){
+  stats.clear();
   return;
-} //end initStaticsData()
+} //end Command::clearStats()
 
 
-/*  void Command::initDynamicsData()
-    > initialises the command's dynamics data
+/*  protected void Command::clearEmergencyStop()
+    > M999 - CLEAR EMERGENCY STOP
     no args
     returns nothing
 */
-void Command::initDynamicsData(){
-  cmdDynamics.linSpeed = 0;
-  cmdDynamics.linAccel = 0;
-  cmdDynamics.angSpeed = 0;
-  cmdDynamics.angAccel = 0;
+void Command::clearEmergencyStop(){
+  atroxPtr->clearEmergencyStop();
   return;
-} //end initDynamicsData()
\ No newline at end of file
+} //end Command::clearEmergencyStop()
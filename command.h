@@ -8,7 +8,7 @@
 // Written by Antares Husky (antares xavier kiriakov)                        //
 // Distributed under the GNU AGPLv3 license                                  //
 // xray77n@gmail.com                                                         //
-// 04 AUG 2019; Last revision: 05 AUG 2019                                   //
+// 04 AUG 2019; Last revision: 17 OCT 2026                                   //
 //***************************************************************************//
 
 
@@ -17,20 +17,98 @@
 
 #include "atrox.h"
 
+/*  command table
+    > every command is one entry of Command::COMMAND_TABLE, in flash: its
+      letter and value, the arguments it takes and how it is queued, and
+      the method running it. a command is found by hashing its letter and
+      value into COMMAND_HASH_SIZE slots, a slot holds one entry at most,
+      checked when compiled
+    > the arguments are bits of COMMAND_ARG_LETTERS, in the order of the
+      binary records' mask, see binproto.h. a command taking axes starts
+      with them not given, one taking F-V with them at 0, the machine's
+      own, and one taking S with S not given
+*/
+const char COMMAND_ARG_LETTERS[] = "XYZWPRFAEBUVIJS";
+const int COMMAND_ARG_COUNT = 15;
+const uint16_t ARG_XYZ = 0x0007;       //X Y Z
+const uint16_t ARG_ROTARY = 0x0038;    //W P R
+const uint16_t ARG_AXES = 0x003F;      //X Y Z W P R
+const uint16_t ARG_DYNAMICS = 0x0FC0;  //F A E B U V
+const uint16_t ARG_CENTER = 0x3000;    //I J
+const uint16_t ARG_PARAM = 0x4000;     //S
+//arguments by their index, an axis by its Axis
+const int ARG_INDEX_F = 6;             //F A E B U V follow in the order of dynamicsData
+const int ARG_INDEX_I = 12;
+const int ARG_INDEX_J = 13;
+const int ARG_INDEX_S = 14;
+
+const uint8_t CF_MOTION = 0x01;        //moves an axis, waits for room in the planner
+const uint8_t CF_PLANNED = 0x02;       //takes the end of the moves queued, waits for an arc
+const uint8_t CF_SYNC = 0x04;          //waits for the moves queued to end
+const uint8_t CF_SYNC_HOST = 0x08;     //waits for them as sent by the host, not from a job
+const uint8_t CF_COMMAND_MODE = 0x10;  //only from command mode
+const uint8_t CF_ESTOP = 0x20;         //acted on at once, status 112
+const uint8_t CF_NEEDS_XY = 0x40;      //only on a machine with x and y
+const uint8_t CF_NEEDS_TOOL = 0x80;    //only on a machine with the carriage and the head
+
+//slots of the hash, a power of 2, its multiplier and the offset of the M
+//codes from the G codes. a multiply and shifts, no division on the avr
+const int COMMAND_HASH_SIZE = 128;
+const uint16_t COMMAND_HASH_MUL = 11;
+const int COMMAND_HASH_M = 56;
+
+class Command;
+typedef void (Command::*commandHandler)();
+
+/*  struct commandEntry
+    > contains a command of the table
+*/
+struct commandEntry{
+  char addr;
+  int16_t val;
+  uint16_t argBits;        //arguments taken, bits of COMMAND_ARG_LETTERS
+  uint8_t flags;           //CF_ bits
+  commandHandler handler;  //nullptr if there is nothing to run
+};
+
+/*  constexpr int commandHash(const char addr, const int val)
+    > gets the slot of a command
+    args:
+      const char addr: letter address of command
+      const int val: address value of command, not negative
+    returns the slot, below COMMAND_HASH_SIZE
+*/
+constexpr int commandHash(const char addr, const int val){
+  return (((uint16_t)((uint16_t)val * COMMAND_HASH_MUL) >> 3) + (addr == 'M' ? COMMAND_HASH_M : 0))
+         & (COMMAND_HASH_SIZE - 1);
+} //end commandHash(const char, const int)
+
 /*  class Command
     > command container
     members:
       Atrox* atroxPtr  stores the address to the atrox system
       char cmdAddr     stores the command's letter address
       int cmdVal       stores the command's address value
-      staticsData cmdStatics    stores the command's static data
-                                includes X, Y, Z, W, P, R positions
-      dynamicsData cmdDynamics  stores the command's dynamic data
-                                includes linear and angular positions
-                                and accelerations
+      uint16_t cmdArgBits       stores the arguments the command takes
+      uint8_t cmdFlags          stores the command's CF_ bits
+      commandHandler cmdHandler stores the method running the command,
+                                nullptr if not initialized
+      float cmdArgs[]           stores the command's arguments, indexed
+                                by their bit of COMMAND_ARG_LETTERS: the
+                                X-R axes by Axis, handed to the motion
+                                methods as they are, the speeds,
+                                accelerations and jerks, the I, J arc
+                                center and the S value
     public methods:
-      int commandInit(char, int): initializes a command
-      void commandArgMove(float[]): fill movement information about a move command
+      int commandInit(char, int): initializes a command, looked up in the command table
+      void commandArgMove(float[]): fill the arguments of a command, COMMAND_ARG_COUNT of them
+      int commandArg(char, float): fill a single argument of a command
+      uint16_t argBits(): gets the arguments the stored command takes
+      static constexpr uint8_t findEntry(int, int): finds the entry hashed into a slot, when compiled
+      static constexpr bool isHashUnique(int): checks that no two entries share a slot, when compiled
+      bool isMotion(): checks whether the stored command moves an axis
+      bool isSync(): checks whether the stored command waits for the moves queued to end
+      bool isPlanned(): checks whether the stored command takes the end of the moves queued
       void execute(): executes the stored command. must be initialized with commandInit(char, int) or the Command(Atrox*, char, int) constructor before calling. if not initialized, it will do nothing. calling this repeatedly will invoke the last stored command.
       void execute(char, int): execute the command given in the argument
     usage:
@@ -40,38 +118,128 @@
                                   valid command address and value
 
       available commands;
+        G2 - ARC CLOCKWISE, X Y ABOUT THE I J CENTER, Z HELIX, PER G90/G91, SEE Atrox::moveArc()
+        G3 - ARC COUNTERCLOCKWISE, AS G2
+        G20 - LINEAR UNIT: INCH
+        G21 - LINEAR UNIT: MM
+        G28 - HOME THE AXES GIVEN, ALL AXES WITH A SWITCH IF NONE
         G90 - ABSOLUTE POSITIONING
         G91 - RELATIVE POSITIONING
-        G200 - ROTATE AXIS //NOT YET
+        G92 - SET WORK POSITION OF THE AXES GIVEN, ALL AT 0 IF NONE
+        G200 - ROTATE AXIS, ALL AXES ARRIVE TOGETHER, BY OR TO THE AMOUNT PER G90/G91
+        G201 - MOVE TOOL, TIP IN A STRAIGHT LINE, BY OR TO THE POSE PER G90/G91, SEE kinematics.h
         G220 - ANGULAR UNIT: STEP
-        G220 - ANGULAR UNIT: DEGREE
+        G221 - ANGULAR UNIT: DEGREE, LINEAR AXES IN G20/G21 UNIT
         G291 - JOG ROTATIONAL AXIS, ALWAYS RELATIVE
-        M0 - STOP //NOT YET
-        M1 - MANUAL STOP //NOT YET
+        M0 - STOP, BRAKES AND DROPS THE MOVES QUEUED
+        M1 - MANUAL STOP, SAME AS M0
         M17 - ENABLE STEPPERS
         M18 - DISABLE STEPPERS
-        M76 - PAUSE //NOT YET
-        M112 - EMERGENCY STOP //NOT YET
+        M24 - RUN STORED JOB, SEE program.h
+        M28 - START RECORDING JOB, THE LINES UNTIL M29 ARE STORED
+        M29 - END RECORDING, SAVES THE JOB
+        M76 - PAUSE, BRAKES AND KEEPS THE MOVES QUEUED
+        M108 - RESUME AFTER M76
+        M112 - EMERGENCY STOP, MOVES REFUSED UNTIL M999
+        M114 - REPORT WORK AND MACHINE POSITION, WHILE MOVING
+        M500 - SAVE SETTINGS TO EEPROM
+        M501 - LOAD SETTINGS FROM EEPROM
+        M502 - RESTORE MACHINE PROFILE SETTINGS, EEPROM UNCHANGED
+        M503 - REPORT SETTINGS, AS G-CODE
+        M561 - SET STEPS PER REV, PER AXIS LETTER
+        M562 - SET MICROSTEPPING FACTOR, PER AXIS LETTER
+        M563 - SET GEARBOX REDUCTION FACTOR, PER AXIS LETTER
+        M564 - SET GEARBOX INCREASE FACTOR, PER AXIS LETTER
+        M565 - SET MAX SPEED IN STEP/S, PER AXIS LETTER
+        M566 - SET MAX ACCELERATION IN STEP/S/S, PER AXIS LETTER
+        M567 - SET TRAVEL PER REV IN UM, 0 FOR ROTARY, PER AXIS LETTER
+        M568 - SET MAX JERK IN STEP/S/S/S, 0 FOR TRAPEZOID RAMPS, PER AXIS LETTER
+        M570 - SET ARC CHORD TOLERANCE IN UM, S1 TO S1000
+        M720 - BINARY COMMAND MODE, SEE binproto.h
+        M721 - STEP STREAM MODE, A STREAM COMPILED BY host/compile.cpp IN BINARY FRAMES, SEE stream.h
+               S1 AS THE LEAD OF A CELL OF BOARDS, S2 AS A FOLLOWER, SEE host/cell.cpp
+        M730 - JOYSTICK JOG MODE, SEE axisJog IN machine.h, UNTIL M0
+        M740 - REPORT STATISTICS: TIMES, PLANNER, SERIAL, STEP ISR AND FREE RAM, SEE stats.h
+        M741 - CLEAR STATISTICS
+        M999 - CLEAR EMERGENCY STOP
+
+      a new command is one entry of COMMAND_TABLE in command.cpp, and its
+      method here
+
+      settings commands wait for the moves queued to end, see settings.h
+      moves and G92 wait for an arc to be queued in full
+      in joystick jog mode moves, homing, settings and jobs are refused
+      in step stream mode only frames are read, a feed hold stops the stream
+      M0, M76, M108 and M112 also have a single byte sent ahead of the
+      line queue, see uart.h
 */
 class Command{
   Atrox* atroxPtr;
 
   char cmdAddr{};
   int cmdVal{};
+  uint16_t cmdArgBits{};
+  uint8_t cmdFlags{};
+  commandHandler cmdHandler{nullptr};
 
-  staticsData cmdStatics;
-  dynamicsData cmdDynamics;
+  float cmdArgs[COMMAND_ARG_COUNT]{};
 
   public:
+    static const commandEntry COMMAND_TABLE[];
+    static const int COMMAND_COUNT;
+
     Command(Atrox* ptr);
     Command(Atrox* ptr, char addr, int val);
     int commandInit(char addr, int val);
     void commandArgMove(float arg[]);
+    int commandArg(char letter, float val);
+    uint16_t argBits();
+    bool isMotion();
+    bool isSync();
+    bool isPlanned();
     void execute();
     void execute(char addr, int val);
+    static constexpr uint8_t findEntry(const int slot, const int index);
+    static constexpr bool isHashUnique(const int index);
   protected:
-    void initStaticsData();
-    void initDynamicsData();
+    void initArgs();
+    dynamicsData argDynamics();
+    bool isSetting();
+
+    //the commands, see COMMAND_TABLE
+    void moveArc();
+    void setInch();
+    void setMillimetre();
+    void home();
+    void setAbsolute();
+    void setRelative();
+    void setWorkPosition();
+    void rotateAxes();
+    void moveTool();
+    void setStepUnit();
+    void setDegreeUnit();
+    void jogAxes();
+    void stop();
+    void engageSteppers();
+    void releaseSteppers();
+    void runJob();
+    void beginRecord();
+    void pause();
+    void resume();
+    void emergencyStop();
+    void reportPosition();
+    void saveSettings();
+    void loadSettings();
+    void resetSettings();
+    void reportSettings();
+    void writeSetting();
+    void setArcTolerance();
+    void startBinary();
+    void startStream();
+    void startJog();
+    void reportStats();
+    void clearStats();
+    void clearEmergencyStop();
 };
 
 #endif //_COMMAND_H
\ No newline at end of file
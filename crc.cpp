@@ -0,0 +1,52 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// crc.cpp                                                                   //
+//                                                                           //
+// Description:                                                              //
+//      This is the implementation file for the checksum functions.          //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include "crc.h"
+
+
+/*  uint16_t crc16Update(uint16_t crc, const uint8_t data)
+    > adds one byte to a CRC-16/CCITT-FALSE checksum
+      polynomial 0x1021, not reflected, start with CRC16_INIT
+    args:
+      uint16_t crc: checksum so far
+      const uint8_t data: the byte to add
+    returns the updated checksum
+*/
+uint16_t crc16Update(uint16_t crc, const uint8_t data){
+  crc ^= (uint16_t)data << 8;
+  for(int bit{}; bit < 8; bit++){
+    if(crc & 0x8000){
+      crc = (crc << 1) ^ 0x1021;
+    }else{
+      crc <<= 1;
+    }
+  }
+  return crc;
+} //end crc16Update(uint16_t, const uint8_t)
+
+
+/*  uint16_t crc16(const uint8_t* data, const size_t length)
+    > computes the CRC-16/CCITT-FALSE checksum of a block of bytes
+    args:
+      const uint8_t* data: the bytes
+      const size_t length: number of bytes
+    returns the checksum
+*/
+uint16_t crc16(const uint8_t* data, const size_t length){
+  uint16_t crc{CRC16_INIT};
+  for(size_t index{}; index < length; index++){
+    crc = crc16Update(crc, data[index]);
+  }
+  return crc;
+} //end crc16(const uint8_t*, const size_t)
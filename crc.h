@@ -0,0 +1,26 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// crc.h                                                                     //
+//                                                                           //
+// Description:                                                              //
+//      This is the header file for the checksum functions.                  //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _CRC_H
+#define _CRC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+const uint16_t CRC16_INIT = 0xFFFF;
+
+uint16_t crc16Update(uint16_t crc, const uint8_t data);
+uint16_t crc16(const uint8_t* data, const size_t length);
+
+#endif //_CRC_H
@@ -0,0 +1,175 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// gcode.cpp                                                                 //
+//                                                                           //
+// Description:                                                              //
+//      This is the implementation file for the streaming g-code tokenizer.  //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <Arduino.h>
+
+#include "gcode.h"
+
+
+//decimal point scales, indexed by digits after the point
+const float FRAC_SCALE[GCODE_MAX_DIGITS + 1] PROGMEM = {1.0, 0.1, 0.01, 0.001, 0.0001, 0.00001,
+                                                        0.000001, 0.0000001, 0.00000001, 0.000000001};
+
+
+/*  GcodeReader constructor GcodeReader(Command*)
+    > constructs a reader waiting for the start of a line
+    args:
+      Command* ptr: address of the command to load
+*/
+GcodeReader::GcodeReader(Command* ptr){
+  commandPtr = ptr;
+} //end GcodeReader::GcodeReader(Command*)
+
+
+/*  int GcodeReader::feed(const char incoming)
+    > reads one byte of g-code
+    args:
+      const char incoming: the byte read
+    returns int of load status
+      status -1 indicates an invalid line
+      status 1 indicates a command was loaded
+      status 2 indicates the line is not complete yet, or was empty
+      status 112 indicates a need to perform emergency stop
+*/
+int GcodeReader::feed(const char incoming){
+  if(incoming == '\n' || incoming == '\r'){
+    if(readState == RD_VALUE) endWord();
+    return endLine();
+  }
+
+  switch(readState){
+    case RD_COMMENT:
+      if(incoming == ')') readState = RD_LETTER;
+      break;
+    case RD_SKIP: //rest of the line is ignored
+      break;
+    case RD_VALUE:
+      if(isdigit(incoming)){
+        if(digits < GCODE_MAX_DIGITS){
+          mantissa = mantissa * 10 + (incoming - '0');
+          digits++;
+          if(fracDigits >= 0) fracDigits++;
+        }else if(fracDigits < 0){ //integer part too long
+          isError = true;
+          readState = RD_SKIP;
+        }
+        break;
+      }
+      if(incoming == '.' && fracDigits < 0){
+        fracDigits = 0;
+        break;
+      }
+      if((incoming == '-' || incoming == '+') && digits == 0 && fracDigits < 0){
+        isNegative = incoming == '-';
+        break;
+      }
+      endWord();
+      //the byte ending the value may start the next word
+      if(readState == RD_LETTER) beginWord(incoming);
+      break;
+    case RD_LETTER:
+      beginWord(incoming);
+      break;
+  }
+  return 2;
+} //end GcodeReader::feed(const char)
+
+
+/*  protected void GcodeReader::beginWord(const char incoming)
+    > starts a word on a letter, skips whitespace and comments
+      anything else makes the line invalid
+    args:
+      const char incoming: the byte read
+    returns nothing
+*/
+void GcodeReader::beginWord(const char incoming){
+  if(isspace(incoming)) return;
+  if(incoming == '('){
+    readState = RD_COMMENT;
+    return;
+  }
+  if(incoming == ';'){
+    readState = RD_SKIP;
+    return;
+  }
+  if(isalpha(incoming)){
+    letter = toupper(incoming);
+    mantissa = 0;
+    digits = 0;
+    fracDigits = -1;
+    isNegative = false;
+    readState = RD_VALUE;
+    return;
+  }
+  isError = true;
+  readState = RD_SKIP;
+  return;
+} //end GcodeReader::beginWord(const char)
+
+
+/*  protected void GcodeReader::endWord()
+    > passes the word read to the command
+      the first word of a line initializes the command, the others are its
+      arguments. words after a command that takes no argument are ignored
+    no args
+    returns nothing
+*/
+void GcodeReader::endWord(){
+  readState = RD_LETTER;
+  if(digits == 0){ //letter without value
+    isError = true;
+    readState = RD_SKIP;
+    return;
+  }
+
+  if(cmdStatus == 0){
+    cmdStatus = commandPtr->commandInit(letter, isNegative ? -mantissa : mantissa);
+    if(cmdStatus == -1 || fracDigits > 0){
+      isError = true;
+      readState = RD_SKIP;
+    }
+    return;
+  }
+
+  if(cmdStatus == 2){ //need arguments
+    float val = mantissa * pgm_read_float(&FRAC_SCALE[max(fracDigits, 0)]);
+    if(commandPtr->commandArg(letter, isNegative ? -val : val) == -1){
+      isError = true;
+      readState = RD_SKIP;
+    }
+  }
+  return;
+} //end GcodeReader::endWord()
+
+
+/*  protected int GcodeReader::endLine()
+    > ends the line and resets the reader for the next one
+    no args
+    returns int of load status, see GcodeReader::feed(const char)
+*/
+int GcodeReader::endLine(){
+  int loadStatus{2};
+  if(isError){
+    loadStatus = -1;
+  }else if(cmdStatus == 112){
+    loadStatus = 112;
+  }else if(cmdStatus != 0){
+    loadStatus = 1;
+  }
+
+  readState = RD_LETTER;
+  cmdStatus = 0;
+  isError = false;
+  return loadStatus;
+} //end GcodeReader::endLine()
@@ -0,0 +1,60 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// gcode.h                                                                   //
+//                                                                           //
+// Description:                                                              //
+//      This is the header file for the streaming g-code tokenizer.          //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _GCODE_H
+#define _GCODE_H
+
+#include "command.h"
+
+//most digits kept in a number, further digits after the point are dropped
+const int GCODE_MAX_DIGITS = 9;
+
+enum ReadState {RD_LETTER, RD_VALUE, RD_COMMENT, RD_SKIP};
+
+/*  class GcodeReader
+    > single pass g-code tokenizer fed one byte at a time
+    > words are (letter, value) pairs. the first word of a line initializes
+      the command, the following words are passed to it as arguments
+    > numbers are accumulated as an integer mantissa while reading, there is
+      no line buffer and no heap allocation
+    > comments in parentheses and after a semicolon are skipped
+    public methods:
+      int feed(const char): reads one byte
+    usage:
+      GcodeReader(Command*): initializes a reader loading into a command
+*/
+class GcodeReader{
+  Command* commandPtr;
+
+  ReadState readState{RD_LETTER};
+  int cmdStatus{};        //status of the line's command, 0 before the first word
+  bool isError{false};
+
+  //word being read
+  char letter{};
+  long mantissa{};
+  int digits{};
+  int fracDigits{-1};     //-1 until a decimal point is read
+  bool isNegative{false};
+
+  public:
+    GcodeReader(Command* ptr);
+    int feed(const char incoming);
+  protected:
+    void beginWord(const char incoming);
+    void endWord();
+    int endLine();
+};
+
+#endif //_GCODE_H
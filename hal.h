@@ -0,0 +1,267 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// hal.h                                                                     //
+//                                                                           //
+// Description:                                                              //
+//      This is the hardware abstraction layer. The step timer, the eeprom,  //
+//      the job storage, the analog inputs, the serial port, the sync line   //
+//      and the free memory are reached only through here, so the firmware   //
+//      can be built for the ATmega328P or for the host simulation in host/. //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _HAL_H
+#define _HAL_H
+
+#include <Arduino.h>
+
+#include "machine.h"
+
+//step timer clock select bits, stored in the step segments
+const uint8_t TIMER_CLK_DIV8 = (1 << CS11);
+const uint8_t TIMER_CLK_DIV64 = (1 << CS11) | (1 << CS10);
+const uint8_t TIMER_CLK_DIV256 = (1 << CS12);
+
+/*  step timer
+      void halTimerStart(): starts the step timer, the first interrupt follows right away
+      void halTimerSet(const uint8_t, const uint16_t): sets the clock select bits and ticks between interrupts
+      void halTimerStop(): stops the step timer, the clock runs on until the step pulses end
+      bool halTimerIsLate(): checks whether the next interrupt came due while the isr ran
+      bool halPulseStart(const uint8_t): runs the pulse interrupt a number of us from now,
+                                         false if it would not come before the next step event
+      void halPulseEnd(): called by the pulse interrupt, it runs once
+      void halDirnSetup(const uint8_t): waits a number of us for a direction pin to settle
+      void halStepEvent(const uint8_t, const uint8_t): called by the isr with the axes stepped and their directions
+      void halSegmentEvent(const uint8_t, const uint16_t, const uint16_t, const unsigned long*, const uint8_t):
+        called by the isr as it loads a segment: its clock select bits, ticks and step events, and the steps
+        per axis and directions of its block when a new block starts, nullptr when the block goes on.
+        a step event count of 0 means the isr ran dry and stopped the timer
+
+    eeprom
+      void halEepromRead(const uint16_t, void*, const size_t): reads bytes from an address
+      void halEepromWrite(const uint16_t, const void*, const size_t): writes bytes to an address,
+                                                                    leaving the bytes that do not change
+
+    job storage, where program mode keeps its job, see program.h
+      HAL_JOB_ADDRESS: eeprom address the storage starts at, the settings block fits below, see settings.h
+      HAL_JOB_SIZE: bytes the storage holds
+      void halJobRead(const uint16_t, void*, const size_t): reads bytes from an address
+      void halJobWrite(const uint16_t, const void*, const size_t): writes bytes to an address,
+                                                                 leaving the bytes that do not change
+      on the target this is the eeprom above the settings block, on the
+      host a file
+
+    analog inputs
+      uint16_t halAnalogRead(const uint8_t): reads an analog pin, 14-19 for A0-A5, 0-1023
+                                             it waits for the conversion, about 110us
+
+    serial port
+      void halUartBegin(const unsigned long): starts the port at a baud rate
+      uint8_t halUartRead(): gets the byte received, in the receive interrupt
+      void halUartWrite(const uint8_t): sends a byte, in the transmit interrupt
+      void halUartTxInterrupt(const bool): turns the transmit interrupt on or off
+      bool halUartCanPoll(): checks whether a byte must be sent by polling,
+                             ie interrupts are off and the port is ready
+
+    sync line, MACHINE_SYNC_PIN of a cell's boards wired together, see stream.h
+      void halSyncBegin(const bool): drives the line as the lead, or reads it as a follower,
+                                     every change of it then runs the pin change interrupt
+      void halSyncToggle(): changes the line, one tick, as the lead
+      void halSyncEnd(): lets go of the line
+      the pin is on port d, pins 0-7, read with the pin change interrupt
+
+    memory
+      int halFreeRam(): gets the bytes free between the heap and the stack, 0 on the host
+
+    the interrupt vectors are TIMER1_COMPA_vect, TIMER1_COMPB_vect for the pulses,
+    USART_RX_vect, USART_UDRE_vect and PCINT2_vect
+*/
+#ifdef ATROX_HOST
+
+#include "hal_host.h"
+
+#else
+
+#include <avr/eeprom.h>
+
+inline void halTimerStart(){
+  TCCR1A = 0;
+  TCCR1B = (1 << WGM12) | TIMER_CLK_DIV8;
+  TCNT1 = 0;
+  OCR1A = 1;
+  TIMSK1 |= (1 << OCIE1A);
+}
+
+inline void halTimerSet(const uint8_t clockSelect, const uint16_t ticks){
+  OCR1A = ticks;
+  TCCR1B = (1 << WGM12) | clockSelect;
+}
+
+inline void halTimerStop(){
+  TIMSK1 &= ~(1 << OCIE1A);
+  if(!(TIMSK1 & (1 << OCIE1B))) TCCR1B = 0; //else once the pulses end, see halPulseEnd()
+}
+
+inline bool halTimerIsLate(){
+  return TIFR1 & (1 << OCF1A);
+}
+
+//the pulses end on compare b of the step timer, at the clock of the
+//segment being stepped. rounded up, plus the tick under way
+inline bool halPulseStart(const uint8_t us){
+  const uint16_t cycles = us * (F_CPU / 1000000UL);
+  const uint8_t clockSelect = TCCR1B & ((1 << CS12) | (1 << CS11) | (1 << CS10));
+  uint16_t ticks = clockSelect == TIMER_CLK_DIV8 ? (cycles + 7) / 8
+                   : (clockSelect == TIMER_CLK_DIV64 ? (cycles + 63) / 64 : (cycles + 255) / 256);
+  uint32_t end = (uint32_t)TCNT1 + ticks + 1;
+  if(end >= OCR1A) return false; //compare b is not reached before the counter clears
+  OCR1B = end;
+  TIFR1 = (1 << OCF1B);
+  TIMSK1 |= (1 << OCIE1B);
+  return true;
+}
+
+inline void halPulseEnd(){
+  TIMSK1 &= ~(1 << OCIE1B);
+  if(!(TIMSK1 & (1 << OCIE1A))) TCCR1B = 0; //the step timer was stopped meanwhile
+}
+
+inline void halDirnSetup(const uint8_t us){
+  delayMicroseconds(us);
+}
+
+inline void halStepEvent(const uint8_t stepBits, const uint8_t dirnBits){
+  //nothing to do on the target, the host records the steps here
+}
+
+inline void halSegmentEvent(const uint8_t clockSelect, const uint16_t ticks, const uint16_t stepCount,
+                            const unsigned long* blockSteps, const uint8_t dirnBits){
+  //nothing to do on the target, the host records the segments here
+}
+
+inline void halEepromRead(const uint16_t address, void* data, const size_t size){
+  eeprom_read_block(data, (const void*)(uintptr_t)address, size);
+}
+
+inline void halEepromWrite(const uint16_t address, const void* data, const size_t size){
+  eeprom_update_block(data, (void*)(uintptr_t)address, size);
+}
+
+//the settings block fits below, see settings.h
+const uint16_t HAL_JOB_ADDRESS = 256;
+const uint16_t HAL_JOB_SIZE = E2END + 1 - HAL_JOB_ADDRESS;
+
+inline void halJobRead(const uint16_t address, void* data, const size_t size){
+  halEepromRead(HAL_JOB_ADDRESS + address, data, size);
+}
+
+inline void halJobWrite(const uint16_t address, const void* data, const size_t size){
+  halEepromWrite(HAL_JOB_ADDRESS + address, data, size);
+}
+
+inline uint16_t halAnalogRead(const uint8_t pin){
+  return analogRead(pin);
+}
+
+inline int halFreeRam(){
+  extern int __heap_start, *__brkval;
+  int top;
+  return (int)&top - (__brkval == 0 ? (int)&__heap_start : (int)__brkval);
+}
+
+inline void halUartBegin(const unsigned long baud){
+  uint16_t baudSetting = (F_CPU / 4 / baud - 1) / 2;
+  UCSR0A = (1 << U2X0);
+  UBRR0H = baudSetting >> 8;
+  UBRR0L = baudSetting;
+  UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);
+  UCSR0B = (1 << RXEN0) | (1 << TXEN0) | (1 << RXCIE0);
+}
+
+inline uint8_t halUartRead(){
+  return UDR0;
+}
+
+inline void halUartWrite(const uint8_t data){
+  UDR0 = data;
+}
+
+inline void halUartTxInterrupt(const bool isOn){
+  if(isOn){
+    UCSR0B |= (1 << UDRIE0);
+  }else{
+    UCSR0B &= ~(1 << UDRIE0);
+  }
+}
+
+inline bool halUartCanPoll(){
+  return !(SREG & (1 << SREG_I)) && (UCSR0A & (1 << UDRE0));
+}
+
+static_assert(!isSyncWired() || MACHINE_SYNC_PIN < 8, "the sync line is read on port d, pins 0-7");
+const uint8_t HAL_SYNC_BIT = isSyncWired() ? 1 << MACHINE_SYNC_PIN : 0;
+
+inline void halSyncBegin(const bool isLead){
+  if(!isSyncWired()) return;
+  if(isLead){
+    digitalWrite(MACHINE_SYNC_PIN, LOW);
+    pinMode(MACHINE_SYNC_PIN, OUTPUT);
+  }else{
+    pinMode(MACHINE_SYNC_PIN, INPUT);
+    PCMSK2 |= HAL_SYNC_BIT;
+    PCIFR = (1 << PCIF2); //a change before now is no tick
+    PCICR |= (1 << PCIE2);
+  }
+}
+
+inline void halSyncToggle(){
+  if(isSyncWired()) PIND = HAL_SYNC_BIT; //writing the input bit toggles the output
+}
+
+inline void halSyncEnd(){
+  if(!isSyncWired()) return;
+  PCICR &= ~(1 << PCIE2);
+  PCMSK2 &= ~HAL_SYNC_BIT;
+  pinMode(MACHINE_SYNC_PIN, INPUT);
+}
+
+#endif //ATROX_HOST
+
+/*  pins known at compile time
+      template<uint8_t PIN> void halPinHigh(): sets a pin
+      template<uint8_t PIN> void halPinLow(): clears a pin
+      template<uint8_t PIN> bool halPinRead(): reads an input pin
+    the port and bit are resolved by the compiler as on the Uno, pins 0-7
+    on D, 8-13 on B and 14-19 on C, so a write is a single sbi or cbi
+    instead of a digitalWrite() table lookup
+*/
+constexpr uint8_t halPinMask(const uint8_t pin){
+  return pin < 8 ? 1 << pin : (pin < 14 ? 1 << (pin - 8) : (pin < 20 ? 1 << (pin - 14) : 0));
+}
+
+template<uint8_t PIN> inline volatile uint8_t& halPinPort(){
+  return PIN < 8 ? PORTD : (PIN < 14 ? PORTB : PORTC);
+}
+
+template<uint8_t PIN> inline void halPinHigh(){
+  halPinPort<PIN>() |= halPinMask(PIN);
+}
+
+template<uint8_t PIN> inline void halPinLow(){
+  halPinPort<PIN>() &= (uint8_t)~halPinMask(PIN);
+}
+
+template<uint8_t PIN> inline volatile uint8_t& halPinInput(){
+  return PIN < 8 ? PIND : (PIN < 14 ? PINB : PINC);
+}
+
+template<uint8_t PIN> inline bool halPinRead(){
+  return halPinInput<PIN>() & halPinMask(PIN);
+}
+
+#endif //_HAL_H
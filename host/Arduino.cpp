@@ -0,0 +1,147 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// host/Arduino.cpp                                                          //
+//                                                                           //
+// Description:                                                              //
+//      This is the implementation file for the stand-in Arduino core. Pin   //
+//      writes land in simulated port registers, time is the simulation's.  //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <Arduino.h>
+
+#include "sim.h"
+
+
+//port output registers, indexed as the core's port numbers: B 2, C 3, D 4
+volatile uint8_t portRegister[5]{};
+//port input registers, inputs not stood in for read high as if pulled up
+volatile uint8_t pinRegister[5]{0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+static bool isInterruptOn{true};
+
+
+/*  void pinMode(uint8_t pin, uint8_t mode)
+    > sets a pin mode, nothing to do on the host
+    args:
+      uint8_t pin: the pin
+      uint8_t mode: INPUT, OUTPUT or INPUT_PULLUP
+    returns nothing
+*/
+void pinMode(uint8_t pin, uint8_t mode){
+  if(mode == INPUT_PULLUP) digitalWrite(pin, HIGH);
+  return;
+} //end pinMode(uint8_t, uint8_t)
+
+
+/*  void digitalWrite(uint8_t pin, uint8_t val)
+    > sets a pin in its port register
+    args:
+      uint8_t pin: the pin
+      uint8_t val: HIGH or LOW
+    returns nothing
+*/
+void digitalWrite(uint8_t pin, uint8_t val){
+  volatile uint8_t* port = portOutputRegister(digitalPinToPort(pin));
+  if(val == LOW){
+    *port &= ~digitalPinToBitMask(pin);
+  }else{
+    *port |= digitalPinToBitMask(pin);
+  }
+  return;
+} //end digitalWrite(uint8_t, uint8_t)
+
+
+/*  int digitalRead(uint8_t pin)
+    > reads a pin from its port register
+    args:
+      uint8_t pin: the pin
+    returns HIGH or LOW
+*/
+int digitalRead(uint8_t pin){
+  return (*portOutputRegister(digitalPinToPort(pin)) & digitalPinToBitMask(pin)) ? HIGH : LOW;
+} //end digitalRead(uint8_t)
+
+
+/*  uint8_t digitalPinToPort(uint8_t pin)
+    > gets the port of a pin as on the Uno, pins 0-7 on D, 8-13 on B, 14-19 on C
+    args:
+      uint8_t pin: the pin
+    returns the port number
+*/
+uint8_t digitalPinToPort(uint8_t pin){
+  if(pin < 8) return 4;
+  if(pin < 14) return 2;
+  return 3;
+} //end digitalPinToPort(uint8_t)
+
+
+/*  uint8_t digitalPinToBitMask(uint8_t pin)
+    > gets the bit of a pin in its port, as on the Uno
+    args:
+      uint8_t pin: the pin
+    returns the bit mask
+*/
+uint8_t digitalPinToBitMask(uint8_t pin){
+  if(pin < 8) return 1 << pin;
+  if(pin < 14) return 1 << (pin - 8);
+  return 1 << ((pin - 14) % 8);
+} //end digitalPinToBitMask(uint8_t)
+
+
+/*  volatile uint8_t* portOutputRegister(uint8_t port)
+    > gets the output register of a port
+    args:
+      uint8_t port: the port number
+    returns address of the register
+*/
+volatile uint8_t* portOutputRegister(uint8_t port){
+  return &portRegister[port % 5];
+} //end portOutputRegister(uint8_t)
+
+
+/*  void noInterrupts()
+    > turns interrupts off. the simulation only runs interrupts between
+      passes of loop(), so this only keeps the state
+    no args
+    returns nothing
+*/
+void noInterrupts(){
+  isInterruptOn = false;
+  return;
+} //end noInterrupts()
+
+
+/*  void interrupts()
+    > turns interrupts on
+    no args
+    returns nothing
+*/
+void interrupts(){
+  isInterruptOn = true;
+  return;
+} //end interrupts()
+
+
+/*  unsigned long millis()
+    > gets the simulated time
+    no args
+    returns the time in millisec
+*/
+unsigned long millis(){
+  return sim.cycles() / (F_CPU / 1000);
+} //end millis()
+
+
+/*  unsigned long micros()
+    > gets the simulated time
+    no args
+    returns the time in microsec
+*/
+unsigned long micros(){
+  return sim.cycles() / (F_CPU / 1000000);
+} //end micros()
@@ -0,0 +1,94 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// host/Arduino.h                                                            //
+//                                                                           //
+// Description:                                                              //
+//      This is a stand-in for the Arduino core header, for the host         //
+//      simulation build. It only has what the firmware uses. Pins are       //
+//      mapped to ports as on the Uno.                                       //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _HOST_ARDUINO_H
+#define _HOST_ARDUINO_H
+
+#include <ctype.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <type_traits>
+
+#include "Print.h"
+
+#define F_CPU 16000000UL
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+//timer1 clock select bits, see hal.h
+#define CS10 0
+#define CS11 1
+#define CS12 2
+
+//port output registers, indexed as the core's port numbers
+extern volatile uint8_t portRegister[5];
+#define PORTB (portRegister[2])
+#define PORTC (portRegister[3])
+#define PORTD (portRegister[4])
+
+//port input registers, set by the simulation for the inputs it stands in for
+extern volatile uint8_t pinRegister[5];
+#define PINB (pinRegister[2])
+#define PINC (pinRegister[3])
+#define PIND (pinRegister[4])
+
+//flash is ordinary memory on the host
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_float(addr) (*(const float*)(addr))
+#define memcpy_P(dest, src, size) memcpy((dest), (src), (size))
+#define F(string) (reinterpret_cast<const __FlashStringHelper*>(string))
+
+//interrupt handlers are plain functions, called by the simulation
+#define ISR(vector) extern "C" void vector(void)
+
+typedef uint8_t byte;
+
+//the core's macros, as templates so they do not clash with the c++ library
+//they return by value, a reference to an argument would outlive it
+template<class A, class B> auto min(A a, B b) -> typename std::common_type<A, B>::type{
+  return a < b ? a : b;
+}
+template<class A, class B> auto max(A a, B b) -> typename std::common_type<A, B>::type{
+  return a > b ? a : b;
+}
+template<class A, class B, class C> auto constrain(A x, B low, C high) -> typename std::common_type<A, B, C>::type{
+  return x < low ? low : (x > high ? high : x);
+}
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint8_t digitalPinToPort(uint8_t pin);
+uint8_t digitalPinToBitMask(uint8_t pin);
+volatile uint8_t* portOutputRegister(uint8_t port);
+
+void noInterrupts();
+void interrupts();
+
+unsigned long millis();
+unsigned long micros();
+
+#endif //_HOST_ARDUINO_H
@@ -0,0 +1,167 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// host/Print.cpp                                                            //
+//                                                                           //
+// Description:                                                              //
+//      This is the implementation file for the stand-in Print class. The    //
+//      formats follow the Arduino core's.                                   //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Print.h"
+
+
+/*  size_t Print::write(const uint8_t* buffer, size_t size)
+    > writes a buffer of bytes
+    args:
+      const uint8_t* buffer: the bytes
+      size_t size: number of bytes
+    returns the number of bytes written
+*/
+size_t Print::write(const uint8_t* buffer, size_t size){
+  for(size_t index{}; index < size; index++) write(buffer[index]);
+  return size;
+} //end Print::write(const uint8_t*, size_t)
+
+
+/*  size_t Print::write(const char* str)
+    > writes a string
+    args:
+      const char* str: the string
+    returns the number of bytes written
+*/
+size_t Print::write(const char* str){
+  return write((const uint8_t*)str, strlen(str));
+} //end Print::write(const char*)
+
+
+/*  size_t Print::print(const __FlashStringHelper* str)
+    > prints a string given with F(), flash is ordinary memory on the host
+    args:
+      const __FlashStringHelper* str: the string
+    returns the number of bytes written
+*/
+size_t Print::print(const __FlashStringHelper* str){
+  return write((const char*)str);
+} //end Print::print(const __FlashStringHelper*)
+
+
+/*  size_t Print::print(const char* str)
+    > prints a string
+    args:
+      const char* str: the string
+    returns the number of bytes written
+*/
+size_t Print::print(const char* str){
+  return write(str);
+} //end Print::print(const char*)
+
+
+/*  size_t Print::print(char data)
+    > prints a character
+    args:
+      char data: the character
+    returns the number of bytes written
+*/
+size_t Print::print(char data){
+  return write((uint8_t)data);
+} //end Print::print(char)
+
+
+/*  size_t Print::print(int val, int base)
+    > prints an integer
+    args:
+      int val: the integer
+      int base: the base, 10 by default
+    returns the number of bytes written
+*/
+size_t Print::print(int val, int base){
+  return print((long)val, base);
+} //end Print::print(int, int)
+
+
+/*  size_t Print::print(unsigned int val, int base)
+    > prints an unsigned integer
+    args:
+      unsigned int val: the integer
+      int base: the base, 10 by default
+    returns the number of bytes written
+*/
+size_t Print::print(unsigned int val, int base){
+  return print((unsigned long)val, base);
+} //end Print::print(unsigned int, int)
+
+
+/*  size_t Print::print(long val, int base)
+    > prints a long integer, signed in base 10 only as the core does
+    args:
+      long val: the integer
+      int base: the base, 10 by default
+    returns the number of bytes written
+*/
+size_t Print::print(long val, int base){
+  if(base == 10 && val < 0){
+    return print('-') + print((unsigned long)-val, base);
+  }
+  return print((unsigned long)val, base);
+} //end Print::print(long, int)
+
+
+/*  size_t Print::print(unsigned long val, int base)
+    > prints an unsigned long integer
+    args:
+      unsigned long val: the integer
+      int base: the base, 10 by default
+    returns the number of bytes written
+*/
+size_t Print::print(unsigned long val, int base){
+  char digit[8 * sizeof(long)];
+  int count{};
+  if(base < 2) base = 10;
+  do{
+    int remainder = val % base;
+    digit[count++] = remainder < 10 ? '0' + remainder : 'A' + remainder - 10;
+    val /= base;
+  }while(val > 0);
+
+  size_t written{};
+  while(count > 0) written += write((uint8_t)digit[--count]);
+  return written;
+} //end Print::print(unsigned long, int)
+
+
+/*  size_t Print::print(double val, int digits)
+    > prints a float with a number of decimals, as the core does
+    args:
+      double val: the float
+      int digits: decimals, 2 by default
+    returns the number of bytes written
+*/
+size_t Print::print(double val, int digits){
+  if(isnan(val)) return print("nan");
+  if(isinf(val)) return print("inf");
+  if(val > 4294967040.0 || val < -4294967040.0) return print("ovf");
+
+  char text[48];
+  snprintf(text, sizeof(text), "%.*f", digits, val);
+  return write(text);
+} //end Print::print(double, int)
+
+
+/*  size_t Print::println()
+    > ends a line with \r\n
+    no args
+    returns the number of bytes written
+*/
+size_t Print::println(){
+  return write("\r\n");
+} //end Print::println()
@@ -0,0 +1,55 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// host/Print.h                                                              //
+//                                                                           //
+// Description:                                                              //
+//      This is a stand-in for the Arduino core's Print class, for the host  //
+//      simulation build.                                                    //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _HOST_PRINT_H
+#define _HOST_PRINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+class __FlashStringHelper;
+
+/*  class Print
+    > formats text and numbers into bytes written by write(uint8_t),
+      as the core's Print does
+*/
+class Print{
+  public:
+    virtual ~Print(){}
+    virtual size_t write(uint8_t data) = 0;
+    size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str);
+
+    size_t print(const __FlashStringHelper* str);
+    size_t print(const char* str);
+    size_t print(char data);
+    size_t print(int val, int base = 10);
+    size_t print(unsigned int val, int base = 10);
+    size_t print(long val, int base = 10);
+    size_t print(unsigned long val, int base = 10);
+    size_t print(double val, int digits = 2);
+
+    size_t println();
+    template<class T> size_t println(T val){
+      size_t count = print(val);
+      return count + println();
+    }
+    template<class T> size_t println(T val, int format){
+      size_t count = print(val, format);
+      return count + println();
+    }
+};
+
+#endif //_HOST_PRINT_H
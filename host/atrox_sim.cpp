@@ -0,0 +1,121 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// host/atrox_sim.cpp                                                        //
+//                                                                           //
+// Description:                                                              //
+//      This runs the firmware on the host. G-code is streamed to it over    //
+//      the simulated serial line, what it answers is printed and the steps  //
+//      it sends can be written out per axis with their time.                //
+//                                                                           //
+//      usage: atrox_sim [-s steps.csv] [-t max sec] [-l X=-3000 ...]        //
+//                       [-j job.bin] [file.gcode]                           //
+//             g-code is read from stdin without a file, -l puts the limit   //
+//             switch of an axis at a position in step, -j keeps the job     //
+//             storage in a file, a job saved with M29 runs with M24 later   //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+#include "sim.h"
+
+
+/*  bool readAll(FILE* file, std::string* text)
+    > reads a whole file
+    args:
+      FILE* file: the file
+      std::string* text: where the text goes
+    returns true if read
+*/
+bool readAll(FILE* file, std::string* text){
+  char buffer[4096];
+  size_t count{};
+  while((count = fread(buffer, 1, sizeof(buffer), file)) > 0) text->append(buffer, count);
+  return !ferror(file);
+} //end readAll(FILE*, std::string*)
+
+
+/*  bool writeSteps(const char* path)
+    > writes the recorded steps as csv: axis,cycle,dirn
+    args:
+      const char* path: the file to write
+    returns true if written
+*/
+bool writeSteps(const char* path){
+  FILE* file = fopen(path, "w");
+  if(file == nullptr) return false;
+  fprintf(file, "axis,cycle,dirn\n");
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    for(const simStep& step : sim.steps(axis)){
+      fprintf(file, "%d,%llu,%d\n", axis, (unsigned long long)step.cycle, step.dirn);
+    }
+  }
+  fclose(file);
+  return true;
+} //end writeSteps(const char*)
+
+
+int main(int argc, char* argv[]){
+  const char* stepPath{nullptr};
+  const char* gcodePath{nullptr};
+  double maxSeconds{3600.0};
+  for(int index{1}; index < argc; index++){
+    if(strcmp(argv[index], "-s") == 0 && index + 1 < argc){
+      stepPath = argv[++index];
+    }else if(strcmp(argv[index], "-t") == 0 && index + 1 < argc){
+      maxSeconds = atof(argv[++index]);
+    }else if(strcmp(argv[index], "-l") == 0 && index + 1 < argc){
+      const char* arg = argv[++index];
+      const char* letter = strchr(AXIS_LETTER, toupper(arg[0]));
+      if(arg[0] == '\0' || letter == nullptr || arg[1] != '=' || !isAxisHomed(letter - AXIS_LETTER)){
+        fprintf(stderr, "no limit switch on %s\n", arg);
+        return 2;
+      }
+      sim.setLimitSwitch(letter - AXIS_LETTER, atol(arg + 2));
+    }else if(strcmp(argv[index], "-j") == 0 && index + 1 < argc){
+      if(!sim.setJobFile(argv[++index])){
+        fprintf(stderr, "cannot open %s\n", argv[index]);
+        return 1;
+      }
+    }else if(argv[index][0] == '-'){
+      fprintf(stderr, "usage: %s [-s steps.csv] [-t max sec] [-l X=-3000 ...] [-j job.bin] [file.gcode]\n", argv[0]);
+      return 2;
+    }else{
+      gcodePath = argv[index];
+    }
+  }
+
+  std::string gcode;
+  FILE* file = gcodePath != nullptr ? fopen(gcodePath, "rb") : stdin;
+  if(file == nullptr || !readAll(file, &gcode)){
+    fprintf(stderr, "cannot read %s\n", gcodePath != nullptr ? gcodePath : "stdin");
+    return 1;
+  }
+  if(file != stdin) fclose(file);
+
+  sim.isEcho = true;
+  sim.begin();
+  sim.send(gcode.c_str());
+  bool isIdle = sim.runUntilIdle(maxSeconds);
+  fflush(stdout);
+
+  fprintf(stderr, "simulated %.6f sec%s\n", sim.seconds(), isIdle ? "" : ", time limit reached");
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    fprintf(stderr, "axis %d: %zu steps, position %ld\n", axis, sim.steps(axis).size(), sim.position(axis));
+  }
+  if(stepPath != nullptr && !writeSteps(stepPath)){
+    fprintf(stderr, "cannot write %s\n", stepPath);
+    return 1;
+  }
+  return isIdle ? 0 : 3;
+} //end main(int, char*[])
@@ -0,0 +1,1257 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// host/bench.cpp                                                            //
+//                                                                           //
+// Description:                                                              //
+//      This is the benchmark suite of the firmware, run on the host         //
+//      simulation. It reports as json, so runs of two firmware versions     //
+//      can be compared by a script:                                         //
+//        parser   g-code replayed through loadCommandFromSerial() and       //
+//                 Command::execute(), host time and cycles per line         //
+//        replay   g-code streamed over the simulated serial line, lines     //
+//                 per simulated sec, step rate, acceleration and jitter     //
+//                 per axis against maxSpeedStep and maxAccelStep, whether   //
+//                 the acceleration kept within its limit, and the           //
+//                 firmware's own statistics read back with M740             //
+//        profile  one long and one short move per axis at its limits,       //
+//                 step times against the ideal trapezoid or s-curve         //
+//        realtime feed hold and emergency stop sent at cruise, time and     //
+//                 steps from the byte received to the last step             //
+//        homing   every axis with a switch homed together, then one at a    //
+//                 time, switches half their seek travel away                //
+//        program  the g-code lines that fit in the job storage streamed     //
+//                 line by line against OK, then recorded and run with M24   //
+//        jog      the stick of the first axis with a joystick pushed from   //
+//                 the center and let go, latency from the input change to   //
+//                 the steps against an ideal response along maxAccelStep   //
+//        kinematics  fixed point sine and tool offset against double,      //
+//                 host time per offset, and a tool move turning the head:   //
+//                 the tip's deviation from its straight line as stepped,    //
+//                 against the axes going straight from end to end           //
+//        arc      a circle sent as one G2 line, then cut into lines by the  //
+//                 host at the same tolerance: bytes and lines sent, time,   //
+//                 and the stepped path's deviation from the circle          //
+//                                                                           //
+//      usage: atrox_bench [file.gcode ...] > bench.json                     //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC 1
+#else
+#define BENCH_HAS_TSC 0
+#endif
+
+#include "sim.h"
+#include "kinematics.h"
+#include "program.h"
+#include "sketch.h"
+#include "stepper.h"
+#include "uart.h"
+
+//lines replayed through the parser at least, the file is repeated to get there
+const long PARSE_MIN_LINES = 50000;
+//steps further apart than this belong to different moves
+const double MOVE_GAP_SEC = 1.0;
+//window speeds are measured over, for the acceleration. a window of T sec
+//reads a speed to about a step in T, an acceleration to about 2 step in T^2:
+//50step/s^2 here. at 10ms the uneven spacing of an axis not leading a
+//coordinated move read as 10000step/s^2
+const double SPEED_WINDOW_SEC = 0.2;
+//jitter histogram buckets: <1us, then [2^(i-1), 2^i) us, the last open ended
+const int JITTER_BUCKETS = 16;
+//step counts of the profile moves, one trapezoid and one triangle at 1000step/s
+const long PROFILE_LONG_STEPS = 4000;
+const long PROFILE_SHORT_STEPS = 200;
+//simulated time a run may take
+const double RUN_MAX_SEC = 3600.0;
+//time the host takes from an OK to sending the next line, usb serial latency
+const double HOST_LATENCY_SEC = 0.004;
+//times the stick is pushed and let go, each at another phase of the sampling
+const int JOG_TRIALS = 8;
+//tool move of the kinematics bench, the tip goes straight while the head turns
+const char KINEMATICS_MOVE[] = "G201 X20 Y-10 Z5 P30";
+//points the straight line of the axes is checked at
+const int JOINT_LINE_POINTS = 1000;
+//arc of the arc bench, a full circle about a center ARC_RADIUS_MM along +x
+const char ARC_MOVE[] = "G2 X0 Y0 I10 J0 F20";
+const double ARC_RADIUS_MM = 10.0;
+const double ARC_SPEED_MM = 20.0;
+
+
+/*  struct axisStats
+    > contains the step timing of an axis over a run
+*/
+struct axisStats{
+  long steps{};
+  double maxRate{};       //step per sec, from the shortest step interval
+  double peakAccel{};     //step per sec per sec, from speeds over SPEED_WINDOW_SEC
+  long jitter[JITTER_BUCKETS]{};  //change between consecutive step intervals
+};
+
+/*  struct profileError
+    > contains the step times of a move against the ideal trapezoid
+*/
+struct profileError{
+  double durationSec{};
+  double idealSec{};
+  double leadUs{};      //first step ahead of the best fit
+  double maxUs{};
+  double rmsUs{};
+};
+
+
+/*  std::vector<std::string> splitLines(const std::string& text)
+    > splits text into lines, without their line ends
+    args:
+      const std::string& text: the text
+    returns the lines
+*/
+std::vector<std::string> splitLines(const std::string& text){
+  std::vector<std::string> lines;
+  size_t start{};
+  while(start < text.size()){
+    size_t end = text.find('\n', start);
+    if(end == std::string::npos) end = text.size();
+    std::string line = text.substr(start, end - start);
+    if(!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+    lines.push_back(line);
+    start = end + 1;
+  }
+  return lines;
+} //end splitLines(const std::string&)
+
+
+/*  bool readFile(const char* path, std::string* text)
+    > reads a whole file
+    args:
+      const char* path: the file
+      std::string* text: where the text goes
+    returns true if read
+*/
+bool readFile(const char* path, std::string* text){
+  FILE* file = fopen(path, "rb");
+  if(file == nullptr) return false;
+  char buffer[4096];
+  size_t count{};
+  while((count = fread(buffer, 1, sizeof(buffer), file)) > 0) text->append(buffer, count);
+  bool isRead = !ferror(file);
+  fclose(file);
+  return isRead;
+} //end readFile(const char*, std::string*)
+
+
+/*  long countOf(const std::string& text, const char* word)
+    > counts a word in text
+    args:
+      const std::string& text: the text
+      const char* word: the word
+    returns the count
+*/
+long countOf(const std::string& text, const char* word){
+  long count{};
+  size_t found = text.find(word);
+  while(found != std::string::npos){
+    count++;
+    found = text.find(word, found + 1);
+  }
+  return count;
+} //end countOf(const std::string&, const char*)
+
+
+/*  std::string answers()
+    > gets what the firmware sent without the xon and xoff bytes, which
+      are sent ahead of the rest and may fall inside an answer
+    no args
+    returns the text sent
+*/
+std::string answers(){
+  std::string text;
+  for(char letter : sim.output()){
+    if(letter != XON_CHAR && letter != XOFF_CHAR) text += letter;
+  }
+  return text;
+} //end answers()
+
+
+/*  const char* reportLine(const std::string& report, const char* key)
+    > finds the line of a report starting with a key
+    args:
+      const std::string& report: the report, eg of M740
+      const char* key: the start of the line
+    returns the line and what follows, an empty string if not found, so
+      it scans as nothing
+*/
+const char* reportLine(const std::string& report, const char* key){
+  size_t at = report.find(key);
+  return at == std::string::npos ? "" : report.c_str() + at;
+} //end reportLine(const std::string&, const char*)
+
+
+/*  axisStats measureAxis(const std::vector<simStep>& steps)
+    > measures the step timing of an axis
+    args:
+      const std::vector<simStep>& steps: the steps of the axis, oldest first
+    returns the stats
+*/
+axisStats measureAxis(const std::vector<simStep>& steps){
+  axisStats stats;
+  stats.steps = steps.size();
+  const double cycleSec = 1.0 / F_CPU;
+  const uint64_t gapCycles = MOVE_GAP_SEC * F_CPU;
+
+  uint64_t prevInterval{};
+  for(size_t index{1}; index < steps.size(); index++){
+    uint64_t interval = steps[index].cycle - steps[index - 1].cycle;
+    if(interval > gapCycles || steps[index].dirn != steps[index - 1].dirn){
+      prevInterval = 0; //a new move
+      continue;
+    }
+    stats.maxRate = max(stats.maxRate, 1.0 / (interval * cycleSec));
+    if(prevInterval > 0){
+      double changeUs = fabs((double)interval - (double)prevInterval) * cycleSec * 1e6;
+      int bucket{};
+      while(bucket < JITTER_BUCKETS - 1 && changeUs >= (1L << bucket)) bucket++;
+      stats.jitter[bucket]++;
+    }
+    prevInterval = interval;
+  }
+
+  //speeds over windows, the acceleration between neighbouring windows
+  const uint64_t windowCycles = SPEED_WINDOW_SEC * F_CPU;
+  double prevSpeed{-1}, prevMid{};
+  size_t start{};
+  while(start + 1 < steps.size()){
+    size_t end{start + 1};
+    while(end < steps.size() && steps[end].cycle - steps[start].cycle < windowCycles
+          && steps[end].cycle - steps[end - 1].cycle <= gapCycles) end++;
+    if(end == steps.size() || steps[end].cycle - steps[end - 1].cycle > gapCycles){
+      prevSpeed = -1; //window cut by the end of a move
+      start = end;
+      continue;
+    }
+    double span = (steps[end].cycle - steps[start].cycle) * cycleSec;
+    double speed = (end - start) / span;
+    double mid = (steps[start].cycle + steps[end].cycle) * 0.5 * cycleSec;
+    if(prevSpeed >= 0) stats.peakAccel = max(stats.peakAccel, fabs(speed - prevSpeed) / (mid - prevMid));
+    prevSpeed = speed;
+    prevMid = mid;
+    start = end;
+  }
+  return stats;
+} //end measureAxis(const std::vector<simStep>&)
+
+
+/*  double curveRampTime(const double peak, const double accel, const double jerk)
+    > gets the time an s-curve ramp from rest takes to reach a speed
+    args:
+      const double peak: the speed reached, in step per sec
+      const double accel: acceleration in step per sec per sec
+      const double jerk: jerk in step per sec per sec per sec
+    returns the time in sec
+*/
+double curveRampTime(const double peak, const double accel, const double jerk){
+  double jerkTime = min(accel / jerk, sqrt(peak / jerk));
+  return peak / (jerk * jerkTime) + jerkTime;
+} //end curveRampTime(const double, const double, const double)
+
+
+/*  double curveRampPosition(const double time, const double peak, const double accel, const double jerk)
+    > gets the position an s-curve ramp from rest is at
+    args:
+      const double time: time since the start of the ramp, in sec
+      const double peak: the speed reached, in step per sec
+      const double accel: acceleration in step per sec per sec
+      const double jerk: jerk in step per sec per sec per sec
+    returns the position in step
+*/
+double curveRampPosition(const double time, const double peak, const double accel, const double jerk){
+  double jerkTime = min(accel / jerk, sqrt(peak / jerk));
+  double peakAccel = jerk * jerkTime;
+  double rampTime = curveRampTime(peak, accel, jerk);
+  if(time <= jerkTime) return jerk * time * time * time / 6;
+  if(time <= rampTime - jerkTime){
+    double holdTime = time - jerkTime;
+    return peakAccel * (jerkTime * jerkTime / 6 + jerkTime * holdTime / 2 + holdTime * holdTime / 2);
+  }
+  double timeLeft = rampTime - time;
+  return peak * (rampTime / 2 - timeLeft) + jerk * timeLeft * timeLeft * timeLeft / 6;
+} //end curveRampPosition(const double, const double, const double, const double)
+
+
+/*  double idealTime(const double position, const long stepCount, const double speed, const double accel, const double jerk)
+    > gets the time a move from rest to rest reaches a position, along a
+      trapezoid or, with a jerk, along s-curve ramps
+    args:
+      const double position: the position, in step
+      const long stepCount: length of the move, in step
+      const double speed: cruise speed in step per sec
+      const double accel: acceleration in step per sec per sec
+      const double jerk: jerk in step per sec per sec per sec, 0 for a trapezoid
+    returns the time in sec
+*/
+double idealTime(const double position, const long stepCount, const double speed, const double accel, const double jerk){
+  if(jerk <= 0){
+    double peak = min(speed, sqrt(accel * stepCount));
+    double rampLength = peak * peak / (2 * accel);
+    double rampTime = peak / accel;
+    double totalTime = 2 * rampTime + (stepCount - 2 * rampLength) / peak;
+    if(position <= rampLength) return sqrt(2 * position / accel);
+    if(position <= stepCount - rampLength) return rampTime + (position - rampLength) / peak;
+    return totalTime - sqrt(2 * max(stepCount - position, 0.0) / accel);
+  }
+
+  //highest speed whose ramps up and down fit the move
+  double peak{speed};
+  if(peak * curveRampTime(peak, accel, jerk) > stepCount){
+    double low{}, high{speed};
+    for(int i{}; i < 60; i++){
+      peak = (low + high) / 2;
+      if(peak * curveRampTime(peak, accel, jerk) > stepCount) high = peak;
+      else low = peak;
+    }
+    peak = low;
+  }
+  double rampTime = curveRampTime(peak, accel, jerk);
+  double rampLength = peak * rampTime / 2;
+  double totalTime = 2 * rampTime + (stepCount - 2 * rampLength) / peak;
+  double rampPosition = min(position, stepCount - position);
+  if(rampPosition > rampLength) return rampTime + (position - rampLength) / peak;
+
+  //time into the ramp, the ramp position only grows
+  double low{}, high{rampTime};
+  for(int i{}; i < 60; i++){
+    double time = (low + high) / 2;
+    if(curveRampPosition(time, peak, accel, jerk) > max(rampPosition, 0.0)) high = time;
+    else low = time;
+  }
+  return position <= rampLength ? low : totalTime - low;
+} //end idealTime(const double, const long, const double, const double, const double)
+
+
+/*  profileError measureProfile(const std::vector<simStep>& steps, const double speed, const double accel, const double jerk)
+    > compares the steps of one move to the ideal trapezoid or s-curve
+      step k is due when the ideal move reaches k + 1/2 steps. the ideal
+      move is shifted to fit the steps best, the shift is the lead of the
+      first step and the rest is the error of the profile
+    args:
+      const std::vector<simStep>& steps: the steps of the move
+      const double speed: cruise speed in step per sec
+      const double accel: acceleration in step per sec per sec
+      const double jerk: jerk in step per sec per sec per sec, 0 for a trapezoid
+    returns the error
+*/
+profileError measureProfile(const std::vector<simStep>& steps, const double speed, const double accel, const double jerk){
+  profileError error;
+  if(steps.empty()) return error;
+  long stepCount = steps.size();
+  double firstSec = (double)steps[0].cycle / F_CPU;
+
+  double offsetSum{};
+  for(long index{}; index < stepCount; index++){
+    offsetSum += (double)steps[index].cycle / F_CPU - firstSec - idealTime(index + 0.5, stepCount, speed, accel, jerk);
+  }
+  double offset = offsetSum / stepCount;
+
+  double errorSqrSum{};
+  for(long index{}; index < stepCount; index++){
+    double actual = (double)steps[index].cycle / F_CPU - firstSec - offset;
+    double errorUs = (actual - idealTime(index + 0.5, stepCount, speed, accel, jerk)) * 1e6;
+    error.maxUs = max(error.maxUs, fabs(errorUs));
+    errorSqrSum += errorUs * errorUs;
+  }
+  error.leadUs = (offset + idealTime(0.5, stepCount, speed, accel, jerk)) * 1e6;
+  error.rmsUs = sqrt(errorSqrSum / stepCount);
+  error.durationSec = (double)(steps[stepCount - 1].cycle - steps[0].cycle) / F_CPU;
+  error.idealSec = idealTime(stepCount - 0.5, stepCount, speed, accel, jerk) - idealTime(0.5, stepCount, speed, accel, jerk);
+  return error;
+} //end measureProfile(const std::vector<simStep>&, const double, const double, const double)
+
+
+/*  void printNumber(const char* key, const double val, const int decimals)
+    > prints a json member ", key: val", null if val is not finite
+    args:
+      const char* key: name of the member
+      const double val: the value
+      const int decimals: decimals printed
+    returns nothing
+*/
+void printNumber(const char* key, const double val, const int decimals){
+  if(isfinite(val)){
+    printf(", \"%s\": %.*f", key, decimals, val);
+  }else{
+    printf(", \"%s\": null", key);
+  }
+  return;
+} //end printNumber(const char*, const double, const int)
+
+
+/*  void printJitter(const long jitter[])
+    > prints a jitter histogram as a json object, keyed by bucket lower bound in us
+    args:
+      const long jitter[]: the histogram
+    returns nothing
+*/
+void printJitter(const long jitter[]){
+  printf("{");
+  for(int bucket{}; bucket < JITTER_BUCKETS; bucket++){
+    printf("%s\"%ld\": %ld", bucket > 0 ? ", " : "", bucket > 0 ? 1L << (bucket - 1) : 0L, jitter[bucket]);
+  }
+  printf("}");
+  return;
+} //end printJitter(const long[])
+
+
+/*  void benchParser(const char* name, const std::string& text, const bool isLast)
+    > replays g-code through loadCommandFromSerial() and Command::execute()
+      lines go straight into the serial port's receive buffer. the planner is
+      emptied when full, as nothing steps here
+    args:
+      const char* name: name of the g-code
+      const std::string& text: the g-code
+      const bool isLast: last entry of the json array
+    returns nothing
+*/
+void benchParser(const char* name, const std::string& text, const bool isLast){
+  std::vector<std::string> lines = splitLines(text);
+  long lineCount{}, errorCount{}, passCount{};
+  double loadNs{}, executeNs{};
+  uint64_t loadTsc{}, executeTsc{};
+
+  while(lineCount < PARSE_MIN_LINES && !lines.empty()){
+    passCount++;
+    for(const std::string& line : lines){
+      for(char incoming : line) uart.rxIsr(incoming);
+      uart.rxIsr('\n');
+      lineCount++;
+
+      auto loadStart = std::chrono::steady_clock::now();
+#if BENCH_HAS_TSC
+      uint64_t tscStart = __rdtsc();
+#endif
+      int loadStatus = loadCommandFromSerial(&gcodeReader);
+#if BENCH_HAS_TSC
+      loadTsc += __rdtsc() - tscStart;
+#endif
+      loadNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - loadStart).count();
+
+      if(loadStatus == -1) errorCount++;
+      if(loadStatus != 1) continue;
+      while(command.isMotion() && !planner.isEmpty()) planner.discardCurrentBlock();
+
+      auto executeStart = std::chrono::steady_clock::now();
+#if BENCH_HAS_TSC
+      tscStart = __rdtsc();
+#endif
+      command.execute();
+#if BENCH_HAS_TSC
+      executeTsc += __rdtsc() - tscStart;
+#endif
+      executeNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - executeStart).count();
+    }
+  }
+  while(!planner.isEmpty()) planner.discardCurrentBlock();
+
+  printf("    {\"file\": \"%s\", \"lines\": %ld, \"errors_per_pass\": %ld",
+         name, lineCount, errorCount / max(passCount, 1L));
+  printNumber("load_ns_per_line", loadNs / lineCount, 1);
+  printNumber("execute_ns_per_line", executeNs / lineCount, 1);
+  printNumber("lines_per_sec", lineCount / ((loadNs + executeNs) * 1e-9), 0);
+#if BENCH_HAS_TSC
+  printNumber("load_cycles_per_line", (double)loadTsc / lineCount, 0);
+  printNumber("execute_cycles_per_line", (double)executeTsc / lineCount, 0);
+#endif
+  printf("}%s\n", isLast ? "" : ",");
+  sim.clearRecords();
+  return;
+} //end benchParser(const char*, const std::string&, const bool)
+
+
+/*  void benchReplay(const char* name, const std::string& text, const bool isLast)
+    > streams g-code to the firmware over the simulated serial line and
+      measures the steps it sends. the firmware is put back in step unit
+      and relative positioning first, with its statistics cleared, and
+      they are read with M740 once the g-code ran
+    args:
+      const char* name: name of the g-code
+      const std::string& text: the g-code
+      const bool isLast: last entry of the json array
+    returns nothing
+*/
+void benchReplay(const char* name, const std::string& text, const bool isLast){
+  sim.send("G220\nG21\nG91\nM741\n");
+  sim.runUntilIdle(RUN_MAX_SEC);
+  sim.clearRecords();
+
+  uint64_t startCycle = sim.cycles();
+  sim.send(text.c_str());
+  bool isIdle = sim.runUntilIdle(sim.seconds() + RUN_MAX_SEC);
+  double runSec = (double)(sim.cycles() - startCycle) / F_CPU;
+  long okCount = countOf(answers(), "OK\r\n");
+  long errCount = countOf(answers(), "ERR\r\n");
+
+  sim.output().clear(); //the steps are measured below
+  sim.send("M740\n");
+  sim.runUntilIdle(sim.seconds() + RUN_MAX_SEC);
+  std::string report = answers();
+  unsigned long waitLast{}, waitPeak{}, motionLast{}, motionPeak{};
+  int plannerDepth{}, plannerPeak{}, rxPeak{}, underruns{}, overruns{};
+  sscanf(reportLine(report, "WAIT US"), "WAIT US %lu MAX %lu", &waitLast, &waitPeak);
+  sscanf(reportLine(report, "MOTION MS"), "MOTION MS %lu MAX %lu", &motionLast, &motionPeak);
+  sscanf(reportLine(report, "PLANNER"), "PLANNER %d MAX %d", &plannerDepth, &plannerPeak);
+  sscanf(reportLine(report, "RX MAX"), "RX MAX %d", &rxPeak);
+  sscanf(reportLine(report, "UNDERRUNS"), "UNDERRUNS %d OVERRUNS %d", &underruns, &overruns);
+
+  printf("    {\"file\": \"%s\", \"completed\": %s, \"ok\": %ld, \"err\": %ld",
+         name, isIdle ? "true" : "false", okCount, errCount);
+  printNumber("sim_sec", runSec, 6);
+  printNumber("lines_per_sim_sec", (okCount + errCount) / runSec, 1);
+  printf(", \"m740\": {\"wait_max_us\": %lu, \"motion_max_ms\": %lu, \"planner_peak\": %d, \"rx_peak\": %d"
+         ", \"underruns\": %d, \"overruns\": %d}", waitPeak, motionPeak, plannerPeak, rxPeak, underruns, overruns);
+  printf(", \"axes\": [\n");
+  bool isFirst{true};
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    const std::vector<simStep>& steps = sim.steps(axis);
+    if(steps.empty()) continue;
+    axisStats stats = measureAxis(steps);
+    const motorData& motor = atrox.motor[axis];
+    printf("%s      {\"axis\": \"%c\", \"steps\": %ld", isFirst ? "" : ",\n", AXIS_LETTER[axis], stats.steps);
+    printNumber("max_rate", stats.maxRate, 1);
+    printNumber("limit_speed", motor.maxSpeedStep, 1);
+    printNumber("peak_accel", stats.peakAccel, 1);
+    printNumber("limit_accel", motor.maxAccelStep, 1);
+    printNumber("limit_jerk", motor.maxJerkStep, 1);
+    //to the resolution of the speed windows, see SPEED_WINDOW_SEC
+    bool isWithinLimit = stats.peakAccel <= motor.maxAccelStep + 2 / (SPEED_WINDOW_SEC * SPEED_WINDOW_SEC);
+    printf(", \"within_limit\": %s", isWithinLimit ? "true" : "false");
+    printf(", \"jitter_us\": ");
+    printJitter(stats.jitter);
+    printf("}");
+    isFirst = false;
+  }
+  printf("\n    ]}%s\n", isLast ? "" : ",");
+  return;
+} //end benchReplay(const char*, const std::string&, const bool)
+
+
+/*  void benchProfile()
+    > moves every axis alone at its limits, one long and one short move,
+      and compares the steps to the ideal trapezoid, or s-curve for an
+      axis with a jerk limit
+    no args
+    returns nothing
+*/
+void benchProfile(){
+  sim.send("G220\nG91\n");
+  sim.runUntilIdle(RUN_MAX_SEC);
+
+  const long stepCounts[2] = {PROFILE_LONG_STEPS, PROFILE_SHORT_STEPS};
+  bool isFirst{true};
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(!isAxisUsed(axis)) continue;
+    const motorData& motor = atrox.motor[axis];
+    for(long stepCount : stepCounts){
+      char line[32];
+      snprintf(line, sizeof(line), "G200 %c%ld\n", AXIS_LETTER[axis], stepCount);
+      sim.clearRecords();
+      sim.send(line);
+      sim.runUntilIdle(sim.seconds() + RUN_MAX_SEC);
+
+      const std::vector<simStep>& steps = sim.steps(axis);
+      axisStats stats = measureAxis(steps);
+      profileError error = measureProfile(steps, motor.maxSpeedStep, motor.maxAccelStep, motor.maxJerkStep);
+      printf("%s    {\"axis\": \"%c\", \"requested\": %ld, \"steps\": %ld",
+             isFirst ? "" : ",\n", AXIS_LETTER[axis], stepCount, stats.steps);
+      printNumber("limit_speed", motor.maxSpeedStep, 1);
+      printNumber("limit_accel", motor.maxAccelStep, 1);
+      printNumber("limit_jerk", motor.maxJerkStep, 1);
+      printNumber("duration_sec", error.durationSec, 6);
+      printNumber("ideal_sec", error.idealSec, 6);
+      printNumber("first_step_lead_us", error.leadUs, 1);
+      printNumber("error_max_us", error.maxUs, 1);
+      printNumber("error_rms_us", error.rmsUs, 1);
+      printNumber("max_rate", stats.maxRate, 1);
+      printNumber("peak_accel", stats.peakAccel, 1);
+      printf(", \"jitter_us\": ");
+      printJitter(stats.jitter);
+      printf("}");
+      isFirst = false;
+    }
+  }
+  printf("\n");
+  return;
+} //end benchProfile()
+
+
+/*  long stepsAfter(const std::vector<simStep>& steps, const uint64_t cycle, uint64_t* lastCycle)
+    > counts the steps sent from a cycle on
+    args:
+      const std::vector<simStep>& steps: the steps of an axis
+      const uint64_t cycle: cycle to count from
+      uint64_t* lastCycle: gets the cycle of the last step, cycle if none
+    returns the number of steps
+*/
+long stepsAfter(const std::vector<simStep>& steps, const uint64_t cycle, uint64_t* lastCycle){
+  long stepCount{};
+  *lastCycle = cycle;
+  for(const simStep& step : steps){
+    if(step.cycle < cycle) continue;
+    stepCount++;
+    *lastCycle = step.cycle;
+  }
+  return stepCount;
+} //end stepsAfter(const std::vector<simStep>&, const uint64_t, uint64_t*)
+
+
+/*  uint64_t sendRealtime(const int axis, const uint8_t data)
+    > starts a long move on an axis at its limits, sends a real-time
+      byte once half of it is stepped, at cruise, and runs until the byte
+      is received
+    args:
+      const int axis: the axis
+      const uint8_t data: the real-time byte, see uart.h
+    returns the cycle the byte was received at
+*/
+uint64_t sendRealtime(const int axis, const uint8_t data){
+  char line[32];
+  snprintf(line, sizeof(line), "G200 %c%ld\n", AXIS_LETTER[axis], PROFILE_LONG_STEPS);
+  sim.clearRecords();
+  sim.send(line);
+  const double maxSeconds = sim.seconds() + RUN_MAX_SEC;
+  while((long)sim.steps(axis).size() < PROFILE_LONG_STEPS / 2 && sim.seconds() < maxSeconds){
+    sim.runLoop();
+  }
+
+  const uint64_t sentAt = sim.cycles();
+  sim.send(&data, 1);
+  while(sim.receivedAt() <= sentAt && sim.seconds() < maxSeconds) sim.runLoop();
+  return sim.receivedAt();
+} //end sendRealtime(const int, const uint8_t)
+
+
+/*  void benchRealtime()
+    > sends a feed hold then a resume, and an emergency stop, in the
+      middle of a long move on the first axis of the machine. the hold
+      is measured against braking along maxAccelStep, the emergency stop
+      should send no step once its byte is received
+    no args
+    returns nothing
+*/
+void benchRealtime(){
+  int axis{};
+  while(!isAxisUsed(axis)) axis++;
+  const motorData& motor = atrox.motor[axis];
+  uint64_t lastCycle{};
+
+  //feed hold, then resume to the end of the move
+  uint64_t receivedAt = sendRealtime(axis, RT_FEED_HOLD);
+  const double maxSeconds = sim.seconds() + RUN_MAX_SEC;
+  while(!atrox.isHeld() && sim.seconds() < maxSeconds) sim.runLoop();
+  long holdSteps = stepsAfter(sim.steps(axis), receivedAt, &lastCycle);
+  double holdMs = (double)(lastCycle - receivedAt) * 1000.0 / F_CPU;
+  const uint8_t resume = RT_RESUME;
+  sim.send(&resume, 1);
+  sim.runUntilIdle(sim.seconds() + RUN_MAX_SEC);
+  long resumedSteps = sim.steps(axis).size();
+
+  printf("    {\"axis\": \"%c\", \"byte\": \"feed_hold\"", AXIS_LETTER[axis]);
+  printNumber("stop_ms", holdMs, 3);
+  printNumber("ideal_ms", motor.maxSpeedStep / motor.maxAccelStep * 1000.0, 3);
+  printf(", \"steps_after\": %ld", holdSteps);
+  printNumber("ideal_steps", motor.maxSpeedStep * motor.maxSpeedStep / (2 * motor.maxAccelStep), 1);
+  printf(", \"resumed_to\": %ld, \"requested\": %ld},\n", resumedSteps, PROFILE_LONG_STEPS);
+
+  //emergency stop, then cleared
+  receivedAt = sendRealtime(axis, RT_ESTOP);
+  sim.runUntilIdle(sim.seconds() + RUN_MAX_SEC);
+  long estopSteps = stepsAfter(sim.steps(axis), receivedAt, &lastCycle);
+  double estopMs = (double)(lastCycle - receivedAt) * 1000.0 / F_CPU;
+  sim.send("M999\nM17\n");
+  sim.runUntilIdle(sim.seconds() + RUN_MAX_SEC);
+
+  printf("    {\"axis\": \"%c\", \"byte\": \"emergency_stop\"", AXIS_LETTER[axis]);
+  printNumber("stop_ms", estopMs, 3);
+  printf(", \"steps_after\": %ld}\n", estopSteps);
+  return;
+} //end benchRealtime()
+
+
+/*  double timeHoming(const char* line)
+    > sends a homing command and runs until homing ends
+    args:
+      const char* line: the g-code line
+    returns the simulated time homing took, in sec, NAN if it failed
+*/
+double timeHoming(const char* line){
+  double start = sim.seconds();
+  sim.clearRecords();
+  sim.send(line);
+  sim.runUntilIdle(start + RUN_MAX_SEC);
+  if(sim.output().find("HOMED") == std::string::npos) return NAN;
+  return sim.seconds() - start;
+} //end timeHoming(const char*)
+
+
+/*  void returnToStart(const long start[])
+    > moves every axis back to a position
+    args:
+      const long start[]: the position per axis, see Simulation::axisPosition()
+    returns nothing
+*/
+void returnToStart(const long start[]){
+  std::string line{"G220\nG91\nG200"};
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(!isAxisUsed(axis)) continue;
+    char word[16];
+    snprintf(word, sizeof(word), " %c%ld", AXIS_LETTER[axis], start[axis] - sim.axisPosition(axis));
+    line += word;
+  }
+  line += "\n";
+  sim.send(line.c_str());
+  sim.runUntilIdle(sim.seconds() + RUN_MAX_SEC);
+  return;
+} //end returnToStart(const long[])
+
+
+/*  void benchHoming()
+    > puts the switch of every axis that has one half its seek travel
+      away, and homes the axes all together, then one at a time from the
+      same start. the latch error is the machine position against where
+      the axis is past its switch. a profile without a switch leaves the
+      section empty
+    no args
+    returns nothing
+*/
+void benchHoming(){
+  std::string axes;
+  long start[AXIS_COUNT];
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    start[axis] = sim.axisPosition(axis);
+    if(!isAxisHomed(axis)) continue;
+    const axisHoming& homing = MACHINE_HOMING[axis];
+    sim.setLimitSwitch(axis, sim.axisPosition(axis) + homing.homeDirn * homing.seekTravel / 2);
+    axes += AXIS_LETTER[axis];
+  }
+  if(axes.empty()) return; //no limit switch in the profile
+
+  double togetherSec = timeHoming("G28\n");
+  long latchError{};
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(!isAxisHomed(axis)) continue;
+    const axisHoming& homing = MACHINE_HOMING[axis];
+    long switchPosition = sim.axisPosition(axis) + homing.homeDirn * homing.pullOff;
+    long pastSwitch = sim.axisPosition(axis) - switchPosition;
+    latchError = max(latchError, labs(atrox.machinePosition((Axis)axis) - pastSwitch));
+  }
+  returnToStart(start);
+
+  double oneByOneSec{};
+  for(char letter : axes){
+    char line[16];
+    snprintf(line, sizeof(line), "G28 %c0\n", letter);
+    oneByOneSec += timeHoming(line);
+  }
+  returnToStart(start);
+  sim.clearLimitSwitches();
+
+  printf("    {\"axes\": \"%s\"", axes.c_str());
+  printNumber("together_sec", togetherSec, 3);
+  printNumber("one_at_a_time_sec", oneByOneSec, 3);
+  printf(", \"latch_error_steps\": %ld}\n", latchError);
+  return;
+} //end benchHoming()
+
+
+/*  std::string compactLine(const std::string& line)
+    > gets a line as the job storage keeps it, see Program::record(const char)
+    args:
+      const std::string& line: the g-code line
+    returns the line without spaces or comments, in upper case
+*/
+std::string compactLine(const std::string& line){
+  std::string compact;
+  bool isComment{false};
+  for(char letter : line){
+    if(isComment){
+      isComment = letter != ')';
+    }else if(letter == '('){
+      isComment = true;
+    }else if(letter == ';'){
+      break;
+    }else if(!isspace((unsigned char)letter)){
+      compact += toupper(letter);
+    }
+  }
+  return compact;
+} //end compactLine(const std::string&)
+
+
+/*  void streamLines(const std::vector<std::string>& lines, const double maxSeconds)
+    > sends lines one per OK or ERR, the host waiting HOST_LATENCY_SEC
+      before each line, then runs until the moves end
+    args:
+      const std::vector<std::string>& lines: the g-code lines
+      const double maxSeconds: simulated time to give up at
+    returns nothing
+*/
+void streamLines(const std::vector<std::string>& lines, const double maxSeconds){
+  for(const std::string& line : lines){
+    long answerCount = countOf(answers(), "OK\r\n") + countOf(answers(), "ERR\r\n");
+    sim.send((line + "\n").c_str());
+    while(countOf(answers(), "OK\r\n") + countOf(answers(), "ERR\r\n") == answerCount
+          && sim.seconds() < maxSeconds){
+      sim.runLoop();
+    }
+    double sendAt = sim.seconds() + HOST_LATENCY_SEC;
+    while(sim.seconds() < sendAt) sim.runLoop();
+  }
+  sim.runUntilIdle(maxSeconds);
+  return;
+} //end streamLines(const std::vector<std::string>&, const double)
+
+
+/*  void benchProgram(const char* name, const std::string& text, const bool isLast)
+    > takes the lines of g-code that fit in the job storage and runs them
+      twice: streamed one line per OK, the host waiting HOST_LATENCY_SEC
+      before each line, then recorded with M28 and run with M24
+    args:
+      const char* name: name of the g-code
+      const std::string& text: the g-code
+      const bool isLast: last entry of the json array
+    returns nothing
+*/
+void benchProgram(const char* name, const std::string& text, const bool isLast){
+  std::vector<std::string> lines;
+  size_t jobBytes{};
+  for(const std::string& line : splitLines(text)){
+    size_t size = compactLine(line).size();
+    if(size == 0) continue;
+    if(jobBytes + size + 1 > HAL_JOB_SIZE - sizeof(jobHeader)) break;
+    jobBytes += size + 1;
+    lines.push_back(line);
+  }
+
+  //streamed, as a host would without program mode
+  sim.send("G220\nG21\nG91\n");
+  sim.runUntilIdle(RUN_MAX_SEC);
+  sim.clearRecords();
+  double start = sim.seconds();
+  streamLines(lines, start + RUN_MAX_SEC);
+  double streamedSec = sim.seconds() - start;
+  long streamedSteps{};
+  for(int axis{}; axis < AXIS_COUNT; axis++) streamedSteps += sim.steps(axis).size();
+
+  //recorded once, then run from the job storage
+  std::string job{"M28\n"};
+  for(const std::string& line : lines) job += line + "\n";
+  job += "M29\nG220\nG21\nG91\n";
+  sim.send(job.c_str());
+  sim.runUntilIdle(RUN_MAX_SEC);
+  bool isSaved = sim.output().find("JOB SAVED") != std::string::npos;
+  sim.clearRecords();
+  start = sim.seconds();
+  sim.send("M24\n");
+  sim.runUntilIdle(start + RUN_MAX_SEC);
+  double storedSec = sim.seconds() - start;
+  bool isDone = sim.output().find("JOB DONE") != std::string::npos;
+  long storedSteps{};
+  for(int axis{}; axis < AXIS_COUNT; axis++) storedSteps += sim.steps(axis).size();
+
+  printf("    {\"file\": \"%s\", \"lines\": %zu, \"job_bytes\": %zu, \"saved\": %s, \"done\": %s",
+         name, lines.size(), jobBytes, isSaved ? "true" : "false", isDone ? "true" : "false");
+  printNumber("host_latency_ms", HOST_LATENCY_SEC * 1000.0, 1);
+  printNumber("streamed_sec", streamedSec, 6);
+  printNumber("stored_sec", storedSec, 6);
+  printf(", \"streamed_steps\": %ld, \"stored_steps\": %ld}%s\n", streamedSteps, storedSteps, isLast ? "" : ",");
+  return;
+} //end benchProgram(const char*, const std::string&, const bool)
+
+
+/*  void benchJog()
+    > jogs the first axis with a joystick: the stick is pushed to the end
+      of its travel from rest, held until the axis cruises, and let go.
+      from rest the first step is due once the axis covered a step along
+      maxAccelStep. once let go, every step past the ideal braking
+      distance is 1 / maxSpeedStep sec of latency between the stick and
+      the steps. the latency is bounded by a sampling period and the
+      segments prepared ahead. a profile without a joystick leaves the
+      section empty
+    no args
+    returns nothing
+*/
+void benchJog(){
+  int axis{};
+  while(axis < AXIS_COUNT && !isAxisJogged(axis)) axis++;
+  if(axis == AXIS_COUNT) return; //no joystick in the profile
+  const motorData& motor = atrox.motor[axis];
+  const uint8_t pin = MACHINE_JOG[axis].analogPin;
+  sim.send("M17\nM730\n");
+  sim.runUntilIdle(sim.seconds() + RUN_MAX_SEC);
+
+  double firstStepMs{};
+  double maxLatencyMs{};
+  double latencySumMs{};
+  for(int trial{}; trial < JOG_TRIALS; trial++){
+    //pushed, each trial a little later against the sampling
+    const double phaseSec = (double)trial / JOG_TRIALS * JOG_SAMPLE_US / 1e6;
+    double start = sim.seconds();
+    while(sim.seconds() < start + phaseSec) sim.runLoop();
+    sim.clearRecords();
+    start = sim.seconds();
+    sim.setAnalog(pin, 1023);
+    while(sim.steps(axis).empty() && sim.seconds() < start + RUN_MAX_SEC) sim.runLoop();
+    firstStepMs = max(firstStepMs, ((double)sim.steps(axis).front().cycle / F_CPU - start) * 1000.0);
+    while(sim.seconds() < start + motor.maxSpeedStep / motor.maxAccelStep + 0.2) sim.runLoop();
+
+    //let go
+    uint64_t lastCycle{};
+    const uint64_t releasedAt = sim.cycles();
+    sim.setAnalog(pin, 512);
+    sim.runUntilIdle(sim.seconds() + RUN_MAX_SEC);
+    long stepsAfterRelease = stepsAfter(sim.steps(axis), releasedAt, &lastCycle);
+    double idealSteps = motor.maxSpeedStep * motor.maxSpeedStep / (2 * motor.maxAccelStep);
+    double latencyMs = (stepsAfterRelease - idealSteps) / motor.maxSpeedStep * 1000.0;
+    maxLatencyMs = max(maxLatencyMs, latencyMs);
+    latencySumMs += latencyMs;
+  }
+  sim.send("M0\n");
+  sim.runUntilIdle(sim.seconds() + RUN_MAX_SEC);
+  bool isEnded = sim.output().find("JOG END") != std::string::npos;
+
+  printf("    {\"axis\": \"%c\", \"trials\": %d, \"ended\": %s", AXIS_LETTER[axis], JOG_TRIALS, isEnded ? "true" : "false");
+  printNumber("first_step_ms", firstStepMs, 3);
+  printNumber("ideal_first_step_ms", sqrt(2 / motor.maxAccelStep) * 1000.0, 3);
+  printNumber("latency_ms", latencySumMs / JOG_TRIALS, 3);
+  printNumber("max_latency_ms", maxLatencyMs, 3);
+  printNumber("bound_ms", (JOG_SAMPLE_US / 1e6 + (JOG_SEGMENTS_AHEAD + 1) / SEGMENTS_PER_SEC) * 1000.0, 3);
+  printf("}\n");
+  return;
+} //end benchJog()
+
+
+/*  void exactOffset(const double yaw, const double pitch, double offset[])
+    > gets the tool offset in double, see toolOffset() in kinematics.h
+    args:
+      const double yaw: the yaw, in degrees
+      const double pitch: the pitch, in degrees
+      double offset[]: gets the offset along x, y and z, in um
+    returns nothing
+*/
+void exactOffset(const double yaw, const double pitch, double offset[]){
+  const double radian = M_PI / 180.0;
+  offset[0] = MACHINE_TOOL_LENGTH * sin(pitch * radian) * cos(yaw * radian);
+  offset[1] = MACHINE_TOOL_LENGTH * sin(pitch * radian) * sin(yaw * radian);
+  offset[2] = MACHINE_TOOL_LENGTH * (1 - cos(pitch * radian));
+  return;
+} //end exactOffset(const double, const double, double[])
+
+
+/*  void tipOf(const double position[], double tip[])
+    > gets the tool tip of machine positions in double
+    args:
+      const double position[]: the machine position per axis, in step
+      double tip[]: gets the tip along x, y and z, in um
+    returns nothing
+*/
+void tipOf(const double position[], double tip[]){
+  double offset[3];
+  exactOffset(position[W_AXIS] / atrox.motor[W_AXIS].stepPerUnit,
+              position[P_AXIS] / atrox.motor[P_AXIS].stepPerUnit, offset);
+  for(int axis{}; axis <= Z_AXIS; axis++){
+    tip[axis] = position[axis] / atrox.motor[axis].stepPerUnit * 1000.0 + offset[axis];
+  }
+  return;
+} //end tipOf(const double[], double[])
+
+
+/*  double lineDistance(const double start[], const double end[], const double point[])
+    > gets how far a point is from the straight line between two others
+    args:
+      const double start[]: one end of the line, x, y, z
+      const double end[]: the other end
+      const double point[]: the point
+    returns the distance
+*/
+double lineDistance(const double start[], const double end[], const double point[]){
+  double along[3];
+  double from[3];
+  double lengthSqr{};
+  double dot{};
+  for(int index{}; index < 3; index++){
+    along[index] = end[index] - start[index];
+    from[index] = point[index] - start[index];
+    lengthSqr += along[index] * along[index];
+    dot += along[index] * from[index];
+  }
+  double fraction = lengthSqr > 0 ? max(0.0, min(1.0, dot / lengthSqr)) : 0;
+  double distanceSqr{};
+  for(int index{}; index < 3; index++){
+    double gap = from[index] - fraction * along[index];
+    distanceSqr += gap * gap;
+  }
+  return sqrt(distanceSqr);
+} //end lineDistance(const double[], const double[], const double[])
+
+
+/*  void benchKinematics()
+    > checks the fixed point sine and tool offset against double, and
+      times the offset on the host. then moves the tool with
+      KINEMATICS_MOVE and follows the tip step event by step event: its
+      deviation from the straight line is against the deviation the tip
+      would take if the axes went straight from end to end, as a single
+      move of the axes would. a profile without the carriage and the head
+      leaves the section empty
+    no args
+    returns nothing
+*/
+void benchKinematics(){
+  if(!isKinematic()) return; //no carriage and head in the profile
+  double sineError{};
+  for(long angle{-360000}; angle <= 360000; angle += 7){
+    sineError = max(sineError, fabs((double)fixedSin(angle) / TRIG_ONE - sin(angle * M_PI / 180000.0)));
+  }
+  double offsetError{};
+  long offset[3];
+  double exact[3];
+  for(long yaw{-180000}; yaw <= 180000; yaw += 997){
+    for(long pitch{-120000}; pitch <= 120000; pitch += 991){
+      toolOffset(yaw, pitch, offset);
+      exactOffset(yaw / 1000.0, pitch / 1000.0, exact);
+      for(int index{}; index < 3; index++) offsetError = max(offsetError, fabs(offset[index] - exact[index]));
+    }
+  }
+  long offsetCount{};
+  long checksum{};
+  auto startedAt = std::chrono::steady_clock::now();
+  for(long yaw{-180000}; yaw <= 180000; yaw += 997){
+    for(long pitch{-120000}; pitch <= 120000; pitch += 991){
+      toolOffset(yaw, pitch, offset);
+      checksum += offset[0] + offset[1] + offset[2];
+      offsetCount++;
+    }
+  }
+  double offsetNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startedAt).count()
+                    / offsetCount;
+
+  //the tool move, step events merged over the axes in time
+  long start[AXIS_COUNT];
+  double position[AXIS_COUNT];
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    start[axis] = sim.axisPosition(axis);
+    position[axis] = atrox.machinePosition((Axis)axis);
+  }
+  sim.clearRecords();
+  sim.send("G221\nG21\nG91\n");
+  sim.send(KINEMATICS_MOVE);
+  sim.send("\n");
+  sim.runUntilIdle(sim.seconds() + RUN_MAX_SEC);
+  std::vector<std::pair<uint64_t, int>> events;
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    for(const simStep& step : sim.steps(axis)) events.push_back(std::make_pair(step.cycle, step.dirn * (axis + 1)));
+  }
+  std::sort(events.begin(), events.end());
+
+  double tipStart[3];
+  double tipEnd[3];
+  double tip[3];
+  std::vector<double> jointStart(position, position + AXIS_COUNT);
+  tipOf(position, tipStart);
+  std::vector<std::vector<double>> tips;
+  for(size_t index{}; index < events.size(); index++){
+    int axis = abs(events[index].second) - 1;
+    position[axis] += events[index].second > 0 ? 1 : -1;
+    if(index + 1 < events.size() && events[index + 1].first == events[index].first) continue;
+    tipOf(position, tip);
+    tips.push_back(std::vector<double>(tip, tip + 3));
+  }
+  tipOf(position, tipEnd);
+  double pathError{};
+  for(const std::vector<double>& point : tips) pathError = max(pathError, lineDistance(tipStart, tipEnd, point.data()));
+  double lineError{};
+  for(int point{}; point <= JOINT_LINE_POINTS; point++){
+    double joint[AXIS_COUNT];
+    for(int axis{}; axis < AXIS_COUNT; axis++){
+      joint[axis] = jointStart[axis] + (position[axis] - jointStart[axis]) * point / JOINT_LINE_POINTS;
+    }
+    tipOf(joint, tip);
+    lineError = max(lineError, lineDistance(tipStart, tipEnd, tip));
+  }
+  double tipLength = sqrt((tipEnd[0] - tipStart[0]) * (tipEnd[0] - tipStart[0])
+                          + (tipEnd[1] - tipStart[1]) * (tipEnd[1] - tipStart[1])
+                          + (tipEnd[2] - tipStart[2]) * (tipEnd[2] - tipStart[2]));
+  double moveSec = events.empty() ? 0 : (double)(events.back().first - events.front().first) / F_CPU;
+  returnToStart(start);
+
+  printf("    {\"move\": \"%s\", \"tool_mm\": %.1f", KINEMATICS_MOVE, MACHINE_TOOL_LENGTH / 1000.0);
+  printNumber("sine_error", sineError, 7);
+  printNumber("offset_error_um", offsetError, 2);
+  printNumber("offset_ns", offsetNs, 1);
+  printf(", \"checksum\": %ld, \"step_events\": %ld", checksum, (long)tips.size());
+  printNumber("move_sec", moveSec, 4);
+  printNumber("tip_mm", tipLength / 1000.0, 3);
+  printNumber("step_um", 1000.0 / atrox.motor[X_AXIS].stepPerUnit, 1);
+  printNumber("tool_path_max_um", pathError, 1);
+  printNumber("axes_line_max_um", lineError, 1);
+  printf("}\n");
+  return;
+} //end benchKinematics()
+
+
+/*  double radialError(const double center[], const double radius)
+    > follows the x and y steps recorded step event by step event, and
+      gets the farthest the path strays from a circle
+    args:
+      const double center[]: the center, x and y in step from the start
+      const double radius: the radius, in step
+    returns the farthest, in um
+*/
+double radialError(const double center[], const double radius){
+  std::vector<std::pair<uint64_t, int>> events;
+  for(int axis{}; axis <= Y_AXIS; axis++){
+    for(const simStep& step : sim.steps(axis)) events.push_back(std::make_pair(step.cycle, step.dirn * (axis + 1)));
+  }
+  std::sort(events.begin(), events.end());
+  double position[2]{};
+  double error{};
+  for(size_t index{}; index < events.size(); index++){
+    int axis = abs(events[index].second) - 1;
+    position[axis] += events[index].second > 0 ? 1 : -1;
+    if(index + 1 < events.size() && events[index + 1].first == events[index].first) continue;
+    error = max(error, fabs(hypot(position[0] - center[0], position[1] - center[1]) - radius));
+  }
+  return error * 1000.0 / atrox.motor[X_AXIS].stepPerUnit;
+} //end radialError(const double[], const double)
+
+
+/*  void benchArc()
+    > moves ARC_MOVE, a full circle, as one line, then as the lines a
+      host would cut it into at the same chord tolerance, both streamed
+      one line per OK. the circle's center and radius in step are from
+      x's scale, y is taken to have the same. a profile without x and y
+      leaves the section empty
+    no args
+    returns nothing
+*/
+void benchArc(){
+  if(!isAxisUsed(X_AXIS) || !isAxisUsed(Y_AXIS)) return; //no x and y in the profile
+  long start[AXIS_COUNT];
+  for(int axis{}; axis < AXIS_COUNT; axis++) start[axis] = sim.axisPosition(axis);
+  double stepPerMm = atrox.motor[X_AXIS].stepPerUnit;
+  double center[2] = {ARC_RADIUS_MM * stepPerMm, 0};
+  double radius = ARC_RADIUS_MM * stepPerMm;
+  double tolerance = atrox.arcTolerance / 1000.0;
+
+  sim.send("G221\nG21\nG91\n");
+  sim.runUntilIdle(sim.seconds() + RUN_MAX_SEC);
+  sim.clearRecords();
+  double startAt = sim.seconds();
+  streamLines(std::vector<std::string>(1, ARC_MOVE), startAt + RUN_MAX_SEC);
+  double arcSec = sim.seconds() - startAt;
+  double arcError = radialError(center, radius);
+  size_t arcBytes = strlen(ARC_MOVE) + 1;
+  returnToStart(start);
+
+  //the same circle clockwise from the start, a point per chord, each
+  //line by the rounded point less the one before
+  double chord = 2 * sqrt(tolerance * (2 * ARC_RADIUS_MM - tolerance));
+  int segmentCount = (int)ceil(2 * M_PI * ARC_RADIUS_MM / chord);
+  std::vector<std::string> lines;
+  size_t lineBytes{};
+  long last[2]{};
+  for(int segment{1}; segment <= segmentCount; segment++){
+    double angle = M_PI - 2 * M_PI * segment / segmentCount;
+    long point[2] = {lround((ARC_RADIUS_MM + ARC_RADIUS_MM * cos(angle)) * 1000),
+                     lround(ARC_RADIUS_MM * sin(angle) * 1000)};
+    if(segment == segmentCount) point[0] = point[1] = 0;
+    char line[64];
+    snprintf(line, sizeof(line), "G200 X%.3f Y%.3f F%.0f", (point[0] - last[0]) / 1000.0,
+             (point[1] - last[1]) / 1000.0, ARC_SPEED_MM);
+    lines.push_back(line);
+    lineBytes += strlen(line) + 1;
+    last[0] = point[0];
+    last[1] = point[1];
+  }
+  sim.send("G221\nG21\nG91\n");
+  sim.runUntilIdle(sim.seconds() + RUN_MAX_SEC);
+  sim.clearRecords();
+  startAt = sim.seconds();
+  streamLines(lines, startAt + RUN_MAX_SEC);
+  double linesSec = sim.seconds() - startAt;
+  double linesError = radialError(center, radius);
+  returnToStart(start);
+
+  printf("    {\"move\": \"%s\"", ARC_MOVE);
+  printNumber("tolerance_um", atrox.arcTolerance, 0);
+  printNumber("step_um", 1000.0 / stepPerMm, 1);
+  printf(", \"arc_lines\": 1, \"arc_bytes\": %zu", arcBytes);
+  printNumber("arc_sec", arcSec, 4);
+  printNumber("arc_radial_max_um", arcError, 1);
+  printf(", \"host_lines\": %zu, \"host_bytes\": %zu", lines.size(), lineBytes);
+  printNumber("host_sec", linesSec, 4);
+  printNumber("host_radial_max_um", linesError, 1);
+  printf("}\n");
+  return;
+} //end benchArc()
+
+
+int main(int argc, char* argv[]){
+  std::vector<std::string> names;
+  std::vector<std::string> texts;
+  for(int index{1}; index < argc; index++){
+    std::string text;
+    if(!readFile(argv[index], &text)){
+      fprintf(stderr, "cannot read %s\n", argv[index]);
+      return 1;
+    }
+    const char* name = strrchr(argv[index], '/');
+    names.push_back(name != nullptr ? name + 1 : argv[index]);
+    texts.push_back(text);
+  }
+
+  sim.begin();
+  sim.runUntilIdle(RUN_MAX_SEC);
+
+  printf("{\n  \"firmware\": \"v0.001.1\",\n  \"f_cpu\": %lu,\n  \"loop_cycles\": %lu,\n",
+         (unsigned long)F_CPU, (unsigned long)sim.loopCycles);
+  printf("  \"parser\": [\n");
+  for(size_t index{}; index < texts.size(); index++){
+    benchParser(names[index].c_str(), texts[index], index + 1 == texts.size());
+  }
+  printf("  ],\n  \"replay\": [\n");
+  for(size_t index{}; index < texts.size(); index++){
+    benchReplay(names[index].c_str(), texts[index], index + 1 == texts.size());
+  }
+  printf("  ],\n  \"profile\": [\n");
+  benchProfile();
+  printf("  ],\n  \"realtime\": [\n");
+  benchRealtime();
+  printf("  ],\n  \"homing\": [\n");
+  benchHoming();
+  printf("  ],\n  \"program\": [\n");
+  for(size_t index{}; index < texts.size(); index++){
+    benchProgram(names[index].c_str(), texts[index], index + 1 == texts.size());
+  }
+  printf("  ],\n  \"jog\": [\n");
+  benchJog();
+  printf("  ],\n  \"kinematics\": [\n");
+  benchKinematics();
+  printf("  ],\n  \"arc\": [\n");
+  benchArc();
+  printf("  ]\n}\n");
+  return 0;
+} //end main(int, char*[])
@@ -0,0 +1,304 @@
+(many small degree jogs on the pitch axis, as in a targeting job)
+M17
+G221
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G291 P0.250 E200 B400
+G291 P-0.125 E200 B400
+G220
@@ -0,0 +1,48 @@
+(coordinated moves of the three rotary axes, in step)
+M17
+G220
+G200 W0 P300 R0
+G200 W257 P263 R144
+G200 W394 P162 R77
+G200 W345 P21 R-103
+G200 W133 P-124 R-132
+G200 W-140 P-240 R32
+G200 W-348 P-296 R149
+G200 W-392 P-280 R47
+G200 W-252 P-196 R-124
+G200 W6 P-63 R-114
+G200 W262 P85 R63
+G200 W395 P212 R148
+G200 W341 P288 R16
+G200 W127 P292 R-139
+G200 W-146 P226 R-90
+G200 W-351 P103 R90
+G200 W-391 P-43 R139
+G200 W-247 P-180 R-16
+G200 W13 P-273 R-148
+G200 W267 P-299 R-62
+G200 W396 P-251 R114
+G200 W338 P-142 R124
+G200 W121 P1 R-47
+G200 W-152 P144 R-149
+G200 W-355 P253 R-32
+G200 W-390 P299 R132
+G200 W-241 P272 R103
+G200 W20 P178 R-77
+G200 W272 P41 R-144
+G200 W397 P-106 R0
+G200 W334 P-227 R144
+G200 W114 P-293 R77
+G200 W-159 P-287 R-103
+G200 W-358 P-210 R-132
+G200 W-388 P-82 R32
+G200 W-236 P65 R149
+G200 W26 P198 R47
+G200 W277 P281 R-124
+G200 W397 P296 R-114
+G200 W330 P238 R63
+; long moves at the axis limits
+G291 W3000
+G291 W-3000
+G291 P2000 E800 B1500
+G291 P-2000
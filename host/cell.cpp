@@ -0,0 +1,463 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// host/cell.cpp                                                             //
+//                                                                           //
+// Description:                                                              //
+//      This runs a job on a cell of boards stepping in lockstep, see        //
+//      stream.h. The coordinator runs the g-code once on the simulation,   //
+//      as a single board would, splits the axes between the nodes and      //
+//      compiles a stream of each node's axes along the same segments, see  //
+//      host/compiler.h. Segments are not merged past 1 / SEGMENTS_PER_SEC  //
+//      sec, a follower is off by one segment's worth of its crystal only.   //
+//                                                                           //
+//      Each node is then a process of its own, forked from the simulation  //
+//      at rest, playing its stream over its own serial line. The lead      //
+//      sends the cycles of its sync ticks down a pipe to every follower,   //
+//      which takes them as changes of its sync pin, and never runs a pass  //
+//      of loop() past the lead's time. A follower's clock may be off by    //
+//      the drift given, fast and slow in turn. The lead's first frame is   //
+//      held back until the followers hold theirs, as a coordinator waiting //
+//      for their BIN_ACK would.                                            //
+//                                                                           //
+//      Every node's steps are compared with the single board run, and      //
+//      timed against the lead's segments: the skew is how far a step is   //
+//      from where the lead's clock puts it.                                //
+//                                                                           //
+//      usage: atrox_cell [-n nodes] [-d drift ppm] [-t max sec] file.gcode //
+//             2 nodes by default. the machine profile needs a sync pin,   //
+//             see MACHINE_SYNC_PIN, eg -DATROX_MACHINE=MACHINE_TWO_AXIS    //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <math.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "atrox.h"
+#include "binproto.h"
+#include "compiler.h"
+#include "sim.h"
+#include "stats.h"
+#include "stepper.h"
+#include "stream.h"
+
+//longest a segment of a cell's stream lasts, in cpu cycles
+const uint64_t CELL_SEGMENT_CYCLES = F_CPU / SEGMENTS_PER_SEC;
+//farthest a step may be from where the lead's clock puts it, in us
+const double CELL_MAX_SKEW_US = 10.0;
+//most nodes, one per axis
+const int CELL_MAX_NODES = AXIS_COUNT;
+
+/*  struct syncMessage
+    > contains what the lead sends down the pipe of a follower: a tick at
+      a cycle, or the cycle it ran up to, no tick comes before it anymore
+*/
+struct syncMessage{
+  uint64_t cycle{};
+  bool isTick{false};
+};
+
+/*  struct nodeResult
+    > contains how a node played its stream, its cycles on the lead's clock
+*/
+struct nodeResult{
+  int answer{-1};
+  uint16_t underrunCount{};
+  double seconds{};
+  std::vector<uint64_t> loads;             //segments started
+  std::vector<simStep> steps[AXIS_COUNT];  //of the node's axes
+};
+
+//the node a process plays, see runLeadPass() and runFollowerPass()
+static FILE* tickOut[CELL_MAX_NODES]{};  //the lead's, one per follower
+static int tickOutCount{};
+static size_t tickSentCount{};
+static FILE* tickIn{nullptr};            //a follower's
+static uint64_t leadCycle{};             //the lead ran up to
+static bool isLeadDone{false};
+static uint64_t clockBase{};             //cycle the nodes were forked at
+static double clockScale{1.0};           //cycles of the node per cycle of the lead
+
+
+/*  uint64_t toNodeClock(const uint64_t cycle)
+    > gets the cycle of the node's clock at a cycle of the lead's
+    args:
+      const uint64_t cycle: cycle of the lead
+    returns the cycle of the node
+*/
+uint64_t toNodeClock(const uint64_t cycle){
+  return clockBase + llround((int64_t)(cycle - clockBase) * clockScale);
+} //end toNodeClock(const uint64_t)
+
+
+/*  uint64_t toLeadClock(const uint64_t cycle)
+    > gets the cycle of the lead's clock at a cycle of the node's
+    args:
+      const uint64_t cycle: cycle of the node
+    returns the cycle of the lead
+*/
+uint64_t toLeadClock(const uint64_t cycle){
+  return clockBase + llround((int64_t)(cycle - clockBase) / clockScale);
+} //end toLeadClock(const uint64_t)
+
+
+/*  void runLeadPass()
+    > runs a pass of loop() of the lead, then sends the ticks it made and
+      the cycle it ran up to down the pipe of every follower
+    no args
+    returns nothing
+*/
+void runLeadPass(){
+  sim.runLoop();
+  const std::vector<uint64_t>& ticks = sim.syncTicks();
+  for(int node{}; node < tickOutCount; node++){
+    for(size_t index{tickSentCount}; index < ticks.size(); index++){
+      syncMessage message;
+      message.cycle = ticks[index];
+      message.isTick = true;
+      fwrite(&message, sizeof(message), 1, tickOut[node]);
+    }
+    syncMessage message;
+    message.cycle = sim.cycles();
+    fwrite(&message, sizeof(message), 1, tickOut[node]);
+  }
+  tickSentCount = ticks.size();
+  return;
+} //end runLeadPass()
+
+
+/*  void runFollowerPass()
+    > runs a pass of loop() of a follower, once the lead has run past its
+      end and every tick before it is queued on the sync pin
+    no args
+    returns nothing
+*/
+void runFollowerPass(){
+  uint64_t until = sim.cycles() + sim.loopCycles;
+  while(!isLeadDone && toNodeClock(leadCycle) < until){
+    syncMessage message;
+    if(fread(&message, sizeof(message), 1, tickIn) != 1){
+      isLeadDone = true;
+    }else if(message.isTick){
+      sim.receiveSyncTick(toNodeClock(message.cycle));
+    }else{
+      leadCycle = message.cycle;
+    }
+  }
+  sim.runLoop();
+  return;
+} //end runFollowerPass()
+
+
+/*  template<typename T> void writeRecords(FILE* file, const std::vector<T>& records)
+    > writes records of plain data, their count first
+    args:
+      FILE* file: where they go
+      const std::vector<T>& records: the records
+    returns nothing
+*/
+template<typename T> void writeRecords(FILE* file, const std::vector<T>& records){
+  uint64_t count = records.size();
+  fwrite(&count, sizeof(count), 1, file);
+  if(count > 0) fwrite(records.data(), sizeof(T), count, file);
+  return;
+} //end writeRecords(FILE*, const std::vector<T>&)
+
+
+/*  template<typename T> bool readRecords(FILE* file, std::vector<T>* records)
+    > reads records written by writeRecords()
+    args:
+      FILE* file: where they come from
+      std::vector<T>* records: where they go
+    returns true if read
+*/
+template<typename T> bool readRecords(FILE* file, std::vector<T>* records){
+  uint64_t count{};
+  if(fread(&count, sizeof(count), 1, file) != 1) return false;
+  records->resize(count);
+  return count == 0 || fread(records->data(), sizeof(T), count, file) == count;
+} //end readRecords(FILE*, std::vector<T>*)
+
+
+/*  void runNode(const int node, const std::vector<uint8_t>& frames, const double holdSec,
+                 const double maxSeconds, FILE* resultOut)
+    > plays the stream of a node in its forked process, and writes how it
+      went. the lead closes the pipes of its followers once done, a
+      follower reads its pipe to the end so the lead is never held up
+    args:
+      const int node: the node, 0 for the lead
+      const std::vector<uint8_t>& frames: the node's stream
+      const double holdSec: time the lead's first frame is held back
+      const double maxSeconds: simulated time the stream may take
+      FILE* resultOut: where the result goes
+    returns nothing
+*/
+void runNode(const int node, const std::vector<uint8_t>& frames, const double holdSec,
+             const double maxSeconds, FILE* resultOut){
+  sim.clearRecords();
+  stats.clear();
+  double start = sim.seconds();
+  nodeResult result;
+  if(node == 0){
+    result.answer = playStream(frames, "M721 S1\n", start + holdSec, start + maxSeconds, runLeadPass);
+    for(int index{}; index < tickOutCount; index++) fclose(tickOut[index]);
+  }else{
+    result.answer = playStream(frames, "M721 S2\n", 0, start + maxSeconds, runFollowerPass);
+    syncMessage message;
+    while(fread(&message, sizeof(message), 1, tickIn) == 1);
+  }
+  result.underrunCount = stats.underrunCount;
+  result.seconds = sim.seconds() - start;
+
+  for(const simSegment& segment : sim.segments()){
+    if(segment.stepCount > 0) result.loads.push_back(toLeadClock(segment.cycle));
+  }
+  fwrite(&result.answer, sizeof(result.answer), 1, resultOut);
+  fwrite(&result.underrunCount, sizeof(result.underrunCount), 1, resultOut);
+  fwrite(&result.seconds, sizeof(result.seconds), 1, resultOut);
+  writeRecords(resultOut, result.loads);
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    std::vector<simStep> steps = sim.steps(axis);
+    for(simStep& step : steps) step.cycle = toLeadClock(step.cycle);
+    writeRecords(resultOut, steps);
+  }
+  fclose(resultOut);
+  return;
+} //end runNode(const int, const std::vector<uint8_t>&, const double, const double, FILE*)
+
+
+/*  bool readResult(FILE* file, nodeResult* result)
+    > reads the result of a node, as runNode() wrote it
+    args:
+      FILE* file: the node's result pipe
+      nodeResult* result: where it goes
+    returns true if read in full
+*/
+bool readResult(FILE* file, nodeResult* result){
+  bool isRead = fread(&result->answer, sizeof(result->answer), 1, file) == 1
+                && fread(&result->underrunCount, sizeof(result->underrunCount), 1, file) == 1
+                && fread(&result->seconds, sizeof(result->seconds), 1, file) == 1
+                && readRecords(file, &result->loads);
+  for(int axis{}; axis < AXIS_COUNT; axis++) isRead = isRead && readRecords(file, &result->steps[axis]);
+  return isRead;
+} //end readResult(FILE*, nodeResult*)
+
+
+/*  bool measureSkew(const std::vector<simStep>& live, const std::vector<uint64_t>& liveLoads,
+                     const std::vector<simStep>& played, const std::vector<uint64_t>& leadLoads,
+                     long* minSkew, long* maxSkew)
+    > times the steps of an axis against the lead's segments: a step
+      should come as long after the lead started its segment as it came
+      after the segment started in the single board run
+    args:
+      const std::vector<simStep>& live: the steps of the single board run
+      const std::vector<uint64_t>& liveLoads: the cycles its segments started at
+      const std::vector<simStep>& played: the steps of the node, on the lead's clock
+      const std::vector<uint64_t>& leadLoads: the cycles the lead started the segments at
+      long* minSkew: where the earliest a step came goes, in cpu cycles
+      long* maxSkew: where the latest a step came goes, in cpu cycles
+    returns true if the steps are the same, in number and direction
+*/
+bool measureSkew(const std::vector<simStep>& live, const std::vector<uint64_t>& liveLoads,
+                 const std::vector<simStep>& played, const std::vector<uint64_t>& leadLoads,
+                 long* minSkew, long* maxSkew){
+  *minSkew = 0;
+  *maxSkew = 0;
+  if(live.size() != played.size()) return false;
+  size_t segment{};
+  for(size_t index{}; index < live.size(); index++){
+    if(live[index].dirn != played[index].dirn) return false;
+    while(segment + 1 < liveLoads.size() && liveLoads[segment + 1] <= live[index].cycle) segment++;
+    if(segment >= leadLoads.size()) return false;
+    long skew = (long)(played[index].cycle - leadLoads[segment]) - (long)(live[index].cycle - liveLoads[segment]);
+    *minSkew = index == 0 ? skew : std::min(*minSkew, skew);
+    *maxSkew = index == 0 ? skew : std::max(*maxSkew, skew);
+  }
+  return true;
+} //end measureSkew(const std::vector<simStep>&, const std::vector<uint64_t>&, const std::vector<simStep>&,
+  //                const std::vector<uint64_t>&, long*, long*)
+
+
+int main(int argc, char* argv[]){
+  const char* gcodePath{nullptr};
+  int nodeCount{2};
+  double driftPpm{};
+  double maxSeconds{3600.0};
+  for(int index{1}; index < argc; index++){
+    if(strcmp(argv[index], "-n") == 0 && index + 1 < argc){
+      nodeCount = atoi(argv[++index]);
+    }else if(strcmp(argv[index], "-d") == 0 && index + 1 < argc){
+      driftPpm = atof(argv[++index]);
+    }else if(strcmp(argv[index], "-t") == 0 && index + 1 < argc){
+      maxSeconds = atof(argv[++index]);
+    }else if(argv[index][0] == '-' || gcodePath != nullptr){
+      fprintf(stderr, "usage: %s [-n nodes] [-d drift ppm] [-t max sec] file.gcode\n", argv[0]);
+      return 2;
+    }else{
+      gcodePath = argv[index];
+    }
+  }
+  if(!isSyncWired()){
+    fprintf(stderr, "the machine profile has no sync pin, see MACHINE_SYNC_PIN\n");
+    return 1;
+  }
+  std::string gcode;
+  if(gcodePath == nullptr || !readFile(gcodePath, &gcode)){
+    fprintf(stderr, "cannot read %s\n", gcodePath != nullptr ? gcodePath : "g-code");
+    return gcodePath == nullptr ? 2 : 1;
+  }
+  if(!gcode.empty() && gcode[gcode.size() - 1] != '\n') gcode += '\n';
+
+  //the axes split in runs between the nodes, the lead takes the first
+  std::vector<int> axes;
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(isAxisUsed(axis)) axes.push_back(axis);
+  }
+  nodeCount = std::max(1, std::min(nodeCount, (int)axes.size()));
+  uint8_t nodeAxes[CELL_MAX_NODES]{};
+  for(size_t index{}; index < axes.size(); index++) nodeAxes[index * nodeCount / axes.size()] |= 1 << axes[index];
+
+  //single board run, through the parser and the planner
+  liveRun live;
+  int liveStatus = runLive(gcode, maxSeconds, &live);
+  if(liveStatus == 3){
+    fprintf(stderr, "time limit reached\n");
+    return 3;
+  }
+  if(liveStatus == 1){
+    fprintf(stderr, "not compiled, the g-code was refused, homes or jogs:\n%s", live.answers.c_str());
+    return 1;
+  }
+  std::vector<simSegment> liveSegments = mergeSegments(live.segments, CELL_SEGMENT_CYCLES);
+  std::vector<uint64_t> liveLoads;
+  for(const simSegment& segment : liveSegments){
+    if(segment.stepCount > 0) liveLoads.push_back(segment.cycle);
+  }
+
+  //a stream per node
+  std::vector<uint8_t> frames[CELL_MAX_NODES];
+  streamCount counts[CELL_MAX_NODES];
+  for(int node{}; node < nodeCount; node++){
+    std::vector<std::vector<uint8_t>> records;
+    if(!encodeStream(liveSegments, nodeAxes[node], &records, &counts[node])){
+      fprintf(stderr, "not compiled, a segment has no step block or an unknown prescaler\n");
+      return 1;
+    }
+    frames[node] = frameStream(records, nodeAxes[node], &counts[node]);
+  }
+
+  //the nodes, forked at rest
+  signal(SIGPIPE, SIG_IGN); //a node that dies ends its pipes
+  int tickPipes[CELL_MAX_NODES][2]{};
+  int resultPipes[CELL_MAX_NODES][2]{};
+  for(int node{}; node < nodeCount; node++){
+    if((node > 0 && pipe(tickPipes[node]) != 0) || pipe(resultPipes[node]) != 0){
+      perror("pipe");
+      return 1;
+    }
+  }
+  double holdSec = 2 * (BINARY_FRAME_SIZE + 4) * 10.0 / 9600 + 2 * HOST_LATENCY_SEC;
+  clockBase = sim.cycles();
+  fflush(stdout);
+  fflush(stderr);
+  pid_t pids[CELL_MAX_NODES]{};
+  for(int node{}; node < nodeCount; node++){
+    pids[node] = fork();
+    if(pids[node] < 0){
+      perror("fork");
+      return 1;
+    }
+    if(pids[node] > 0) continue;
+
+    //the node's process keeps its own ends of the pipes only
+    for(int other{}; other < nodeCount; other++){
+      if(other > 0){
+        if(node != 0) close(tickPipes[other][1]);
+        if(other != node) close(tickPipes[other][0]);
+      }
+      close(resultPipes[other][0]);
+      if(other != node) close(resultPipes[other][1]);
+    }
+    if(node == 0){
+      for(int other{1}; other < nodeCount; other++){
+        tickOut[tickOutCount] = fdopen(tickPipes[other][1], "wb");
+        setvbuf(tickOut[tickOutCount], nullptr, _IOFBF, 1 << 16);
+        tickOutCount++;
+      }
+    }else{
+      tickIn = fdopen(tickPipes[node][0], "rb");
+      leadCycle = clockBase;
+      clockScale = 1.0 + (node % 2 == 1 ? driftPpm : -driftPpm) * 1e-6;
+    }
+    runNode(node, frames[node], holdSec, maxSeconds, fdopen(resultPipes[node][1], "wb"));
+    _exit(0);
+  }
+  for(int node{}; node < nodeCount; node++){
+    if(node > 0){
+      close(tickPipes[node][0]);
+      close(tickPipes[node][1]);
+    }
+    close(resultPipes[node][1]);
+  }
+  nodeResult results[CELL_MAX_NODES];
+  bool isSame{true};
+  for(int node{}; node < nodeCount; node++){
+    FILE* file = fdopen(resultPipes[node][0], "rb");
+    if(!readResult(file, &results[node])){
+      fprintf(stderr, "node %d ended without a result\n", node);
+      isSame = false;
+    }
+    fclose(file);
+  }
+  for(int node{}; node < nodeCount; node++) waitpid(pids[node], nullptr, 0);
+
+  fprintf(stderr, "live: %.6f sec, %.6f sec stepping, %zu segments of %.1f ms at most, %zu g-code bytes\n",
+          live.seconds, live.moveSeconds, liveLoads.size(), 1000.0 * CELL_SEGMENT_CYCLES / F_CPU, gcode.size());
+  for(int node{}; node < nodeCount; node++){
+    const nodeResult& result = results[node];
+    std::string letters;
+    for(int axis{}; axis < AXIS_COUNT; axis++){
+      if(nodeAxes[node] & (1 << axis)) letters += AXIS_LETTER[axis];
+    }
+    fprintf(stderr, "node %d, %s of axes %s: %zu stream bytes, %.0f byte/s while stepping\n", node,
+            node == 0 ? "lead" : "follower", letters.c_str(), counts[node].bytes,
+            live.moveSeconds > 0 ? counts[node].bytes / live.moveSeconds : 0.0);
+    fprintf(stderr, "  played: %.6f sec, clock off by %+.0f ppm, answered %s, %u underruns, %zu segments\n",
+            result.seconds, node == 0 ? 0.0 : (node % 2 == 1 ? driftPpm : -driftPpm),
+            result.answer == BIN_ACK ? "BIN_ACK" : (result.answer == BIN_CAN ? "BIN_CAN" : "nothing"),
+            result.underrunCount, result.loads.size());
+    if(result.answer != BIN_ACK || result.loads.size() != liveLoads.size()) isSame = false;
+
+    for(int axis{}; axis < AXIS_COUNT; axis++){
+      if(!(nodeAxes[node] & (1 << axis))) continue;
+      long minSkew{};
+      long maxSkew{};
+      if(!measureSkew(live.steps[axis], liveLoads, result.steps[axis], results[0].loads, &minSkew, &maxSkew)){
+        fprintf(stderr, "  axis %c: steps differ, %zu played of %zu\n", AXIS_LETTER[axis],
+                result.steps[axis].size(), live.steps[axis].size());
+        isSame = false;
+        continue;
+      }
+      double minUs = 1e6 * minSkew / F_CPU;
+      double maxUs = 1e6 * maxSkew / F_CPU;
+      fprintf(stderr, "  axis %c: %zu steps the same, skew %+.2f to %+.2f us\n", AXIS_LETTER[axis],
+              live.steps[axis].size(), minUs, maxUs);
+      if(fabs(minUs) > CELL_MAX_SKEW_US || fabs(maxUs) > CELL_MAX_SKEW_US) isSame = false;
+    }
+  }
+  return isSame ? 0 : 4;
+} //end main(int, char*[])
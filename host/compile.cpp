@@ -0,0 +1,141 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// host/compile.cpp                                                          //
+//                                                                           //
+// Description:                                                              //
+//      This compiles g-code into a step stream, see stream.h. The g-code    //
+//      runs through the firmware on the host simulation as it would on the  //
+//      machine, and every segment the step isr loads is taken down with     //
+//      its step block and timing, see host/compiler.h.                      //
+//                                                                           //
+//      The stream is then verified: it is played in stream mode, frame by   //
+//      frame against BIN_ACK as a host would, and what the isr steps is     //
+//      compared with the live run, segment by segment and step by step      //
+//      with the time the step timer ran for. The underruns of both runs     //
+//      are given, a stream the serial line cannot keep up with underruns.   //
+//                                                                           //
+//      usage: atrox_compile [-o file.stream] [-t max sec] file.gcode        //
+//             without -o the stream is only verified. the g-code may not    //
+//             home nor jog, their steps depend on the switches and sticks   //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "binproto.h"
+#include "compiler.h"
+#include "sim.h"
+#include "stats.h"
+#include "stream.h"
+
+
+int main(int argc, char* argv[]){
+  const char* gcodePath{nullptr};
+  const char* streamPath{nullptr};
+  double maxSeconds{3600.0};
+  for(int index{1}; index < argc; index++){
+    if(strcmp(argv[index], "-o") == 0 && index + 1 < argc){
+      streamPath = argv[++index];
+    }else if(strcmp(argv[index], "-t") == 0 && index + 1 < argc){
+      maxSeconds = atof(argv[++index]);
+    }else if(argv[index][0] == '-' || gcodePath != nullptr){
+      fprintf(stderr, "usage: %s [-o file.stream] [-t max sec] file.gcode\n", argv[0]);
+      return 2;
+    }else{
+      gcodePath = argv[index];
+    }
+  }
+  std::string gcode;
+  if(gcodePath == nullptr || !readFile(gcodePath, &gcode)){
+    fprintf(stderr, "cannot read %s\n", gcodePath != nullptr ? gcodePath : "g-code");
+    return gcodePath == nullptr ? 2 : 1;
+  }
+  if(!gcode.empty() && gcode[gcode.size() - 1] != '\n') gcode += '\n';
+
+  //live run, through the parser and the planner
+  liveRun live;
+  int liveStatus = runLive(gcode, maxSeconds, &live);
+  if(liveStatus == 3){
+    fprintf(stderr, "time limit reached\n");
+    return 3;
+  }
+  if(liveStatus == 1){
+    fprintf(stderr, "not compiled, the g-code was refused, homes or jogs:\n%s", live.answers.c_str());
+    return 1;
+  }
+  std::vector<simSegment> liveSegments = mergeSegments(live.segments, UINT64_MAX);
+
+  //compiled
+  streamCount count;
+  std::vector<std::vector<uint8_t>> records;
+  if(!encodeStream(liveSegments, streamAxisBits(), &records, &count)){
+    fprintf(stderr, "not compiled, a segment has no step block or an unknown prescaler\n");
+    return 1;
+  }
+  std::vector<uint8_t> frames = frameStream(records, streamAxisBits(), &count);
+  if(streamPath != nullptr){
+    FILE* file = fopen(streamPath, "wb");
+    if(file == nullptr || fwrite(frames.data(), 1, frames.size(), file) != frames.size()){
+      fprintf(stderr, "cannot write %s\n", streamPath);
+      return 1;
+    }
+    fclose(file);
+  }
+
+  //played in stream mode
+  sim.clearRecords();
+  stats.clear();
+  uint64_t playedBase = sim.timerCycles();
+  double start = sim.seconds();
+  int answer = playStream(frames, "M721\n", 0, start + maxSeconds, runSimLoop);
+  double playedSec = sim.seconds() - start;
+  uint16_t playedUnderruns = stats.underrunCount;
+  std::vector<simSegment> playedSegments = mergeSegments(sim.segments(), UINT64_MAX);
+
+  fprintf(stderr, "live: %.6f sec, %.6f sec stepping, %zu segments merged, %zu g-code bytes\n",
+          live.seconds, live.moveSeconds, liveSegments.size(), gcode.size());
+  fprintf(stderr, "stream: %zu bytes in %zu frames, %ld blocks, %ld rates, %ld ramps, %ld segments, %ld rests\n",
+          count.bytes, count.frames, count.blocks, count.rates, count.ramps, count.segments, count.rests);
+  fprintf(stderr, "stream: %.0f byte/s while stepping, the line carries %.0f\n",
+          live.moveSeconds > 0 ? count.bytes / live.moveSeconds : 0.0, 9600.0 / 10);
+  fprintf(stderr, "played: %.6f sec, answered %s\n", playedSec,
+          answer == BIN_ACK ? "BIN_ACK" : (answer == BIN_CAN ? "BIN_CAN" : "nothing"));
+  fprintf(stderr, "underruns: live %u, played %u\n", live.underrunCount, playedUnderruns);
+
+  bool isSame = answer == BIN_ACK;
+  long segmentIndex = compareSegments(liveSegments, playedSegments);
+  if(segmentIndex < 0){
+    fprintf(stderr, "segments: %zu the same\n", liveSegments.size());
+  }else{
+    fprintf(stderr, "segments: differ from %ld of %zu, %zu played\n", segmentIndex, liveSegments.size(),
+            playedSegments.size());
+    isSame = false;
+  }
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(!isAxisUsed(axis)) continue;
+    long stepIndex = compareSteps(live.steps[axis], live.timerBase, sim.steps(axis), playedBase);
+    long liveMove{};
+    for(const simStep& step : live.steps[axis]) liveMove += step.dirn;
+    if(stepIndex < 0){
+      fprintf(stderr, "axis %c: %zu steps the same, moved %ld\n", AXIS_LETTER[axis], live.steps[axis].size(),
+              liveMove);
+    }else{
+      fprintf(stderr, "axis %c: steps differ from %ld of %zu, %zu played, moved %ld against %ld\n",
+              AXIS_LETTER[axis], stepIndex, live.steps[axis].size(), sim.steps(axis).size(), sim.position(axis),
+              liveMove);
+      isSame = false;
+    }
+  }
+  return isSame ? 0 : 4;
+} //end main(int, char*[])
@@ -0,0 +1,431 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// host/compiler.cpp                                                         //
+//                                                                           //
+// Description:                                                              //
+//      This is the implementation file for the step stream compiler. The    //
+//      g-code runs through the firmware on the host simulation as it would  //
+//      on the machine, and every segment the step isr loads is taken down   //
+//      with its step block and timing. Segments of a block at the same     //
+//      rate are merged, and the stream is kept as the binary frames to      //
+//      send.                                                                //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "compiler.h"
+#include "crc.h"
+#include "sim.h"
+#include "sketch.h"
+#include "stats.h"
+#include "stream.h"
+#include "uart.h"
+
+
+/*  bool readFile(const char* path, std::string* text)
+    > reads a whole file
+    args:
+      const char* path: the file
+      std::string* text: where the text goes
+    returns true if read
+*/
+bool readFile(const char* path, std::string* text){
+  FILE* file = fopen(path, "rb");
+  if(file == nullptr) return false;
+  char buffer[4096];
+  size_t count{};
+  while((count = fread(buffer, 1, sizeof(buffer), file)) > 0) text->append(buffer, count);
+  bool isRead = !ferror(file);
+  fclose(file);
+  return isRead;
+} //end readFile(const char*, std::string*)
+
+
+/*  std::string answers()
+    > gets what the firmware sent without the xon and xoff bytes, which
+      are sent ahead of the rest and may fall inside an answer
+    no args
+    returns the text sent
+*/
+std::string answers(){
+  std::string text;
+  for(char letter : sim.output()){
+    if(letter != XON_CHAR && letter != XOFF_CHAR) text += letter;
+  }
+  return text;
+} //end answers()
+
+
+/*  bool isSameRate(const simSegment& first, const simSegment& second)
+    > checks whether two segments step at the same rate
+    args:
+      const simSegment& first: a segment
+      const simSegment& second: another segment
+    returns true if their clock select bits and ticks are the same
+*/
+bool isSameRate(const simSegment& first, const simSegment& second){
+  return first.clockSelect == second.clockSelect && first.ticks == second.ticks;
+} //end isSameRate(const simSegment&, const simSegment&)
+
+
+/*  int runLive(const std::string& gcode, const double maxSeconds, liveRun* live)
+    > runs g-code through the parser and the planner from setup(), and
+      keeps what the isr loaded and stepped. the simulation is left at
+      rest for a stream to be played next
+    args:
+      const std::string& gcode: the g-code, lines ending with a line end
+      const double maxSeconds: simulated time the g-code may take
+      liveRun* live: where the run is kept
+    returns int of run status
+      status 1 indicates the g-code was refused, homes or jogs, see live->answers
+      status 3 indicates the time ran out
+      status 8 indicates the run is kept
+*/
+int runLive(const std::string& gcode, const double maxSeconds, liveRun* live){
+  sim.begin();
+  sim.runUntilIdle(maxSeconds);
+  sim.clearRecords();
+  stats.clear();
+  live->timerBase = sim.timerCycles();
+  double start = sim.seconds();
+  sim.send(gcode.c_str());
+  if(!sim.runUntilIdle(start + maxSeconds)) return 3;
+  live->seconds = sim.seconds() - start;
+  live->moveSeconds = (double)(sim.timerCycles() - live->timerBase) / F_CPU;
+  live->answers = answers();
+  if(live->answers.find("ERR") != std::string::npos || live->answers.find("HOM") != std::string::npos
+     || live->answers.find("JOG") != std::string::npos || live->answers.find("REFUSED") != std::string::npos){
+    return 1;
+  }
+  live->underrunCount = stats.underrunCount;
+  live->segments = sim.segments();
+  for(int axis{}; axis < AXIS_COUNT; axis++) live->steps[axis] = sim.steps(axis);
+  return 8;
+} //end runLive(const std::string&, const double, liveRun*)
+
+
+/*  uint64_t segmentCycles(const simSegment& segment)
+    > gets the time a segment lasts, from its first step event to the
+      interrupt after its last one
+    args:
+      const simSegment& segment: the segment
+    returns the time in cpu cycles
+*/
+uint64_t segmentCycles(const simSegment& segment){
+  uint64_t divider = segment.clockSelect == TIMER_CLK_DIV256 ? 256 : (segment.clockSelect == TIMER_CLK_DIV64 ? 64 : 8);
+  return (uint64_t)segment.stepCount * (segment.ticks + 1) * divider;
+} //end segmentCycles(const simSegment&)
+
+
+/*  std::vector<simSegment> mergeSegments(const std::vector<simSegment>& segments, const uint64_t maxCycles)
+    > merges the segments that go on with the block of the one before, at
+      its rate, up to STREAM_MAX_EVENTS step events and maxCycles. the isr
+      steps them the same, it sets the same timer again between them
+    args:
+      const std::vector<simSegment>& segments: the segments as the isr loaded them
+      const uint64_t maxCycles: longest a merged segment may last, in cpu cycles
+    returns the segments merged
+*/
+std::vector<simSegment> mergeSegments(const std::vector<simSegment>& segments, const uint64_t maxCycles){
+  std::vector<simSegment> merged;
+  for(const simSegment& segment : segments){
+    if(!merged.empty()){
+      simSegment& last = merged.back();
+      if(segment.stepCount > 0 && last.stepCount > 0 && !segment.isNewBlock && isSameRate(segment, last)
+         && last.stepCount + segment.stepCount <= STREAM_MAX_EVENTS
+         && segmentCycles(last) + segmentCycles(segment) <= maxCycles){
+        last.stepCount += segment.stepCount;
+        continue;
+      }
+    }
+    merged.push_back(segment);
+  }
+  return merged;
+} //end mergeSegments(const std::vector<simSegment>&, const uint64_t)
+
+
+/*  void putVarint(std::vector<uint8_t>* record, uint32_t value)
+    > appends a varint to a record, see stream.h
+    args:
+      std::vector<uint8_t>* record: the record
+      uint32_t value: the number
+    returns nothing
+*/
+void putVarint(std::vector<uint8_t>* record, uint32_t value){
+  while(value >= 0x80){
+    record->push_back((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  record->push_back(value);
+  return;
+} //end putVarint(std::vector<uint8_t>*, uint32_t)
+
+
+/*  int prescalerCode(const uint8_t clockSelect)
+    > gets the prescaler of STREAM_RATE of timer clock select bits
+    args:
+      const uint8_t clockSelect: the clock select bits
+    returns the prescaler, -1 if there is none
+*/
+int prescalerCode(const uint8_t clockSelect){
+  for(int code{}; code < STREAM_PRESCALER_COUNT; code++){
+    if(STREAM_PRESCALERS[code] == clockSelect) return code;
+  }
+  return -1;
+} //end prescalerCode(const uint8_t)
+
+
+/*  bool encodeStream(const std::vector<simSegment>& segments, const uint8_t axisBits,
+                      std::vector<std::vector<uint8_t>>* records, streamCount* count)
+    > turns merged segments into the records of a stream, see stream.h
+      a segment takes the shortest record that gives its rate: a ramp,
+      the last rate or a new one. a time the isr ran dry is a rest, as
+      long as the isr stayed stopped
+      the blocks carry the steps of the axes given only, a block whose
+      dominant axis is left out carries its step events
+    args:
+      const std::vector<simSegment>& segments: the segments, merged
+      const uint8_t axisBits: the axes of the stream, streamAxisBits() for all
+      std::vector<std::vector<uint8_t>>* records: where the records go
+      streamCount* count: where the records are counted
+    returns true if encoded, false on a segment the stream cannot hold
+*/
+bool encodeStream(const std::vector<simSegment>& segments, const uint8_t axisBits,
+                  std::vector<std::vector<uint8_t>>* records, streamCount* count){
+  //as the player keeps them
+  uint8_t clockSelect{};
+  uint16_t ticks{};
+  long tickChange{};
+  uint16_t stepCount{};
+  for(size_t index{}; index < segments.size(); index++){
+    const simSegment& segment = segments[index];
+    std::vector<uint8_t> record;
+    if(segment.stepCount == 0){
+      uint64_t restCycles = index + 1 < segments.size() ? segments[index + 1].cycle - segment.cycle : 0;
+      record.push_back(STREAM_REST);
+      putVarint(&record, (restCycles + F_CPU / 2000) / (F_CPU / 1000));
+      records->push_back(record);
+      count->rests++;
+      continue;
+    }
+
+    if(segment.isNewBlock){
+      unsigned long eventCount{1};
+      unsigned long streamEventCount{1};
+      for(int axis{}; axis < AXIS_COUNT; axis++){
+        eventCount = std::max(eventCount, segment.steps[axis]);
+        if(axisBits & (1 << axis)) streamEventCount = std::max(streamEventCount, segment.steps[axis]);
+      }
+      record.push_back(streamEventCount == eventCount ? STREAM_BLOCK : STREAM_EVENT_BLOCK);
+      record.push_back(segment.dirnBits & axisBits);
+      if(streamEventCount != eventCount) putVarint(&record, eventCount);
+      for(int axis{}; axis < AXIS_COUNT; axis++){
+        if(axisBits & (1 << axis)) putVarint(&record, segment.steps[axis]);
+      }
+      records->push_back(record);
+      count->blocks++;
+      record.clear();
+    }else if(clockSelect == 0){
+      return false; //no block to step
+    }
+
+    long change = (long)segment.ticks - ticks;
+    long residual = change - tickChange;
+    if(segment.clockSelect == clockSelect && segment.stepCount == stepCount && residual >= -32 && residual < 32){
+      record.push_back(STREAM_RAMP + (residual < 0 ? -residual * 2 - 1 : residual * 2));
+      count->ramps++;
+    }else if(segment.clockSelect == clockSelect && change == 0){
+      if(segment.stepCount < 0x80){
+        record.push_back(STREAM_SEGMENT + segment.stepCount);
+      }else{
+        record.push_back(STREAM_SEGMENT);
+        putVarint(&record, segment.stepCount);
+      }
+      count->segments++;
+    }else{
+      int code = prescalerCode(segment.clockSelect);
+      if(code < 0) return false;
+      record.push_back(STREAM_RATE + code);
+      putVarint(&record, change < 0 ? (uint32_t)(-change) * 2 - 1 : (uint32_t)change * 2);
+      putVarint(&record, segment.stepCount);
+      count->rates++;
+    }
+    clockSelect = segment.clockSelect;
+    ticks = segment.ticks;
+    tickChange = change;
+    stepCount = segment.stepCount;
+    records->push_back(record);
+  }
+  return true;
+} //end encodeStream(const std::vector<simSegment>&, const uint8_t, std::vector<std::vector<uint8_t>>*, streamCount*)
+
+
+/*  void putFrame(std::vector<uint8_t>* frames, const std::vector<uint8_t>& payload)
+    > appends a binary frame of a payload, see binproto.h
+    args:
+      std::vector<uint8_t>* frames: the frames
+      const std::vector<uint8_t>& payload: the payload, BINARY_FRAME_SIZE bytes at most
+    returns nothing
+*/
+void putFrame(std::vector<uint8_t>* frames, const std::vector<uint8_t>& payload){
+  uint16_t crc = crc16Update(CRC16_INIT, payload.size());
+  for(uint8_t data : payload) crc = crc16Update(crc, data);
+  frames->push_back(BIN_SYNC);
+  frames->push_back(payload.size());
+  frames->insert(frames->end(), payload.begin(), payload.end());
+  frames->push_back(crc & 0xFF);
+  frames->push_back(crc >> 8);
+  return;
+} //end putFrame(std::vector<uint8_t>*, const std::vector<uint8_t>&)
+
+
+/*  std::vector<uint8_t> frameStream(const std::vector<std::vector<uint8_t>>& records, const uint8_t axisBits,
+                                     streamCount* count)
+    > packs the header and the records into frames, as many whole records
+      to a frame as fit, and ends them with the empty frame
+    args:
+      const std::vector<std::vector<uint8_t>>& records: the records
+      const uint8_t axisBits: the axes of the stream, as encoded
+      streamCount* count: where the frames and bytes are counted
+    returns the frames
+*/
+std::vector<uint8_t> frameStream(const std::vector<std::vector<uint8_t>>& records, const uint8_t axisBits,
+                                 streamCount* count){
+  std::vector<uint8_t> frames;
+  std::vector<uint8_t> payload{(uint8_t)(STREAM_MAGIC & 0xFF), (uint8_t)(STREAM_MAGIC >> 8), STREAM_VERSION,
+                               axisBits, (uint8_t)(F_CPU / 1000000UL)};
+  for(const std::vector<uint8_t>& record : records){
+    if(payload.size() + record.size() > (size_t)BINARY_FRAME_SIZE){
+      putFrame(&frames, payload);
+      count->frames++;
+      payload.clear();
+    }
+    payload.insert(payload.end(), record.begin(), record.end());
+  }
+  if(!payload.empty()){
+    putFrame(&frames, payload);
+    count->frames++;
+  }
+  putFrame(&frames, std::vector<uint8_t>());
+  count->frames++;
+  count->bytes = frames.size();
+  return frames;
+} //end frameStream(const std::vector<std::vector<uint8_t>>&, const uint8_t, streamCount*)
+
+
+/*  void runSimLoop()
+    > runs one pass of loop() of the simulation, the pass of a board alone
+    no args
+    returns nothing
+*/
+void runSimLoop(){
+  sim.runLoop();
+  return;
+} //end runSimLoop()
+
+
+/*  int playStream(const std::vector<uint8_t>& frames, const char* command, const double holdUntil,
+                   const double maxSeconds, void (*runPass)())
+    > sends the command entering stream mode, then the frames one by one,
+      each once the one before was answered and HOST_LATENCY_SEC passed,
+      and runs until the axes rest
+    args:
+      const std::vector<uint8_t>& frames: the frames, the empty frame last
+      const char* command: M721 and its line end, with S for a cell
+      const double holdUntil: simulated time the first frame is held back until
+      const double maxSeconds: simulated time to give up at
+      void (*runPass)(): runs a pass of loop(), runSimLoop() or one that
+                         keeps the sync line of a cell
+    returns the answer to the empty frame, BIN_ACK if the stream was
+      played, -1 if the command or a frame was not answered in time
+*/
+int playStream(const std::vector<uint8_t>& frames, const char* command, const double holdUntil,
+               const double maxSeconds, void (*runPass)()){
+  sim.send(command);
+  while(answers().find("OK") == std::string::npos){
+    if(answers().find("REFUSED") != std::string::npos || sim.seconds() > maxSeconds) return -1;
+    runPass();
+  }
+  while(sim.seconds() < holdUntil) runPass();
+
+  int answer{-1};
+  size_t start{};
+  while(start < frames.size()){
+    size_t size = frames[start + 1] + 4;
+    do{
+      size_t sentCount = sim.output().size();
+      sim.send(&frames[start], size);
+      answer = -1;
+      while(answer == -1){
+        if(sim.seconds() > maxSeconds) return -1;
+        runPass();
+        for(size_t index{sentCount}; index < sim.output().size(); index++){
+          uint8_t data = sim.output()[index];
+          if(data == BIN_ACK || data == BIN_NAK || data == BIN_CAN) answer = data;
+        }
+      }
+      double sendAt = sim.seconds() + HOST_LATENCY_SEC;
+      while(sim.seconds() < sendAt) runPass();
+    }while(answer == BIN_NAK);
+    start += size;
+  }
+  while(!sim.isIdle() && sim.seconds() <= maxSeconds) runPass();
+  return answer;
+} //end playStream(const std::vector<uint8_t>&, const char*, const double, const double, void (*)())
+
+
+/*  long compareSegments(const std::vector<simSegment>& live, const std::vector<simSegment>& played)
+    > compares the segments of two runs, merged, and the times the isr
+      ran dry between them. the times they were loaded at are left out
+    args:
+      const std::vector<simSegment>& live: the segments of the live run
+      const std::vector<simSegment>& played: the segments of the stream played
+    returns the index of the first segment that differs, -1 if none
+*/
+long compareSegments(const std::vector<simSegment>& live, const std::vector<simSegment>& played){
+  size_t count = std::min(live.size(), played.size());
+  for(size_t index{}; index < count; index++){
+    const simSegment& first = live[index];
+    const simSegment& second = played[index];
+    bool isSame = first.stepCount == second.stepCount && first.isNewBlock == second.isNewBlock
+                  && (first.stepCount == 0 || isSameRate(first, second));
+    if(isSame && first.isNewBlock){
+      isSame = first.dirnBits == second.dirnBits;
+      for(int axis{}; axis < AXIS_COUNT; axis++) isSame = isSame && first.steps[axis] == second.steps[axis];
+    }
+    if(!isSame) return index;
+  }
+  return live.size() == played.size() ? -1 : (long)count;
+} //end compareSegments(const std::vector<simSegment>&, const std::vector<simSegment>&)
+
+
+/*  long compareSteps(const std::vector<simStep>& live, const uint64_t liveBase,
+                      const std::vector<simStep>& played, const uint64_t playedBase)
+    > compares the steps of an axis in two runs, their directions and the
+      time the step timer ran for until each, from the start of the run
+    args:
+      const std::vector<simStep>& live: the steps of the live run
+      const uint64_t liveBase: timer cycles at the start of the live run
+      const std::vector<simStep>& played: the steps of the stream played
+      const uint64_t playedBase: timer cycles at the start of the stream
+    returns the index of the first step that differs, -1 if none
+*/
+long compareSteps(const std::vector<simStep>& live, const uint64_t liveBase,
+                  const std::vector<simStep>& played, const uint64_t playedBase){
+  size_t count = std::min(live.size(), played.size());
+  for(size_t index{}; index < count; index++){
+    if(live[index].dirn != played[index].dirn
+       || live[index].runCycle - liveBase != played[index].runCycle - playedBase) return index;
+  }
+  return live.size() == played.size() ? -1 : (long)count;
+} //end compareSteps(const std::vector<simStep>&, const uint64_t, const std::vector<simStep>&, const uint64_t)
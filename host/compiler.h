@@ -0,0 +1,103 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// host/compiler.h                                                           //
+//                                                                           //
+// Description:                                                              //
+//      This is the header file for the step stream compiler, shared by      //
+//      atrox_compile and atrox_cell. G-code is run on the host simulation,  //
+//      the segments the step isr loads are turned into stream records and  //
+//      frames, see stream.h, and a stream is played back as a host would.   //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _HOST_COMPILER_H
+#define _HOST_COMPILER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "sim.h"
+
+//time the host takes from a BIN_ACK to sending the next frame, usb serial latency
+const double HOST_LATENCY_SEC = 0.004;
+//most step events a segment of the stream holds
+const unsigned long STREAM_MAX_EVENTS = 0xFFFF;
+
+/*  struct streamCount
+    > contains what a stream is made of
+*/
+struct streamCount{
+  size_t bytes{};   //frames included
+  size_t frames{};  //the empty frame included
+  long blocks{};
+  long rates{};
+  long ramps{};
+  long segments{};  //at the last rate
+  long rests{};
+};
+
+/*  struct liveRun
+    > contains a run of g-code through the parser and the planner
+*/
+struct liveRun{
+  double seconds{};
+  double moveSeconds{};                //the step timer ran for
+  uint64_t timerBase{};                //timer cycles at the start of the run
+  uint16_t underrunCount{};
+  std::string answers;
+  std::vector<simSegment> segments;    //as the isr loaded them
+  std::vector<simStep> steps[AXIS_COUNT];
+};
+
+/*  stream compiler
+      bool readFile(const char*, std::string*): reads a whole file
+      std::string answers(): gets what the firmware sent, flow control left out
+      bool isSameRate(const simSegment&, const simSegment&): checks whether two segments step at the same rate
+      int runLive(const std::string&, const double, liveRun*): runs g-code from setup() and keeps what was stepped
+      uint64_t segmentCycles(const simSegment&): gets the time a segment lasts
+      std::vector<simSegment> mergeSegments(const std::vector<simSegment>&, const uint64_t): merges the
+        segments of a block at the same rate
+      void putVarint(std::vector<uint8_t>*, uint32_t): appends a varint to a record
+      int prescalerCode(const uint8_t): gets the STREAM_RATE prescaler of timer clock select bits
+      bool encodeStream(const std::vector<simSegment>&, const uint8_t, std::vector<std::vector<uint8_t>>*,
+        streamCount*): turns merged segments into the records of a stream of the axes given
+      void putFrame(std::vector<uint8_t>*, const std::vector<uint8_t>&): appends a binary frame
+      std::vector<uint8_t> frameStream(const std::vector<std::vector<uint8_t>>&, const uint8_t, streamCount*):
+        packs the header and the records into frames
+      void runSimLoop(): runs a pass of loop() of a board alone
+      int playStream(const std::vector<uint8_t>&, const char*, const double, const double, void (*)()):
+        plays the frames of a stream in stream mode, against BIN_ACK
+      long compareSegments(const std::vector<simSegment>&, const std::vector<simSegment>&): compares the
+        segments of two runs
+      long compareSteps(const std::vector<simStep>&, const uint64_t, const std::vector<simStep>&,
+        const uint64_t): compares the steps of an axis in two runs by the time the step timer ran for
+*/
+bool readFile(const char* path, std::string* text);
+std::string answers();
+bool isSameRate(const simSegment& first, const simSegment& second);
+int runLive(const std::string& gcode, const double maxSeconds, liveRun* live);
+uint64_t segmentCycles(const simSegment& segment);
+std::vector<simSegment> mergeSegments(const std::vector<simSegment>& segments, const uint64_t maxCycles);
+void putVarint(std::vector<uint8_t>* record, uint32_t value);
+int prescalerCode(const uint8_t clockSelect);
+bool encodeStream(const std::vector<simSegment>& segments, const uint8_t axisBits,
+                  std::vector<std::vector<uint8_t>>* records, streamCount* count);
+void putFrame(std::vector<uint8_t>* frames, const std::vector<uint8_t>& payload);
+std::vector<uint8_t> frameStream(const std::vector<std::vector<uint8_t>>& records, const uint8_t axisBits,
+                                 streamCount* count);
+void runSimLoop();
+int playStream(const std::vector<uint8_t>& frames, const char* command, const double holdUntil,
+               const double maxSeconds, void (*runPass)());
+long compareSegments(const std::vector<simSegment>& live, const std::vector<simSegment>& played);
+long compareSteps(const std::vector<simStep>& live, const uint64_t liveBase,
+                  const std::vector<simStep>& played, const uint64_t playedBase);
+
+#endif //_HOST_COMPILER_H
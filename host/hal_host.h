@@ -0,0 +1,63 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// host/hal_host.h                                                           //
+//                                                                           //
+// Description:                                                              //
+//      This is the host side of the hardware abstraction layer, see hal.h.  //
+//      The functions are implemented by the simulation in host/sim.cpp.     //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _HOST_HAL_HOST_H
+#define _HOST_HAL_HOST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+extern "C" void TIMER1_COMPA_vect(void);
+extern "C" void TIMER1_COMPB_vect(void);
+extern "C" void USART_RX_vect(void);
+extern "C" void USART_UDRE_vect(void);
+extern "C" void PCINT2_vect(void);
+
+void halTimerStart();
+void halTimerSet(const uint8_t clockSelect, const uint16_t ticks);
+void halTimerStop();
+bool halTimerIsLate();
+bool halPulseStart(const uint8_t us);
+void halPulseEnd();
+void halDirnSetup(const uint8_t us);
+void halStepEvent(const uint8_t stepBits, const uint8_t dirnBits);
+void halSegmentEvent(const uint8_t clockSelect, const uint16_t ticks, const uint16_t stepCount,
+                     const unsigned long* blockSteps, const uint8_t dirnBits);
+
+void halEepromRead(const uint16_t address, void* data, const size_t size);
+void halEepromWrite(const uint16_t address, const void* data, const size_t size);
+
+//as much as the eeprom leaves above the settings block on the target
+const uint16_t HAL_JOB_ADDRESS = 256;
+const uint16_t HAL_JOB_SIZE = 1024 - HAL_JOB_ADDRESS;
+
+void halJobRead(const uint16_t address, void* data, const size_t size);
+void halJobWrite(const uint16_t address, const void* data, const size_t size);
+
+uint16_t halAnalogRead(const uint8_t pin);
+
+void halUartBegin(const unsigned long baud);
+uint8_t halUartRead();
+void halUartWrite(const uint8_t data);
+void halUartTxInterrupt(const bool isOn);
+bool halUartCanPoll();
+
+void halSyncBegin(const bool isLead);
+void halSyncToggle();
+void halSyncEnd();
+
+int halFreeRam();
+
+#endif //_HOST_HAL_HOST_H
@@ -0,0 +1,820 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// host/sim.cpp                                                              //
+//                                                                           //
+// Description:                                                              //
+//      This is the implementation file for the host simulation, and for     //
+//      the host side of the hardware abstraction layer.                     //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <Arduino.h>
+
+#include <stdio.h>
+
+#include "hal.h"
+#include "program.h"
+#include "sim.h"
+#include "sketch.h"
+#include "uart.h"
+
+
+Simulation sim;
+
+void halTimerStart(){
+  sim.timerStart();
+}
+
+void halTimerSet(const uint8_t clockSelect, const uint16_t ticks){
+  sim.timerSet(clockSelect, ticks);
+}
+
+void halTimerStop(){
+  sim.timerStop();
+}
+
+bool halTimerIsLate(){
+  return false; //every interrupt is run at the cycle it is due
+}
+
+bool halPulseStart(const uint8_t us){
+  return sim.pulseStart(us);
+}
+
+void halPulseEnd(){
+  //nothing to do on the host, the pulse interrupt runs once
+}
+
+void halDirnSetup(const uint8_t us){
+  //nothing to do on the host, no time passes inside an interrupt
+}
+
+void halStepEvent(const uint8_t stepBits, const uint8_t dirnBits){
+  sim.stepEvent(stepBits, dirnBits);
+}
+
+void halSegmentEvent(const uint8_t clockSelect, const uint16_t ticks, const uint16_t stepCount,
+                     const unsigned long* blockSteps, const uint8_t dirnBits){
+  sim.segmentEvent(clockSelect, ticks, stepCount, blockSteps, dirnBits);
+}
+
+void halEepromRead(const uint16_t address, void* data, const size_t size){
+  sim.eepromRead(address, data, size);
+}
+
+void halEepromWrite(const uint16_t address, const void* data, const size_t size){
+  sim.eepromWrite(address, data, size);
+}
+
+void halJobRead(const uint16_t address, void* data, const size_t size){
+  sim.jobRead(address, data, size);
+}
+
+void halJobWrite(const uint16_t address, const void* data, const size_t size){
+  sim.jobWrite(address, data, size);
+}
+
+uint16_t halAnalogRead(const uint8_t pin){
+  return sim.analogRead(pin);
+}
+
+int halFreeRam(){
+  return 0; //the host has no such limit, not known
+}
+
+void halUartBegin(const unsigned long baud){
+  sim.uartBegin(baud);
+}
+
+uint8_t halUartRead(){
+  return sim.uartRead();
+}
+
+void halUartWrite(const uint8_t data){
+  sim.uartWrite(data);
+}
+
+void halUartTxInterrupt(const bool isOn){
+  sim.uartTxInterrupt(isOn);
+}
+
+bool halUartCanPoll(){
+  //nothing runs alongside the firmware, a full send buffer is always polled
+  return true;
+}
+
+void halSyncBegin(const bool isLead){
+  sim.syncBegin(isLead);
+}
+
+void halSyncToggle(){
+  sim.syncToggle();
+}
+
+void halSyncEnd(){
+  sim.syncEnd();
+}
+
+
+/*  Simulation constructor Simulation()
+    > constructs a simulation with an erased eeprom and job storage, and
+      every analog input at the center of its range
+*/
+Simulation::Simulation(){
+  memset(eeprom, 0xFF, sizeof(eeprom));
+  memset(jobStore, 0xFF, sizeof(jobStore));
+  for(uint16_t& value : analogValue) value = 512;
+} //end Simulation::Simulation()
+
+
+/*  void Simulation::begin()
+    > starts the simulation at cycle 0 and runs setup()
+      the firmware's objects are global, so this is called once per run
+    no args
+    returns nothing
+*/
+void Simulation::begin(){
+  cycleCount = 0;
+  timerStartedAt = 0;
+  timerRunCycles = 0;
+  isPulseOn = false;
+  clearRecords();
+  setup();
+  return;
+} //end Simulation::begin()
+
+
+/*  void Simulation::send(const char* text)
+    > queues text to be received by the firmware
+    args:
+      const char* text: the text, ending with a null
+    returns nothing
+*/
+void Simulation::send(const char* text){
+  send((const uint8_t*)text, strlen(text));
+  return;
+} //end Simulation::send(const char*)
+
+
+/*  void Simulation::send(const uint8_t* data, const size_t size)
+    > queues bytes to be received by the firmware
+      the first byte arrives one byte time from now, or after the bytes
+      queued before it
+    args:
+      const uint8_t* data: the bytes
+      const size_t size: number of bytes
+    returns nothing
+*/
+void Simulation::send(const uint8_t* data, const size_t size){
+  if(rxQueue.empty()) rxNext = max(rxNext, cycleCount + byteCycles);
+  rxQueue.insert(rxQueue.end(), data, data + size);
+  return;
+} //end Simulation::send(const uint8_t*, const size_t)
+
+
+/*  void Simulation::runLoop()
+    > runs one pass of loop(), then the interrupts due while it lasted
+      the pass lasts longer by the analog reads made in it
+    no args
+    returns nothing
+*/
+void Simulation::runLoop(){
+  adcCycles = 0;
+  loop();
+  advance(cycleCount + loopCycles + adcCycles);
+  return;
+} //end Simulation::runLoop()
+
+
+/*  bool Simulation::isIdle()
+    > checks whether every byte sent was received and read, no command
+      waits, no job runs, nothing moves or homes and the firmware has
+      nothing left to send
+    no args
+    returns true if idle
+*/
+bool Simulation::isIdle(){
+  return rxQueue.empty() && uart.available() == 0 && !isCommandPending
+         && !program.isRunning() && !atrox.isMoving() && !atrox.isHoming() && !isTxOn;
+} //end Simulation::isIdle()
+
+
+/*  bool Simulation::runUntilIdle(const double maxSeconds)
+    > runs loop() until the firmware is idle
+    args:
+      const double maxSeconds: simulated time to give up at
+    returns true if idle, false if the time ran out
+*/
+bool Simulation::runUntilIdle(const double maxSeconds){
+  while(!isIdle()){
+    if(seconds() > maxSeconds) return false;
+    runLoop();
+  }
+  return true;
+} //end Simulation::runUntilIdle(const double)
+
+
+/*  uint64_t Simulation::cycles()
+    > gets the simulated time
+    no args
+    returns the time in cpu cycles
+*/
+uint64_t Simulation::cycles(){
+  return cycleCount;
+} //end Simulation::cycles()
+
+
+/*  uint64_t Simulation::timerCycles()
+    > gets the time the step timer has run for since begin(), the time at
+      rest left out, as simStep::runCycle counts it
+    no args
+    returns the time in cpu cycles
+*/
+uint64_t Simulation::timerCycles(){
+  return timerRunCycles + (isTimerOn ? cycleCount - timerStartedAt : 0);
+} //end Simulation::timerCycles()
+
+
+/*  uint64_t Simulation::receivedAt()
+    > gets the cycle the receive interrupt of the last byte ran at
+    no args
+    returns the time in cpu cycles
+*/
+uint64_t Simulation::receivedAt(){
+  return rxLast;
+} //end Simulation::receivedAt()
+
+
+/*  double Simulation::seconds()
+    > gets the simulated time
+    no args
+    returns the time in sec
+*/
+double Simulation::seconds(){
+  return (double)cycleCount / F_CPU;
+} //end Simulation::seconds()
+
+
+/*  const std::vector<simStep>& Simulation::steps(const int axis)
+    > gets the steps sent to an axis, oldest first
+    args:
+      const int axis: the axis
+    returns the steps
+*/
+const std::vector<simStep>& Simulation::steps(const int axis){
+  return stepRecord[axis];
+} //end Simulation::steps(const int)
+
+
+/*  const std::vector<simSegment>& Simulation::segments()
+    > gets the segments the isr loaded and the times it ran dry, oldest first
+    no args
+    returns the segments
+*/
+const std::vector<simSegment>& Simulation::segments(){
+  return segmentRecord;
+} //end Simulation::segments()
+
+
+/*  long Simulation::position(const int axis)
+    > gets the position of an axis by adding up its recorded steps
+    args:
+      const int axis: the axis
+    returns the position in step
+*/
+long Simulation::position(const int axis){
+  long axisStep{};
+  for(const simStep& step : stepRecord[axis]) axisStep += step.dirn;
+  return axisStep;
+} //end Simulation::position(const int)
+
+
+/*  std::string& Simulation::output()
+    > gets the bytes the firmware sent, flow control bytes included
+    no args
+    returns the bytes
+*/
+std::string& Simulation::output(){
+  return sent;
+} //end Simulation::output()
+
+
+/*  void Simulation::clearRecords()
+    > drops the recorded steps, segments, sync ticks and output
+    no args
+    returns nothing
+*/
+void Simulation::clearRecords(){
+  for(int axis{}; axis < AXIS_COUNT; axis++) stepRecord[axis].clear();
+  segmentRecord.clear();
+  syncRecord.clear();
+  sent.clear();
+  return;
+} //end Simulation::clearRecords()
+
+
+/*  uint32_t Simulation::eepromWrites()
+    > gets the number of eeprom bytes written, bytes left as they were
+      are not counted
+    no args
+    returns the number of bytes
+*/
+uint32_t Simulation::eepromWrites(){
+  return eepromWriteCount;
+} //end Simulation::eepromWrites()
+
+
+/*  bool Simulation::setJobFile(const char* path)
+    > keeps the job storage in a file from now on, the file is created if
+      there is none. a job saved in it is there on the next run
+    args:
+      const char* path: path of the file
+    returns true if the file could be opened
+*/
+bool Simulation::setJobFile(const char* path){
+  FILE* file = fopen(path, "r+b");
+  if(file == nullptr) file = fopen(path, "w+b");
+  if(file == nullptr) return false;
+  if(jobFile != nullptr) fclose(jobFile);
+  jobFile = file;
+  return true;
+} //end Simulation::setJobFile(const char*)
+
+
+/*  void Simulation::setLimitSwitch(const int axis, const long position)
+    > puts the limit switch of an axis at a position, the axis must have
+      a switch in the machine profile
+    args:
+      const int axis: the axis
+      const long position: where the switch closes, in step from where
+                           the axis was at cycle 0
+    returns nothing
+*/
+void Simulation::setLimitSwitch(const int axis, const long position){
+  isSwitchSet[axis] = true;
+  switchPosition[axis] = position;
+  updateSwitch(axis);
+  return;
+} //end Simulation::setLimitSwitch(const int, const long)
+
+
+/*  void Simulation::clearLimitSwitches()
+    > takes every limit switch away, their pins read released
+    no args
+    returns nothing
+*/
+void Simulation::clearLimitSwitches(){
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    isSwitchSet[axis] = false;
+    updateSwitch(axis);
+  }
+  return;
+} //end Simulation::clearLimitSwitches()
+
+
+/*  long Simulation::axisPosition(const int axis)
+    > gets the position of an axis from every step since cycle 0, unlike
+      position() it is not reset by clearRecords() nor by homing
+    args:
+      const int axis: the axis
+    returns the position in step
+*/
+long Simulation::axisPosition(const int axis){
+  return stepPosition[axis];
+} //end Simulation::axisPosition(const int)
+
+
+/*  void Simulation::setAnalog(const uint8_t pin, const uint16_t value)
+    > sets what an analog pin reads from now on, eg a joystick moved
+    args:
+      const uint8_t pin: the pin, 14-19 for A0-A5
+      const uint16_t value: the reading, 0-1023
+    returns nothing
+*/
+void Simulation::setAnalog(const uint8_t pin, const uint16_t value){
+  if(pin < SIM_PIN_COUNT) analogValue[pin] = min(value, (uint16_t)1023);
+  return;
+} //end Simulation::setAnalog(const uint8_t, const uint16_t)
+
+
+/*  const std::vector<uint64_t>& Simulation::syncTicks()
+    > gets the cycles the firmware changed the sync line at as the lead,
+      oldest first
+    no args
+    returns the cycles
+*/
+const std::vector<uint64_t>& Simulation::syncTicks(){
+  return syncRecord;
+} //end Simulation::syncTicks()
+
+
+/*  void Simulation::receiveSyncTick(const uint64_t cycle)
+    > queues a change of the sync line by the lead of the cell, it runs
+      the pin change interrupt if the firmware reads the line by then
+      ticks are queued in order, one due already changes the line at once
+    args:
+      const uint64_t cycle: cycle the line changes at
+    returns nothing
+*/
+void Simulation::receiveSyncTick(const uint64_t cycle){
+  syncQueue.push_back(max(cycle, cycleCount));
+  return;
+} //end Simulation::receiveSyncTick(const uint64_t)
+
+
+/*  void Simulation::timerStart()
+    > starts the step timer with a compare of 1 at clk/8
+    no args
+    returns nothing
+*/
+void Simulation::timerStart(){
+  if(isTimerOn) timerRunCycles += cycleCount - timerStartedAt;
+  timerStartedAt = cycleCount;
+  isTimerOn = true;
+  timerDivider = 8;
+  timerCompare = 1;
+  timerNext = cycleCount + (timerCompare + 1) * timerDivider;
+  return;
+} //end Simulation::timerStart()
+
+
+/*  void Simulation::timerSet(const uint8_t clockSelect, const uint16_t ticks)
+    > sets the step timer, taking effect from its next period
+    args:
+      const uint8_t clockSelect: TIMER_CLK_DIV8, TIMER_CLK_DIV64 or TIMER_CLK_DIV256
+      const uint16_t ticks: compare value
+    returns nothing
+*/
+void Simulation::timerSet(const uint8_t clockSelect, const uint16_t ticks){
+  switch(clockSelect){
+    case TIMER_CLK_DIV8:
+      timerDivider = 8;
+      break;
+    case TIMER_CLK_DIV64:
+      timerDivider = 64;
+      break;
+    case TIMER_CLK_DIV256:
+      timerDivider = 256;
+      break;
+  }
+  timerCompare = ticks;
+  return;
+} //end Simulation::timerSet(const uint8_t, const uint16_t)
+
+
+/*  void Simulation::timerStop()
+    > stops the step timer
+    no args
+    returns nothing
+*/
+void Simulation::timerStop(){
+  if(isTimerOn) timerRunCycles += cycleCount - timerStartedAt;
+  isTimerOn = false;
+  return;
+} //end Simulation::timerStop()
+
+
+/*  bool Simulation::pulseStart(const uint8_t us)
+    > runs the pulse interrupt a number of us from now, as compare b of
+      timer1 would, if that comes before the next step event. called from
+      the step isr, at the start of the timer's period
+    args:
+      const uint8_t us: time from now
+    returns true if the pulse interrupt will run
+*/
+bool Simulation::pulseStart(const uint8_t us){
+  uint64_t due = cycleCount + (uint64_t)us * (F_CPU / 1000000UL);
+  if(isTimerOn && due >= cycleCount + (uint64_t)(timerCompare + 1) * timerDivider) return false;
+  isPulseOn = true;
+  pulseNext = due;
+  return true;
+} //end Simulation::pulseStart(const uint8_t)
+
+
+/*  void Simulation::stepEvent(const uint8_t stepBits, const uint8_t dirnBits)
+    > records the steps of a step event at the current cycle
+    args:
+      const uint8_t stepBits: bit set for axes stepped
+      const uint8_t dirnBits: bit set for axes moving backward
+    returns nothing
+*/
+void Simulation::stepEvent(const uint8_t stepBits, const uint8_t dirnBits){
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(stepBits & (1 << axis)){
+      simStep step;
+      step.cycle = cycleCount;
+      step.runCycle = timerRunCycles + (cycleCount - timerStartedAt);
+      step.dirn = (dirnBits & (1 << axis)) ? -1 : 1;
+      stepRecord[axis].push_back(step);
+      stepPosition[axis] += step.dirn;
+      if(isSwitchSet[axis]) updateSwitch(axis);
+    }
+  }
+  return;
+} //end Simulation::stepEvent(const uint8_t, const uint8_t)
+
+
+/*  void Simulation::segmentEvent(const uint8_t clockSelect, const uint16_t ticks, const uint16_t stepCount,
+                                  const unsigned long* blockSteps, const uint8_t dirnBits)
+    > records a segment loaded by the isr at the current cycle, or the isr
+      running dry
+    args:
+      const uint8_t clockSelect: timer clock select bits
+      const uint16_t ticks: timer ticks between step events
+      const uint16_t stepCount: step events, 0 when the isr ran dry
+      const unsigned long* blockSteps: steps per axis of the block it starts, nullptr if the block goes on
+      const uint8_t dirnBits: bit set for axes of the block it starts moving backward
+    returns nothing
+*/
+void Simulation::segmentEvent(const uint8_t clockSelect, const uint16_t ticks, const uint16_t stepCount,
+                              const unsigned long* blockSteps, const uint8_t dirnBits){
+  simSegment segment;
+  segment.cycle = cycleCount;
+  segment.clockSelect = clockSelect;
+  segment.ticks = ticks;
+  segment.stepCount = stepCount;
+  if(blockSteps != nullptr){
+    segment.isNewBlock = true;
+    for(int axis{}; axis < AXIS_COUNT; axis++) segment.steps[axis] = blockSteps[axis];
+    segment.dirnBits = dirnBits;
+  }
+  segmentRecord.push_back(segment);
+  return;
+} //end Simulation::segmentEvent(const uint8_t, const uint16_t, const uint16_t, const unsigned long*, const uint8_t)
+
+
+/*  void Simulation::syncBegin(const bool isLead)
+    > takes the sync line, as the lead it records its ticks, as a follower
+      the ticks received run the pin change interrupt from now on
+    args:
+      const bool isLead: true to drive the line
+    returns nothing
+*/
+void Simulation::syncBegin(const bool isLead){
+  isSyncLead = isLead;
+  isSyncRead = !isLead;
+  return;
+} //end Simulation::syncBegin(const bool)
+
+
+/*  void Simulation::syncToggle()
+    > records a tick of the lead at the current cycle
+    no args
+    returns nothing
+*/
+void Simulation::syncToggle(){
+  if(isSyncLead) syncRecord.push_back(cycleCount);
+  return;
+} //end Simulation::syncToggle()
+
+
+/*  void Simulation::syncEnd()
+    > lets go of the sync line, the ticks received are dropped
+    no args
+    returns nothing
+*/
+void Simulation::syncEnd(){
+  isSyncLead = false;
+  isSyncRead = false;
+  return;
+} //end Simulation::syncEnd()
+
+
+/*  void Simulation::eepromRead(const uint16_t address, void* data, const size_t size)
+    > reads bytes from the eeprom, bytes past its end read as erased
+    args:
+      const uint16_t address: address of the first byte
+      void* data: where the bytes go
+      const size_t size: number of bytes
+    returns nothing
+*/
+void Simulation::eepromRead(const uint16_t address, void* data, const size_t size){
+  uint8_t* bytes = (uint8_t*)data;
+  for(size_t index{}; index < size; index++){
+    bytes[index] = address + index < SIM_EEPROM_SIZE ? eeprom[address + index] : 0xFF;
+  }
+  return;
+} //end Simulation::eepromRead(const uint16_t, void*, const size_t)
+
+
+/*  void Simulation::eepromWrite(const uint16_t address, const void* data, const size_t size)
+    > writes bytes to the eeprom, only the bytes that change are written
+    args:
+      const uint16_t address: address of the first byte
+      const void* data: the bytes
+      const size_t size: number of bytes
+    returns nothing
+*/
+void Simulation::eepromWrite(const uint16_t address, const void* data, const size_t size){
+  const uint8_t* bytes = (const uint8_t*)data;
+  for(size_t index{}; index < size && address + index < SIM_EEPROM_SIZE; index++){
+    if(eeprom[address + index] != bytes[index]){
+      eeprom[address + index] = bytes[index];
+      eepromWriteCount++;
+    }
+  }
+  return;
+} //end Simulation::eepromWrite(const uint16_t, const void*, const size_t)
+
+
+/*  void Simulation::jobRead(const uint16_t address, void* data, const size_t size)
+    > reads bytes from the job storage, bytes past its end, or past the
+      end of the file, read as erased
+    args:
+      const uint16_t address: address of the first byte
+      void* data: where the bytes go
+      const size_t size: number of bytes
+    returns nothing
+*/
+void Simulation::jobRead(const uint16_t address, void* data, const size_t size){
+  uint8_t* bytes = (uint8_t*)data;
+  memset(bytes, 0xFF, size);
+  size_t count = address < HAL_JOB_SIZE ? min(size, (size_t)(HAL_JOB_SIZE - address)) : 0;
+  if(jobFile != nullptr){
+    if(count > 0 && fseek(jobFile, address, SEEK_SET) == 0) fread(bytes, 1, count, jobFile);
+  }else{
+    memcpy(bytes, jobStore + address, count);
+  }
+  return;
+} //end Simulation::jobRead(const uint16_t, void*, const size_t)
+
+
+/*  void Simulation::jobWrite(const uint16_t address, const void* data, const size_t size)
+    > writes bytes to the job storage, the file is flushed right away so
+      it holds the job if the simulation is cut short
+    args:
+      const uint16_t address: address of the first byte
+      const void* data: the bytes
+      const size_t size: number of bytes
+    returns nothing
+*/
+void Simulation::jobWrite(const uint16_t address, const void* data, const size_t size){
+  size_t count = address < HAL_JOB_SIZE ? min(size, (size_t)(HAL_JOB_SIZE - address)) : 0;
+  if(count == 0) return;
+  if(jobFile != nullptr){
+    if(fseek(jobFile, address, SEEK_SET) == 0){
+      fwrite(data, 1, count, jobFile);
+      fflush(jobFile);
+    }
+  }else{
+    memcpy(jobStore + address, data, count);
+  }
+  return;
+} //end Simulation::jobWrite(const uint16_t, const void*, const size_t)
+
+
+/*  uint16_t Simulation::analogRead(const uint8_t pin)
+    > reads an analog pin, the pass of loop() lasts SIM_ADC_CYCLES longer
+    args:
+      const uint8_t pin: the pin
+    returns the value last set, 0-1023
+*/
+uint16_t Simulation::analogRead(const uint8_t pin){
+  adcCycles += SIM_ADC_CYCLES;
+  return pin < SIM_PIN_COUNT ? analogValue[pin] : 0;
+} //end Simulation::analogRead(const uint8_t)
+
+
+/*  void Simulation::uartBegin(const unsigned long baud)
+    > sets the byte time of the serial line, 10 bits a byte
+    args:
+      const unsigned long baud: baud rate
+    returns nothing
+*/
+void Simulation::uartBegin(const unsigned long baud){
+  byteCycles = F_CPU * 10 / baud;
+  return;
+} //end Simulation::uartBegin(const unsigned long)
+
+
+/*  uint8_t Simulation::uartRead()
+    > gets the byte being received
+    no args
+    returns the byte
+*/
+uint8_t Simulation::uartRead(){
+  return rxData;
+} //end Simulation::uartRead()
+
+
+/*  void Simulation::uartWrite(const uint8_t data)
+    > keeps a byte the firmware sent, the line is busy for a byte time
+      xoff and xon pause and resume the bytes sent to the firmware
+    args:
+      const uint8_t data: the byte
+    returns nothing
+*/
+void Simulation::uartWrite(const uint8_t data){
+  sent += (char)data;
+  if(isEcho && data != XON_CHAR && data != XOFF_CHAR) putchar(data);
+  if(data == XOFF_CHAR){
+    isRxPaused = true;
+  }else if(data == XON_CHAR && isRxPaused){
+    isRxPaused = false;
+    rxNext = max(rxNext, cycleCount + byteCycles);
+  }
+  txNext = max(txNext, cycleCount) + byteCycles;
+  return;
+} //end Simulation::uartWrite(const uint8_t)
+
+
+/*  void Simulation::uartTxInterrupt(const bool isOn)
+    > turns the transmit interrupt on or off
+      it is due as soon as the line is free
+    args:
+      const bool isOn: true to turn it on
+    returns nothing
+*/
+void Simulation::uartTxInterrupt(const bool isOn){
+  isTxOn = isOn;
+  return;
+} //end Simulation::uartTxInterrupt(const bool)
+
+
+/*  protected void Simulation::advance(const uint64_t until)
+    > moves the clock forward, running the interrupts due on the way in order
+    args:
+      const uint64_t until: cycle to stop at
+    returns nothing
+*/
+void Simulation::advance(const uint64_t until){
+  while(true){
+    uint64_t next{until + 1};
+    int event{}; //1 step timer, 2 byte received, 3 line free to send, 4 sync tick, 5 pulse end
+    if(isTimerOn && timerNext < next){
+      next = timerNext;
+      event = 1;
+    }
+    if(isPulseOn && pulseNext < next){
+      next = pulseNext;
+      event = 5;
+    }
+    if(!rxQueue.empty() && !isRxPaused && rxNext < next){
+      next = rxNext;
+      event = 2;
+    }
+    if(isTxOn && max(txNext, cycleCount) < next){
+      next = max(txNext, cycleCount);
+      event = 3;
+    }
+    if(!syncQueue.empty() && syncQueue.front() < next){
+      next = syncQueue.front();
+      event = 4;
+    }
+    if(event == 0) break;
+
+    cycleCount = next;
+    switch(event){
+      case 1:
+        TIMER1_COMPA_vect();
+        timerNext = cycleCount + (uint64_t)(timerCompare + 1) * timerDivider;
+        break;
+      case 2:
+        rxData = rxQueue.front();
+        rxQueue.pop_front();
+        USART_RX_vect();
+        rxLast = cycleCount;
+        rxNext = cycleCount + byteCycles;
+        break;
+      case 3:
+        USART_UDRE_vect();
+        break;
+      case 4:
+        syncQueue.pop_front();
+        if(isSyncRead) PCINT2_vect();
+        break;
+      case 5:
+        isPulseOn = false;
+        TIMER1_COMPB_vect();
+        break;
+    }
+  }
+  cycleCount = until;
+  return;
+} //end Simulation::advance(const uint64_t)
+
+
+/*  protected void Simulation::updateSwitch(const int axis)
+    > sets the pin of the limit switch of an axis, low if the axis is at
+      or past the switch in its homing direction
+    args:
+      const int axis: the axis
+    returns nothing
+*/
+void Simulation::updateSwitch(const int axis){
+  if(!isAxisHomed(axis)) return;
+  const axisHoming& homing = MACHINE_HOMING[axis];
+  volatile uint8_t& pins = pinRegister[digitalPinToPort(homing.limitPin)];
+  long pastSwitch = (stepPosition[axis] - switchPosition[axis]) * homing.homeDirn;
+  if(isSwitchSet[axis] && pastSwitch >= 0){
+    pins &= ~digitalPinToBitMask(homing.limitPin);
+  }else{
+    pins |= digitalPinToBitMask(homing.limitPin);
+  }
+  return;
+} //end Simulation::updateSwitch(const int)
@@ -0,0 +1,222 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// host/sim.h                                                                //
+//                                                                           //
+// Description:                                                              //
+//      This is the header file for the host simulation. It runs the         //
+//      firmware's setup() and loop() against a simulated step timer and     //
+//      serial line, on a clock counted in cpu cycles of the target.         //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _HOST_SIM_H
+#define _HOST_SIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "atrox.h"
+#include "hal.h"
+
+//cpu cycles one pass of loop() is taken to last, the interrupts due in
+//that time are run after it
+const uint32_t SIM_LOOP_CYCLES = 1600;
+
+//eeprom size of the ATmega328P
+const size_t SIM_EEPROM_SIZE = 1024;
+
+//cpu cycles an analog read waits for its conversion, 13 adc clocks at
+//clk/128 and the call, added to the pass of loop() it is made in
+const uint32_t SIM_ADC_CYCLES = 1760;
+
+//pins an analog value can be set on, A0-A5 are 14-19
+const int SIM_PIN_COUNT = 20;
+
+/*  struct simStep
+    > contains one step sent to an axis
+*/
+struct simStep{
+  uint64_t cycle{};     //cpu cycle the step was sent at
+  uint64_t runCycle{};  //cpu cycles the step timer had run for by then
+  int8_t dirn{};        //1 forward, -1 backward
+};
+
+/*  struct simSegment
+    > contains one segment the isr loaded, or the isr running dry
+*/
+struct simSegment{
+  uint64_t cycle{};                   //cpu cycle it was loaded at
+  uint8_t clockSelect{};              //timer clock select bits
+  uint16_t ticks{};                   //timer ticks between step events
+  uint16_t stepCount{};               //step events, 0 when the isr ran dry
+  bool isNewBlock{false};             //a new step block starts with it
+  unsigned long steps[AXIS_COUNT]{};  //steps per axis of the new block
+  uint8_t dirnBits{};                 //bit set for axes of the new block moving backward
+};
+
+/*  class Simulation
+    > runs the firmware on the host
+    > time only passes between passes of loop(), the interrupts due are run
+      then in order, so the firmware never sees an interrupt in between
+      its own statements
+    > the step timer runs as timer1 in ctc mode would, every step the isr
+      sends is recorded per axis with its cycle, and with the time the
+      timer had run for, which leaves out the time at rest. every segment
+      the isr loads is recorded as well. the step pulses end on compare b,
+      run as an interrupt of its own
+    > bytes sent to the firmware arrive one per byte time at the baud rate
+      set by the firmware, and stop on xoff. bytes it sends are kept
+    > the eeprom starts erased and is kept over begin(), as over a reset
+    > the job storage is a file once one is set, as an sd card would be,
+      or else an erased block of memory
+    > analog inputs read what was last set, a centered stick at first
+    > limit switches stand at a position of their axis, counted from where
+      the axis was at cycle 0. a switch is pressed once its axis is at or
+      past it in the homing direction, pulling its pin low
+    > the sync line of a cell: the ticks sent as the lead are recorded,
+      the ticks of another board's lead are queued with their cycle and
+      run the pin change interrupt as a follower, see host/cell.cpp
+    public members:
+      uint32_t loopCycles: cpu cycles a pass of loop() is taken to last
+      bool isEcho: prints what the firmware sends to stdout as it goes
+    public methods:
+      void begin(): resets the simulation and runs setup()
+      void send(const char*): queues text to be received by the firmware
+      void send(const uint8_t*, const size_t): queues bytes to be received by the firmware
+      void runLoop(): runs one pass of loop() and the interrupts due after it
+      bool isIdle(): checks whether everything sent was handled and nothing moves
+      bool runUntilIdle(const double): runs loop() until idle, or a time limit passes
+      uint64_t cycles(): gets the simulated time in cpu cycles
+      uint64_t timerCycles(): gets the cpu cycles the step timer has run for
+      uint64_t receivedAt(): gets the cycle the last byte was received at
+      double seconds(): gets the simulated time in sec
+      const std::vector<simStep>& steps(const int): gets the steps sent to an axis
+      const std::vector<simSegment>& segments(): gets the segments the isr loaded
+      long position(const int): gets the position of an axis from its steps
+      std::string& output(): gets the bytes the firmware sent
+      void clearRecords(): drops the recorded steps, segments, sync ticks and output
+      uint32_t eepromWrites(): gets the number of eeprom bytes written so far
+      bool setJobFile(const char*): keeps the job storage in a file
+      void setLimitSwitch(const int, const long): puts the limit switch of an axis at a position
+      void clearLimitSwitches(): takes every limit switch away, the pins read released
+      long axisPosition(const int): gets the position of an axis from all its steps since cycle 0
+      void setAnalog(const uint8_t, const uint16_t): sets what an analog pin reads, 0-1023
+      const std::vector<uint64_t>& syncTicks(): gets the cycles of the ticks sent as the lead
+      void receiveSyncTick(const uint64_t): queues a tick of the lead of the cell at a cycle
+    usage:
+      Simulation(): initializes a simulation at cycle 0 with an erased eeprom
+      sim: the one simulation, the hal functions of hal_host.h run on it
+*/
+class Simulation{
+  uint64_t cycleCount{};
+
+  //step timer
+  bool isTimerOn{false};
+  uint32_t timerDivider{8};
+  uint16_t timerCompare{};
+  uint64_t timerNext{};
+  uint64_t timerStartedAt{};
+  uint64_t timerRunCycles{};  //until timerStartedAt
+  bool isPulseOn{false};      //compare b, the end of the step pulses
+  uint64_t pulseNext{};
+
+  //serial line
+  uint32_t byteCycles{};
+  std::deque<uint8_t> rxQueue;
+  uint64_t rxNext{};
+  uint8_t rxData{};
+  uint64_t rxLast{};
+  bool isRxPaused{false};
+  bool isTxOn{false};
+  uint64_t txNext{};
+
+  uint8_t eeprom[SIM_EEPROM_SIZE];
+  uint32_t eepromWriteCount{};
+
+  uint8_t jobStore[HAL_JOB_SIZE];
+  FILE* jobFile{nullptr};
+
+  std::vector<simStep> stepRecord[AXIS_COUNT];
+  std::vector<simSegment> segmentRecord;
+  long stepPosition[AXIS_COUNT]{};
+  bool isSwitchSet[AXIS_COUNT]{};
+  long switchPosition[AXIS_COUNT]{};
+  std::string sent;
+
+  uint16_t analogValue[SIM_PIN_COUNT];
+  uint32_t adcCycles{};  //spent in analog reads during the pass of loop()
+
+  //sync line
+  bool isSyncLead{false};
+  bool isSyncRead{false};
+  std::vector<uint64_t> syncRecord;
+  std::deque<uint64_t> syncQueue;
+
+  public:
+    uint32_t loopCycles{SIM_LOOP_CYCLES};
+    bool isEcho{false};
+
+    void begin();
+    void send(const char* text);
+    void send(const uint8_t* data, const size_t size);
+    void runLoop();
+    bool isIdle();
+    bool runUntilIdle(const double maxSeconds);
+    uint64_t cycles();
+    uint64_t timerCycles();
+    uint64_t receivedAt();
+    double seconds();
+    const std::vector<simStep>& steps(const int axis);
+    const std::vector<simSegment>& segments();
+    long position(const int axis);
+    std::string& output();
+    void clearRecords();
+    uint32_t eepromWrites();
+    bool setJobFile(const char* path);
+    void setLimitSwitch(const int axis, const long position);
+    void clearLimitSwitches();
+    long axisPosition(const int axis);
+    void setAnalog(const uint8_t pin, const uint16_t value);
+    const std::vector<uint64_t>& syncTicks();
+    void receiveSyncTick(const uint64_t cycle);
+
+    Simulation();
+
+    //hal, see hal_host.h
+    void timerStart();
+    void timerSet(const uint8_t clockSelect, const uint16_t ticks);
+    void timerStop();
+    bool pulseStart(const uint8_t us);
+    void stepEvent(const uint8_t stepBits, const uint8_t dirnBits);
+    void segmentEvent(const uint8_t clockSelect, const uint16_t ticks, const uint16_t stepCount,
+                      const unsigned long* blockSteps, const uint8_t dirnBits);
+    void eepromRead(const uint16_t address, void* data, const size_t size);
+    void eepromWrite(const uint16_t address, const void* data, const size_t size);
+    void jobRead(const uint16_t address, void* data, const size_t size);
+    void jobWrite(const uint16_t address, const void* data, const size_t size);
+    uint16_t analogRead(const uint8_t pin);
+    void uartBegin(const unsigned long baud);
+    uint8_t uartRead();
+    void uartWrite(const uint8_t data);
+    void uartTxInterrupt(const bool isOn);
+    void syncBegin(const bool isLead);
+    void syncToggle();
+    void syncEnd();
+  protected:
+    void advance(const uint64_t until);
+    void updateSwitch(const int axis);
+};
+
+extern Simulation sim;
+
+#endif //_HOST_SIM_H
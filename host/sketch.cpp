@@ -0,0 +1,18 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// host/sketch.cpp                                                           //
+//                                                                           //
+// Description:                                                              //
+//      This builds atrox.ino on the host, as the Arduino IDE would.         //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <Arduino.h>
+
+#include "sketch.h"
+#include "atrox.ino"
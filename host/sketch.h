@@ -0,0 +1,45 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// host/sketch.h                                                             //
+//                                                                           //
+// Description:                                                              //
+//      This is the header file for the sketch built on the host. It         //
+//      declares what atrox.ino defines, for the simulation and tools.       //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _HOST_SKETCH_H
+#define _HOST_SKETCH_H
+
+#include "atrox.h"
+#include "binproto.h"
+#include "command.h"
+#include "gcode.h"
+#include "planner.h"
+#include "program.h"
+#include "stepper.h"
+#include "stream.h"
+
+extern Planner planner;
+extern Stepper stepper;
+extern Atrox atrox;
+extern Command command;
+extern GcodeReader gcodeReader;
+extern BinaryReader binaryReader;
+extern StreamReader streamReader;
+extern bool isCommandPending;
+
+void setup();
+void loop();
+bool executePendingCommand();
+int loadCommandFromSerial(GcodeReader* readerPtr);
+int loadCommandFromBinary(BinaryReader* readerPtr);
+int loadCommandFromProgram(GcodeReader* readerPtr);
+int playStreamFromBinary(BinaryReader* readerPtr, StreamReader* streamPtr);
+
+#endif //_HOST_SKETCH_H
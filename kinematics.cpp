@@ -0,0 +1,93 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// kinematics.cpp                                                            //
+//                                                                           //
+// Description:                                                              //
+//      This is the implementation file for the kinematics of the six axis   //
+//      machine.                                                             //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <Arduino.h>
+
+#include "kinematics.h"
+
+
+//sin(i * 90 / SINE_TABLE_STEPS degrees) * TRIG_ONE
+static const uint16_t SINE_TABLE[SINE_TABLE_STEPS + 1] PROGMEM = {
+      0,   402,   804,  1206,  1608,  2009,  2411,  2811,  3212,  3612,
+   4011,  4410,  4808,  5205,  5602,  5998,  6393,  6787,  7180,  7571,
+   7962,  8351,  8740,  9127,  9512,  9896, 10279, 10660, 11039, 11417,
+  11793, 12167, 12540, 12910, 13279, 13646, 14010, 14373, 14733, 15091,
+  15447, 15800, 16151, 16500, 16846, 17190, 17531, 17869, 18205, 18538,
+  18868, 19195, 19520, 19841, 20160, 20475, 20788, 21097, 21403, 21706,
+  22006, 22302, 22595, 22884, 23170, 23453, 23732, 24008, 24279, 24548,
+  24812, 25073, 25330, 25583, 25833, 26078, 26320, 26557, 26791, 27020,
+  27246, 27467, 27684, 27897, 28106, 28311, 28511, 28707, 28899, 29086,
+  29269, 29448, 29622, 29792, 29957, 30118, 30274, 30425, 30572, 30715,
+  30853, 30986, 31114, 31238, 31357, 31471, 31581, 31686, 31786, 31881,
+  31972, 32058, 32138, 32214, 32286, 32352, 32413, 32470, 32522, 32568,
+  32610, 32647, 32679, 32706, 32729, 32746, 32758, 32766, 32768};
+
+
+/*  long fixedSin(const long angle)
+    > gets the sine of an angle from the quarter wave table, interpolated
+      between its two nearest entries
+    args:
+      const long angle: the angle in millidegree, any sign or turn
+    returns the sine, TRIG_ONE for 1
+*/
+long fixedSin(const long angle){
+  long turn = angle % 360000L;
+  if(turn < 0) turn += 360000L;
+  int quadrant = turn / 90000L;
+  long quarter = turn - quadrant * 90000L;
+  if(quadrant & 1) quarter = 90000L - quarter; //falling back to 0
+
+  long position = quarter * SINE_TABLE_STEPS;
+  int index = position / 90000L;
+  long fraction = position - index * 90000L;
+  long low = pgm_read_word(&SINE_TABLE[index]);
+  long sine = low;
+  if(fraction > 0){
+    long high = pgm_read_word(&SINE_TABLE[index + 1]);
+    sine += ((high - low) * fraction + 45000L) / 90000L;
+  }
+  return quadrant >= 2 ? -sine : sine;
+} //end fixedSin(const long)
+
+
+/*  long fixedCos(const long angle)
+    > gets the cosine of an angle, the sine 90 degrees on
+    args:
+      const long angle: the angle in millidegree, any sign or turn
+    returns the cosine, TRIG_ONE for 1
+*/
+long fixedCos(const long angle){
+  return fixedSin(angle % 360000L + 90000L);
+} //end fixedCos(const long)
+
+
+/*  void toolOffset(const long yaw, const long pitch, long offset[])
+    > gets how far the tool tip stands from where it is at yaw and pitch
+      0, along x, y and z, see kinematics in kinematics.h
+      the tip is at the carriage plus the offset
+    args:
+      const long yaw: the machine position of W, in millidegree
+      const long pitch: the machine position of P, in millidegree
+      long offset[]: gets the offset along x, y and z, in um
+    returns nothing
+*/
+void toolOffset(const long yaw, const long pitch, long offset[]){
+  //the length times the sine reaches past 32 bit on a long tool
+  long reach = (long)(((int64_t)MACHINE_TOOL_LENGTH * fixedSin(pitch)) / TRIG_ONE);
+  offset[0] = (long)(((int64_t)reach * fixedCos(yaw)) / TRIG_ONE);
+  offset[1] = (long)(((int64_t)reach * fixedSin(yaw)) / TRIG_ONE);
+  offset[2] = MACHINE_TOOL_LENGTH - (long)(((int64_t)MACHINE_TOOL_LENGTH * fixedCos(pitch)) / TRIG_ONE);
+  return;
+} //end toolOffset(const long, const long, long[])
@@ -0,0 +1,67 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// kinematics.h                                                              //
+//                                                                           //
+// Description:                                                              //
+//      This is the header file for the kinematics of the six axis machine,  //
+//      the tool tip and the tool orientation against the axes.              //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _KINEMATICS_H
+#define _KINEMATICS_H
+
+#include <Arduino.h>
+
+#include "atrox.h"
+
+/*  kinematics
+    > the x, y, z carriage carries the head, which turns the tool in yaw
+      about z (W), then in pitch (P), then in roll about the tool itself
+      (R). at machine position 0 of W and P the tool points down -z
+    > a tool pose is the tool tip in x, y, z and the tool orientation in
+      W, P, R. the orientation is the head's own angles, so the head axes
+      take it as it is and only the carriage is solved for: the tip stands
+      MACHINE_TOOL_LENGTH from the pitch axis along the tool, the carriage
+      is moved by the tip less the tool offset
+        offset = L * (sin P cos W, sin P sin W, 1 - cos P)
+      roll turns about the tool and does not move the tip
+    > fixed point throughout, positions in um and angles in millidegree.
+      sine and cosine come from a quarter wave table in flash, interpolated,
+      within 5e-5 of the exact value. the offset is then within 7um on a
+      60mm tool, under a step of the carriage. it costs four table reads
+      and a few multiplies, cheap enough for every step segment, see
+      Stepper::prepareToolPath()
+
+    TRIG_ONE: 1.0 in the fixed point of fixedSin() and fixedCos()
+    bool isKinematic(): checks whether the machine profile has every axis tool poses need
+    long fixedSin(const long): gets the sine of an angle in millidegree
+    long fixedCos(const long): gets the cosine of an angle in millidegree
+    void toolOffset(const long, const long, long[]): gets the tool offset in um at a yaw and pitch
+*/
+const long TRIG_ONE = 32768;
+
+//quarter wave sine table, intervals over 90 degrees
+const int SINE_TABLE_STEPS = 128;
+
+/*  constexpr bool isKinematic()
+    > checks whether the machine profile has the carriage and the yaw and
+      pitch axes, tool poses are refused without them
+    no args
+    returns true if tool poses can be moved to
+*/
+constexpr bool isKinematic(){
+  return isAxisUsed(X_AXIS) && isAxisUsed(Y_AXIS) && isAxisUsed(Z_AXIS)
+         && isAxisUsed(W_AXIS) && isAxisUsed(P_AXIS);
+} //end isKinematic()
+
+long fixedSin(const long angle);
+long fixedCos(const long angle);
+void toolOffset(const long yaw, const long pitch, long offset[]);
+
+#endif //_KINEMATICS_H
@@ -0,0 +1,265 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// machine.h                                                                 //
+//                                                                           //
+// Description:                                                              //
+//      This is the machine profile: the pins, the motor settings, the       //
+//      homing and the joystick of each axis, the tool length and the sync   //
+//      pin, fixed at compile time. Pick the profile of the rig with         //
+//      ATROX_MACHINE below, or with -DATROX_MACHINE=... on the host.        //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _MACHINE_H
+#define _MACHINE_H
+
+#include <Arduino.h>
+
+//machine profiles
+#define MACHINE_ONE_AXIS 1 //the p axis alone, the rig as it is wired
+#define MACHINE_SIX_AXIS 6 //x, y, z and the w, p, r head, placeholder wiring
+#define MACHINE_TWO_AXIS 2 //w, p pan and tilt head
+
+#ifndef ATROX_MACHINE
+#define ATROX_MACHINE MACHINE_ONE_AXIS
+#endif
+
+//pin of an axis that is not wired, the axis is compiled out
+const uint8_t NO_PIN = 0xFF;
+
+//home the axes with a limit switch in setup(), or only on G28
+const bool HOMING_AT_BOOT = false;
+
+//farthest an arc's segments may cut inside it, in um, until set with M570
+//see Atrox::moveArc()
+const long MACHINE_ARC_TOLERANCE = 20;
+
+/*  struct axisProfile
+    > contains the wiring and the motor settings of an axis
+*/
+struct axisProfile{
+  uint8_t stepPin;
+  uint8_t dirnPin;
+  int stepPerRev;
+  int microstepFactor;
+  int gboxReductionFactor;
+  int gboxIncreaseFactor;
+  int maxSpeed;        //in step per sec
+  int maxAccel;        //in step per sec per sec
+  long maxJerk;        //in step per sec per sec per sec, 0 for a trapezoid ramp
+  long travelPerRev;   //in um per output rev, 0 for a rotary axis
+};
+
+/*  struct axisHoming
+    > contains the limit switch of an axis and how it is homed, see
+      Atrox::home(). the switch closes to ground, the pin is pulled up
+*/
+struct axisHoming{
+  uint8_t limitPin;    //NO_PIN for an axis that is not homed
+  int8_t homeDirn;     //1 to seek toward positive steps, -1 toward negative
+  int seekSpeed;       //in step per sec, to find the switch
+  int latchSpeed;      //in step per sec, to latch it
+  int pullOff;         //in step, backed off the switch before latching and after
+  long seekTravel;     //in step, farthest the switch is looked for
+};
+
+/*  struct axisJog
+    > contains the joystick input of an axis, see Atrox::startJog()
+      the stick reads 0-1023 with its center at 512. past the deadband
+      either side the axis is sped up in proportion, to its max speed at
+      the end of the travel
+*/
+struct axisJog{
+  uint8_t analogPin;   //NO_PIN for an axis without a joystick
+  int8_t jogDirn;      //1 if the stick pushed up moves toward positive steps, -1 if not
+  int deadband;        //in adc counts either side of the center
+};
+
+//one row per axis in Axis order: x, y, z, w, p, r
+#if ATROX_MACHINE == MACHINE_ONE_AXIS
+
+const uint8_t MOTOR_ENABLE_PIN = 8;
+
+//only the p axis is wired, on the shield's y driver. the motor settings
+//of the other axes are kept for when they are
+constexpr axisProfile MACHINE_AXES[] = {
+//  step    dirn    step/rev  micro  reduct  increase  speed  accel   jerk  travel
+  {NO_PIN, NO_PIN,        0,     1,      1,        1,  1000,  1000,      0,     0},  //x axis
+  {NO_PIN, NO_PIN,        0,     1,      1,        1,  1000,  1000,      0,     0},  //y axis
+  {NO_PIN, NO_PIN,        0,     1,      1,        1,  1000,  1000,      0,     0},  //z axis
+  {NO_PIN, NO_PIN,      200,     1,      1,        1,  1000,  1000,      0,     0},  //w axis
+  {     3,      6,      200,     1,     50,        1,  1000,  1000,  20000,     0},  //p axis
+  {NO_PIN, NO_PIN,      200,     1,      1,        1,  1000,  1000,      0,     0}}; //r axis
+
+//no limit switches
+constexpr axisHoming MACHINE_HOMING[] = {
+//  limit   dirn   seek  latch  pulloff  travel
+  {NO_PIN,     1,     0,     0,       0,      0},  //x axis
+  {NO_PIN,     1,     0,     0,       0,      0},  //y axis
+  {NO_PIN,     1,     0,     0,       0,      0},  //z axis
+  {NO_PIN,     1,     0,     0,       0,      0},  //w axis
+  {NO_PIN,     1,     0,     0,       0,      0},  //p axis
+  {NO_PIN,     1,     0,     0,       0,      0}}; //r axis
+
+//no joystick
+constexpr axisJog MACHINE_JOG[] = {
+//  analog  dirn  deadband
+  {NO_PIN,     1,       0},  //x axis
+  {NO_PIN,     1,       0},  //y axis
+  {NO_PIN,     1,       0},  //z axis
+  {NO_PIN,     1,       0},  //w axis
+  {NO_PIN,     1,       0},  //p axis
+  {NO_PIN,     1,       0}}; //r axis
+
+//no x, y, z carriage, the tool only turns
+const long MACHINE_TOOL_LENGTH = 0; //in um
+
+//the board cannot join a cell
+const uint8_t MACHINE_SYNC_PIN = NO_PIN;
+
+#elif ATROX_MACHINE == MACHINE_SIX_AXIS
+
+//PLACEHOLDER WIRING, not a rig that exists: check every pin against the
+//board before flashing. w, p, r are on the shield's x, y, z drivers, the
+//x, y, z pins, their step/rev and travel, and every limit switch below are
+//made up to try the six axis kinematics on the host. on a CNC Shield V3
+//D12/D13 are the spindle outputs and A0-A3 the abort, hold, resume and
+//coolant inputs
+const uint8_t MOTOR_ENABLE_PIN = 8;
+
+constexpr axisProfile MACHINE_AXES[] = {
+//  step    dirn    step/rev  micro  reduct  increase  speed  accel   jerk  travel
+  {    12,     13,      200,     1,      1,        1,  1000,  1000,      0,  8000},  //x axis
+  {    14,     15,      200,     1,      1,        1,  1000,  1000,      0,  8000},  //y axis
+  {    16,     17,      200,     1,      1,        1,  1000,  1000,      0,  8000},  //z axis
+  {     2,      5,      200,     1,      1,        1,  1000,  1000,      0,     0},  //w axis
+  {     3,      6,      200,     1,     50,        1,  1000,  1000,  20000,     0},  //p axis
+  {     4,      7,      200,     1,      1,        1,  1000,  1000,      0,     0}}; //r axis
+
+//placeholders as well, the roll axis turns freely
+constexpr axisHoming MACHINE_HOMING[] = {
+//  limit   dirn   seek  latch  pulloff  travel
+  {    18,    -1,   800,   100,      50,  16000},  //x axis
+  {    19,    -1,   800,   100,      50,  16000},  //y axis
+  {    11,     1,   800,   100,      50,  16000},  //z axis
+  {     9,     1,   800,   100,      20,    250},  //w axis
+  {    10,    -1,   800,   100,      50,  10000},  //p axis
+  {NO_PIN,     1,     0,     0,       0,      0}}; //r axis
+
+//every pin of the shield is taken, the joystick is on the two axis head
+constexpr axisJog MACHINE_JOG[] = {
+//  analog  dirn  deadband
+  {NO_PIN,     1,       0},  //x axis
+  {NO_PIN,     1,       0},  //y axis
+  {NO_PIN,     1,       0},  //z axis
+  {NO_PIN,     1,       0},  //w axis
+  {NO_PIN,     1,       0},  //p axis
+  {NO_PIN,     1,       0}}; //r axis
+
+//the head hangs from the z carriage, the tool tip is this far from the
+//pitch axis, see kinematics.h. a placeholder as well
+const long MACHINE_TOOL_LENGTH = 60000; //in um
+
+//every pin of the shield is taken, the board cannot join a cell
+const uint8_t MACHINE_SYNC_PIN = NO_PIN;
+
+#elif ATROX_MACHINE == MACHINE_TWO_AXIS
+
+const uint8_t MOTOR_ENABLE_PIN = 8;
+
+constexpr axisProfile MACHINE_AXES[] = {
+//  step    dirn    step/rev  micro  reduct  increase  speed  accel   jerk  travel
+  {NO_PIN, NO_PIN,        0,     1,      1,        1,     0,     0,      0,     0},  //x axis
+  {NO_PIN, NO_PIN,        0,     1,      1,        1,     0,     0,      0,     0},  //y axis
+  {NO_PIN, NO_PIN,        0,     1,      1,        1,     0,     0,      0,     0},  //z axis
+  {     2,      5,      200,     1,      1,        1,  1000,  1000,      0,     0},  //w axis
+  {     3,      6,      200,     1,     50,        1,  1000,  1000,  20000,     0},  //p axis
+  {NO_PIN, NO_PIN,        0,     1,      1,        1,     0,     0,      0,     0}}; //r axis
+
+constexpr axisHoming MACHINE_HOMING[] = {
+//  limit   dirn   seek  latch  pulloff  travel
+  {NO_PIN,     1,     0,     0,       0,      0},  //x axis
+  {NO_PIN,     1,     0,     0,       0,      0},  //y axis
+  {NO_PIN,     1,     0,     0,       0,      0},  //z axis
+  {     9,     1,   800,   100,      20,    250},  //w axis
+  {    10,    -1,   800,   100,      50,  10000},  //p axis
+  {NO_PIN,     1,     0,     0,       0,      0}}; //r axis
+
+//a two axis stick on A0 and A1, the abort and hold inputs of the shield
+constexpr axisJog MACHINE_JOG[] = {
+//  analog  dirn  deadband
+  {NO_PIN,     1,       0},  //x axis
+  {NO_PIN,     1,       0},  //y axis
+  {NO_PIN,     1,       0},  //z axis
+  {    14,     1,      24},  //w axis
+  {    15,    -1,      24},  //p axis
+  {NO_PIN,     1,       0}}; //r axis
+
+//no x, y, z carriage, the tool only turns
+const long MACHINE_TOOL_LENGTH = 0; //in um
+
+//the sync line of a cell, on the shield's r step pin, see stream.h
+const uint8_t MACHINE_SYNC_PIN = 4;
+
+#else
+#error "unknown ATROX_MACHINE"
+#endif
+
+/*  constexpr bool isAxisUsed(const int axis)
+    > checks whether an axis is wired in the machine profile
+      code for an unused axis is dropped by the compiler
+    args:
+      const int axis: the axis
+    returns true if the axis has a step pin
+*/
+constexpr bool isAxisUsed(const int axis){
+  return MACHINE_AXES[axis].stepPin != NO_PIN;
+} //end isAxisUsed(const int)
+
+/*  constexpr bool isAxisHomed(const int axis)
+    > checks whether an axis of the machine profile has a limit switch
+    args:
+      const int axis: the axis
+    returns true if the axis can be homed
+*/
+constexpr bool isAxisHomed(const int axis){
+  return isAxisUsed(axis) && MACHINE_HOMING[axis].limitPin != NO_PIN;
+} //end isAxisHomed(const int)
+
+/*  constexpr bool isAxisJogged(const int axis)
+    > checks whether an axis of the machine profile has a joystick
+    args:
+      const int axis: the axis
+    returns true if the axis can be jogged
+*/
+constexpr bool isAxisJogged(const int axis){
+  return isAxisUsed(axis) && MACHINE_JOG[axis].analogPin != NO_PIN;
+} //end isAxisJogged(const int)
+
+/*  constexpr bool isSyncWired()
+    > checks whether the machine profile has a sync pin, the board can
+      then step a stream in lockstep with other boards of a cell
+    no args
+    returns true if the sync pin is wired
+*/
+constexpr bool isSyncWired(){
+  return MACHINE_SYNC_PIN != NO_PIN;
+} //end isSyncWired()
+
+/*  constexpr uint8_t machineAxisBits(const int axis)
+    > gets the axes wired in the machine profile
+    args:
+      const int axis: first axis, 0 for all of them
+    returns bit set for each axis used from axis on
+*/
+constexpr uint8_t machineAxisBits(const int axis = 0){
+  return axis < (int)(sizeof(MACHINE_AXES) / sizeof(MACHINE_AXES[0]))
+         ? (isAxisUsed(axis) ? 1 << axis : 0) | machineAxisBits(axis + 1) : 0;
+} //end machineAxisBits(const int)
+
+#endif //_MACHINE_H
@@ -0,0 +1,332 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// planner.cpp                                                               //
+//                                                                           //
+// Description:                                                              //
+//      This is the implementation file for the look-ahead motion planner.   //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <Arduino.h>
+
+#include "planner.h"
+#include "stepper.h"
+
+
+/*  Planner constructor Planner()
+    > constructs an empty planner
+      axis limits must be set with setAxisLimits() before queueing moves
+*/
+Planner::Planner(){
+} //end Planner::Planner()
+
+
+/*  void Planner::setAxisLimits(const int axis, const float maxSpeed, const float maxAccel, const float maxJerk)
+    > sets the limits a planned move must respect on an axis
+    args:
+      const int axis: the axis to limit
+      const float maxSpeed: max speed in step per sec
+      const float maxAccel: max acceleration in step per sec per sec
+      const float maxJerk: max jerk in step per sec per sec per sec
+                           0 leaves the axis on trapezoid ramps
+    returns nothing
+*/
+void Planner::setAxisLimits(const int axis, const float maxSpeed, const float maxAccel, const float maxJerk){
+  axisMaxSpeed[axis] = maxSpeed;
+  axisMaxAccel[axis] = maxAccel;
+  axisMaxJerk[axis] = maxJerk;
+  return;
+} //end Planner::setAxisLimits(const int, const float, const float, const float)
+
+
+/*  bool Planner::bufferLine(const long steps[], const float speed, const float accel, const float jerk,
+                             const bool isToolPath)
+    > plans a straight move and appends it to the buffer
+      the whole buffer is replanned so the move blends with the previous one
+      the move gets s-curve ramps if it asks for a jerk or if one of its
+      axes has a jerk limit, the lowest of them is taken
+      the junction is taken at the speed GRBL's junction deviation allows,
+      capped so that no axis changes speed by more than its acceleration
+      allows over one segment, a change the segments make anyway. an axis
+      with a jerk limit, or any axis of a move with a jerk, is capped to
+      the change its jerk allows over one segment from no acceleration
+    args:
+      const long steps[]: signed amount of steps per axis
+      const float speed: requested path speed in step per sec
+                         0 uses the fastest speed the axes allow
+      const float accel: requested path acceleration in step per sec per sec
+                         0 uses the highest acceleration the axes allow
+      const float jerk: requested path jerk in step per sec per sec per sec
+                        0 uses the jerk limit of the axes, if any
+      const bool isToolPath: true to step the move along the straight
+                             line of the tool tip, see planBlock
+    returns true if the move was queued
+      false if the buffer is full or the move is empty
+*/
+bool Planner::bufferLine(const long steps[], const float speed, const float accel, const float jerk,
+                         const bool isToolPath){
+  if(isFull()) return false;
+
+  planBlock& block = blockBuffer[head];
+  block = planBlock();
+  block.isToolPath = isToolPath;
+
+  float lengthSqr{};
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    block.steps[axis] = steps[axis];
+    block.stepEventCount = max(block.stepEventCount, labs(steps[axis]));
+    lengthSqr += (float)steps[axis] * steps[axis];
+  }
+  if(block.stepEventCount == 0) return false;
+  block.length = sqrt(lengthSqr);
+
+  //limit path speed and acceleration so that no axis exceeds its own
+  float unitVec[AXIS_COUNT];
+  float maxSpeed{speed};
+  float maxAccel{accel};
+  float maxJerk{jerk};
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    unitVec[axis] = steps[axis] / block.length;
+    if(steps[axis] != 0){
+      float axisRatio = fabs(unitVec[axis]);
+      float axisSpeed = axisMaxSpeed[axis] / axisRatio;
+      float axisAccel = axisMaxAccel[axis] / axisRatio;
+      if(maxSpeed <= 0 || axisSpeed < maxSpeed) maxSpeed = axisSpeed;
+      if(maxAccel <= 0 || axisAccel < maxAccel) maxAccel = axisAccel;
+      if(axisMaxJerk[axis] > 0){
+        float axisJerk = axisMaxJerk[axis] / axisRatio;
+        if(maxJerk <= 0 || axisJerk < maxJerk) maxJerk = axisJerk;
+      }
+    }
+  }
+  block.nominalSpeedSqr = maxSpeed * maxSpeed;
+  block.acceleration = maxAccel;
+  block.jerk = max(maxJerk, 0.0f);
+
+  //junction speed with the previous move, by junction deviation and by
+  //the speed change of each axis. an idle machine always starts from rest
+  if(isEmpty()){
+    block.maxEntrySpeedSqr = 0;
+  }else{
+    float junctionCosTheta{};
+    for(int axis{}; axis < AXIS_COUNT; axis++){
+      junctionCosTheta -= prevUnitVec[axis] * unitVec[axis];
+    }
+
+    if(junctionCosTheta > 0.999999){ //full reversal
+      block.maxEntrySpeedSqr = MIN_JUNCTION_SPEED * MIN_JUNCTION_SPEED;
+    }else if(junctionCosTheta < -0.999999){ //straight line
+      block.maxEntrySpeedSqr = block.nominalSpeedSqr;
+    }else{
+      float sinThetaD2 = sqrt(0.5 * (1.0 - junctionCosTheta));
+      block.maxEntrySpeedSqr = max(MIN_JUNCTION_SPEED * MIN_JUNCTION_SPEED,
+                                   (block.acceleration * JUNCTION_DEVIATION * sinThetaD2) / (1.0 - sinThetaD2));
+    }
+    block.maxEntrySpeedSqr = min(block.maxEntrySpeedSqr, min(block.nominalSpeedSqr, prevNominalSpeedSqr));
+
+    //an axis turning by unitVec - prevUnitVec changes speed at once by that
+    //times the junction speed
+    for(int axis{}; axis < AXIS_COUNT; axis++){
+      float turn = fabs(unitVec[axis] - prevUnitVec[axis]);
+      if(turn <= 0) continue;
+      float axisChange = axisMaxAccel[axis] / SEGMENTS_PER_SEC;
+      float axisJerk = axisMaxJerk[axis] > 0 ? axisMaxJerk[axis] : block.jerk;
+      if(axisJerk > 0){
+        axisChange = min(axisChange, axisJerk / (2 * SEGMENTS_PER_SEC * SEGMENTS_PER_SEC));
+      }
+      float axisSpeed = axisChange / turn;
+      block.maxEntrySpeedSqr = min(block.maxEntrySpeedSqr, axisSpeed * axisSpeed);
+    }
+  }
+
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    prevUnitVec[axis] = unitVec[axis];
+  }
+  prevNominalSpeedSqr = block.nominalSpeedSqr;
+
+  head = nextIndex(head);
+  recalculate();
+  return true;
+} //end Planner::bufferLine(const long[], const float, const float, const float, const bool)
+
+
+/*  planBlock* Planner::currentBlock()
+    > gets the oldest queued block, which is the one to be executed
+    no args
+    returns pointer to the block, nullptr if the buffer is empty
+*/
+planBlock* Planner::currentBlock(){
+  if(isEmpty()) return nullptr;
+  return &blockBuffer[tail];
+} //end Planner::currentBlock()
+
+
+/*  void Planner::discardCurrentBlock()
+    > removes the oldest block once the motion layer is done with it
+    no args
+    returns nothing
+*/
+void Planner::discardCurrentBlock(){
+  if(isEmpty()) return;
+  if(tail == planned) planned = nextIndex(planned);
+  tail = nextIndex(tail);
+  return;
+} //end Planner::discardCurrentBlock()
+
+
+/*  float Planner::exitSpeedSqr()
+    > gets the speed the current block should be left at
+      this is the entry speed of the next block, and may rise as moves are queued
+    no args
+    returns the exit speed, squared. 0 if no block follows
+*/
+float Planner::exitSpeedSqr(){
+  int nextBlock = nextIndex(tail);
+  if(isEmpty() || nextBlock == head) return 0;
+  return blockBuffer[nextBlock].entrySpeedSqr;
+} //end Planner::exitSpeedSqr()
+
+
+/*  void Planner::clear()
+    > drops every queued block, the next move is planned from rest
+    no args
+    returns nothing
+*/
+void Planner::clear(){
+  tail = head;
+  planned = head;
+  for(int axis{}; axis < AXIS_COUNT; axis++) prevUnitVec[axis] = 0;
+  prevNominalSpeedSqr = 0;
+  return;
+} //end Planner::clear()
+
+
+/*  bool Planner::isEmpty()
+    > checks whether no block is queued
+    no args
+    returns true if the buffer is empty
+*/
+bool Planner::isEmpty(){
+  return head == tail;
+} //end Planner::isEmpty()
+
+
+/*  bool Planner::isFull()
+    > checks whether no more block can be queued
+    no args
+    returns true if the buffer is full
+*/
+bool Planner::isFull(){
+  return nextIndex(head) == tail;
+} //end Planner::isFull()
+
+
+/*  int Planner::blockCount()
+    > gets the number of blocks queued, the current one included
+    no args
+    returns the number of blocks
+*/
+int Planner::blockCount(){
+  return (head + PLANNER_BUFFER_SIZE - tail) % PLANNER_BUFFER_SIZE;
+} //end Planner::blockCount()
+
+
+/*  protected int Planner::nextIndex(const int index)
+    > gets the ring buffer index after the given one
+    args:
+      const int index: ring buffer index
+    returns the next index
+*/
+int Planner::nextIndex(const int index){
+  return (index + 1) % PLANNER_BUFFER_SIZE;
+} //end Planner::nextIndex(const int)
+
+
+/*  protected int Planner::prevIndex(const int index)
+    > gets the ring buffer index before the given one
+    args:
+      const int index: ring buffer index
+    returns the previous index
+*/
+int Planner::prevIndex(const int index){
+  return (index + PLANNER_BUFFER_SIZE - 1) % PLANNER_BUFFER_SIZE;
+} //end Planner::prevIndex(const int)
+
+
+/*  protected void Planner::recalculate()
+    > replans the entry speeds of the queued blocks
+      the reverse pass makes every block able to slow down to the next one,
+      starting from rest at the newest block. the forward pass then caps
+      every entry speed at what the previous block can accelerate to.
+      blocks up to Planner::planned are optimal and skipped
+    no args
+    returns nothing
+*/
+void Planner::recalculate(){
+  int blockIndex = prevIndex(head);
+  if(blockIndex == planned) return; //only one plannable block
+
+  //reverse pass
+  planBlock* current = &blockBuffer[blockIndex];
+  planBlock* next;
+  current->entrySpeedSqr = min(current->maxEntrySpeedSqr, reachableSpeedSqr(current, 0));
+
+  blockIndex = prevIndex(blockIndex);
+  while(blockIndex != planned){
+    next = current;
+    current = &blockBuffer[blockIndex];
+    blockIndex = prevIndex(blockIndex);
+
+    if(current->entrySpeedSqr != current->maxEntrySpeedSqr){
+      float entrySpeedSqr = reachableSpeedSqr(current, next->entrySpeedSqr);
+      current->entrySpeedSqr = min(entrySpeedSqr, current->maxEntrySpeedSqr);
+    }
+  }
+
+  //forward pass
+  next = &blockBuffer[planned];
+  blockIndex = nextIndex(planned);
+  while(blockIndex != head){
+    current = next;
+    next = &blockBuffer[blockIndex];
+
+    if(current->entrySpeedSqr < next->entrySpeedSqr){
+      float entrySpeedSqr = reachableSpeedSqr(current, current->entrySpeedSqr);
+      if(entrySpeedSqr < next->entrySpeedSqr){
+        next->entrySpeedSqr = entrySpeedSqr;
+        planned = blockIndex; //accelerating the whole way, cannot improve
+      }
+    }
+    if(next->entrySpeedSqr == next->maxEntrySpeedSqr){
+      planned = blockIndex; //at its junction limit, cannot improve
+    }
+    blockIndex = nextIndex(blockIndex);
+  }
+  return;
+} //end Planner::recalculate()
+
+
+/*  protected float Planner::reachableSpeedSqr(const planBlock* block, const float speedSqr)
+    > gets the highest speed a block can change to from a speed over its
+      length, either way, ie the speed it can be entered at to brake down
+      to the given one or the speed it can reach from it
+      on a trapezoid ramp this is v^2 = v0^2 + 2*a*d. an s-curve ramp
+      from v0 to v takes (v0 + v)/2 * ((v - v0)/a + a/j) at most, solved
+      for v with c = a^2/j this is v = sqrt(2*a*d + (v0 - c/2)^2) - c/2
+    args:
+      const planBlock* block: the block
+      const float speedSqr: the speed at the other end of the block, squared
+    returns the speed, squared
+*/
+float Planner::reachableSpeedSqr(const planBlock* block, const float speedSqr){
+  if(block->jerk <= 0) return speedSqr + 2 * block->acceleration * block->length;
+  float halfC = block->acceleration * block->acceleration / (2 * block->jerk);
+  float offset = sqrt(speedSqr) - halfC;
+  float speed = sqrt(2 * block->acceleration * block->length + offset * offset) - halfC;
+  return speed * speed;
+} //end Planner::reachableSpeedSqr(const planBlock*, const float)
@@ -0,0 +1,104 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// planner.h                                                                 //
+//                                                                           //
+// Description:                                                              //
+//      This is the header file for the look-ahead motion planner.           //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _PLANNER_H
+#define _PLANNER_H
+
+#include "atrox.h"
+
+//planner settings
+//number of queued moves. must be at least 2 for any look-ahead to happen
+const int PLANNER_BUFFER_SIZE = 8;
+//how far the path may deviate from a sharp corner, in steps.
+//larger values take junctions faster. alone it lets an axis change speed
+//at once by several times what its acceleration allows in a segment, the
+//junction speed is capped for that too, see Planner::bufferLine()
+const float JUNCTION_DEVIATION = 2.0;
+//lowest speed a junction is taken at, in step per sec
+const float MIN_JUNCTION_SPEED = 0.0;
+
+/*  struct planBlock
+    > contains one planned straight move across all axes
+    > speeds are along the path, in step per sec. the path length is
+      the euclidean length of the step vector
+    > a tool path block is planned the same, along the straight line
+      between its end positions. it is stepped along the tool tip's
+      straight line instead, which bows off it the more the head turns
+*/
+struct planBlock{
+  long steps[AXIS_COUNT]{};     //signed steps per axis
+  long stepEventCount{};        //steps of the dominant axis
+  float length{};               //path length in steps
+
+  float acceleration{};         //path acceleration in step per sec per sec
+  float jerk{};                 //path jerk in step per sec per sec per sec, 0 for a trapezoid ramp
+  float nominalSpeedSqr{};      //cruise speed, squared
+  float entrySpeedSqr{};        //planned speed entering the block, squared
+  float maxEntrySpeedSqr{};     //junction limit entering the block, squared
+  bool isToolPath{};            //the tool tip goes straight, see Stepper::prepareToolPath()
+};
+
+/*  class Planner
+    > ring buffer of planned moves sitting between the command parser and
+      the motion layer
+    > every new move replans the buffer so that consecutive moves blend at
+      their junctions instead of stopping, in the style of GRBL's planner
+    > a block with a jerk is stepped along s-curve ramps, it is planned
+      with the longer distance those ramps take to change speed
+    public methods:
+      void setAxisLimits(const int, const float, const float, const float): sets the speed, acceleration and jerk limit of an axis
+      bool bufferLine(const long[], const float, const float, const float, const bool): plans a move and appends it to the buffer
+      planBlock* currentBlock(): gets the oldest block, the one being executed
+      void discardCurrentBlock(): removes the oldest block once executed
+      float exitSpeedSqr(): gets the planned exit speed of the current block, squared
+      void clear(): drops every queued block
+      bool isEmpty(): checks whether no block is queued
+      bool isFull(): checks whether no more block can be queued
+      int blockCount(): gets the number of blocks queued
+    usage:
+      Planner(): initializes an empty planner
+*/
+class Planner{
+  planBlock blockBuffer[PLANNER_BUFFER_SIZE];
+  int tail{};     //oldest block, executed by the motion layer
+  int head{};     //next free slot
+  int planned{};  //blocks up to this one can no longer be improved
+
+  float axisMaxSpeed[AXIS_COUNT]{};
+  float axisMaxAccel[AXIS_COUNT]{};
+  float axisMaxJerk[AXIS_COUNT]{};
+
+  float prevUnitVec[AXIS_COUNT]{};
+  float prevNominalSpeedSqr{};
+
+  public:
+    Planner();
+    void setAxisLimits(const int axis, const float maxSpeed, const float maxAccel, const float maxJerk);
+    bool bufferLine(const long steps[], const float speed, const float accel, const float jerk,
+                    const bool isToolPath);
+    planBlock* currentBlock();
+    void discardCurrentBlock();
+    float exitSpeedSqr();
+    void clear();
+    bool isEmpty();
+    bool isFull();
+    int blockCount();
+  protected:
+    int nextIndex(const int index);
+    int prevIndex(const int index);
+    void recalculate();
+    float reachableSpeedSqr(const planBlock* block, const float speedSqr);
+};
+
+#endif //_PLANNER_H
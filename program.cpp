@@ -0,0 +1,234 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// program.cpp                                                               //
+//                                                                           //
+// Description:                                                              //
+//      This is the implementation file for program mode. It uses the job    //
+//      storage of hal.h.                                                    //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <Arduino.h>
+
+#include "crc.h"
+#include "hal.h"
+#include "program.h"
+
+
+Program program;
+
+
+/*  void Program::beginRecord()
+    > drops the job stored and starts recording the lines sent
+      the job is only valid again once M29 saves it
+    no args
+    returns nothing
+*/
+void Program::beginRecord(){
+  jobHeader header{};
+  halJobWrite(0, &header, sizeof(header));
+  isRecordOn = true;
+  isRecordError = false;
+  recordLength = 0;
+  recordCrc = CRC16_INIT;
+  lineStart = 0;
+  lineStartCrc = CRC16_INIT;
+  lineBytes = 0;
+  isComment = false;
+  isSkip = false;
+  return;
+} //end Program::beginRecord()
+
+
+/*  int Program::record(const char incoming)
+    > stores one byte of a line sent while recording
+      spaces and comments are left out and letters stored in upper case.
+      the line M29 is not stored, it ends the recording and saves the job
+    args:
+      const char incoming: the byte received
+    returns int of record status
+      status -1 indicates the line could not be stored, the job will not be saved
+      status 1 indicates the line was stored, or was empty
+      status 2 indicates the line is not complete yet
+      status 3 indicates the recording ended but the job was not saved
+      status 8 indicates the recording ended and the job was saved
+*/
+int Program::record(const char incoming){
+  if(incoming == '\n') return endLine();
+  if(incoming == '\r' || isSkip) return 2;
+  if(isComment){
+    if(incoming == ')') isComment = false;
+    return 2;
+  }
+  if(incoming == '('){
+    isComment = true;
+  }else if(incoming == ';'){
+    isSkip = true;
+  }else if(!isspace(incoming)){
+    char data = toupper(incoming);
+    if(lineBytes < sizeof(lineHead)) lineHead[lineBytes] = data;
+    if(lineBytes < 0xFF) lineBytes++;
+    storeByte(data);
+  }
+  return 2;
+} //end Program::record(const char)
+
+
+/*  bool Program::isRecording()
+    > checks whether the lines sent are being recorded
+    no args
+    returns true if recording
+*/
+bool Program::isRecording(){
+  return isRecordOn;
+} //end Program::isRecording()
+
+
+/*  bool Program::start()
+    > checks the job stored and starts reading it from its first line
+      the whole job is read once for its crc
+    no args
+    returns true if the job is valid and was started
+*/
+bool Program::start(){
+  jobHeader header;
+  halJobRead(0, &header, sizeof(header));
+  if(header.magic != JOB_MAGIC || header.length > HAL_JOB_SIZE - sizeof(header)) return false;
+
+  uint16_t crc{CRC16_INIT};
+  for(uint16_t address{}; address < header.length; address += JOB_PREFETCH_SIZE){
+    uint8_t count = min((uint16_t)JOB_PREFETCH_SIZE, (uint16_t)(header.length - address));
+    halJobRead(sizeof(header) + address, prefetchBuffer, count);
+    for(uint8_t index{}; index < count; index++) crc = crc16Update(crc, prefetchBuffer[index]);
+  }
+  if(crc != header.crc) return false;
+
+  jobLength = header.length;
+  fetchAddress = 0;
+  prefetchIndex = 0;
+  prefetchCount = 0;
+  line = 0;
+  isRunOn = true;
+  return true;
+} //end Program::start()
+
+
+/*  void Program::end()
+    > stops reading the job
+    no args
+    returns nothing
+*/
+void Program::end(){
+  isRunOn = false;
+  return;
+} //end Program::end()
+
+
+/*  bool Program::isRunning()
+    > checks whether the job is being read
+    no args
+    returns true if a job was started and not ended
+*/
+bool Program::isRunning(){
+  return isRunOn;
+} //end Program::isRunning()
+
+
+/*  void Program::prefetch()
+    > reads the next block of the job once the last one is used up
+      call this while waiting on the planner, so the storage is not read
+      when the next line is wanted
+    no args
+    returns nothing
+*/
+void Program::prefetch(){
+  if(!isRunOn || prefetchIndex < prefetchCount) return;
+  uint8_t count = min((uint16_t)JOB_PREFETCH_SIZE, (uint16_t)(jobLength - fetchAddress));
+  if(count == 0) return;
+  halJobRead(sizeof(jobHeader) + fetchAddress, prefetchBuffer, count);
+  fetchAddress += count;
+  prefetchIndex = 0;
+  prefetchCount = count;
+  return;
+} //end Program::prefetch()
+
+
+/*  int Program::read()
+    > reads the next byte of the job, from the block read ahead
+    no args
+    returns the byte, -1 at the end of the job or if no job runs
+*/
+int Program::read(){
+  if(!isRunOn) return -1;
+  prefetch();
+  if(prefetchIndex >= prefetchCount) return -1;
+  uint8_t data = prefetchBuffer[prefetchIndex++];
+  if(data == '\n') line++;
+  return data;
+} //end Program::read()
+
+
+/*  int Program::lineNumber()
+    > gets the line of the job last read
+    no args
+    returns the line, from 1
+*/
+int Program::lineNumber(){
+  return line;
+} //end Program::lineNumber()
+
+
+/*  protected int Program::endLine()
+    > ends the line being recorded, see record()
+    no args
+    returns int of record status, see record()
+*/
+int Program::endLine(){
+  bool isEndLine = lineBytes == 3 && strncmp(lineHead, "M29", 3) == 0;
+  if(!isEndLine && lineBytes > 0) storeByte('\n');
+  isComment = false;
+  isSkip = false;
+  lineBytes = 0;
+
+  if(isEndLine || isRecordError){
+    //drop the line, the job ends where it started
+    recordLength = lineStart;
+    recordCrc = lineStartCrc;
+  }
+  if(isEndLine){
+    isRecordOn = false;
+    if(isRecordError) return 3;
+    jobHeader header{JOB_MAGIC, recordLength, recordCrc};
+    halJobWrite(0, &header, sizeof(header));
+    return 8;
+  }
+  if(isRecordError) return -1;
+
+  lineStart = recordLength;
+  lineStartCrc = recordCrc;
+  return 1;
+} //end Program::endLine()
+
+
+/*  protected void Program::storeByte(const char data)
+    > appends a byte to the job being recorded
+      a byte that does not fit, or was not printable, fails the job
+    args:
+      const char data: the byte
+    returns nothing
+*/
+void Program::storeByte(const char data){
+  if(recordLength >= HAL_JOB_SIZE - sizeof(jobHeader) || (data != '\n' && !isprint(data))){
+    isRecordError = true;
+    return;
+  }
+  halJobWrite(sizeof(jobHeader) + recordLength, &data, 1);
+  recordCrc = crc16Update(recordCrc, data);
+  recordLength++;
+  return;
+} //end Program::storeByte(const char)
@@ -0,0 +1,105 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// program.h                                                                 //
+//                                                                           //
+// Description:                                                              //
+//      This is the header file for program mode, the job stored on the      //
+//      machine and run from there.                                          //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _PROGRAM_H
+#define _PROGRAM_H
+
+#include <Arduino.h>
+
+/*  job storage, see hal.h
+
+    header: magic | length | crc, then length bytes of g-code
+            crc is CRC-16/CCITT-FALSE over the g-code
+            the header is written last, a job cut short is not valid
+
+    the g-code is kept compact: one command per line, upper case, without
+    spaces, comments or empty lines
+*/
+const uint16_t JOB_MAGIC = 0x10B5;
+
+//bytes read from the storage at once, the reader runs on them while the
+//storage is not touched
+const int JOB_PREFETCH_SIZE = 32;
+
+/*  struct jobHeader
+    > contains the header of the job as stored
+*/
+struct jobHeader{
+  uint16_t magic;
+  uint16_t length;
+  uint16_t crc;
+};
+
+/*  class Program
+    > keeps one g-code job in the job storage and reads it back to run it
+      without the host
+    > M28 starts recording, the lines the host sends until M29 are stored
+      instead of executed. M24 runs the job, program mode then reads its
+      lines in place of the serial port, the lines the host sends wait
+    > the job is read ahead in blocks of JOB_PREFETCH_SIZE bytes between
+      the commands, so a line is loaded as soon as the planner has room
+    public methods:
+      void beginRecord(): drops the job stored and starts recording one
+      int record(const char): stores one byte of a line sent while recording
+      bool isRecording(): checks whether the lines sent are being recorded
+      bool start(): checks the job stored and starts reading it from its first line
+      void end(): stops reading the job
+      bool isRunning(): checks whether the job is being read
+      void prefetch(): reads the next block of the job if the last one was used up
+      int read(): reads the next byte of the job
+      int lineNumber(): gets the line of the job being read, from 1
+    usage:
+      program: the one job, used from the main loop
+*/
+class Program{
+  //recording
+  bool isRecordOn{false};
+  bool isRecordError{false};  //a byte or a line was lost, the job will not be saved
+  uint16_t recordLength{};
+  uint16_t recordCrc{};
+  uint16_t lineStart{};       //crc and length before the line being recorded
+  uint16_t lineStartCrc{};
+  char lineHead[4]{};         //first bytes of the line, to spot M29
+  uint8_t lineBytes{};        //bytes of the line kept, stored or not
+  bool isComment{false};
+  bool isSkip{false};
+
+  //running
+  bool isRunOn{false};
+  uint16_t jobLength{};
+  uint16_t fetchAddress{};
+  uint8_t prefetchBuffer[JOB_PREFETCH_SIZE];
+  uint8_t prefetchIndex{};
+  uint8_t prefetchCount{};
+  int line{};
+
+  public:
+    void beginRecord();
+    int record(const char incoming);
+    bool isRecording();
+    bool start();
+    void end();
+    bool isRunning();
+    void prefetch();
+    int read();
+    int lineNumber();
+  protected:
+    int endLine();
+    void storeByte(const char data);
+};
+
+extern Program program;
+
+#endif //_PROGRAM_H
@@ -0,0 +1,336 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// settings.cpp                                                              //
+//                                                                           //
+// Description:                                                              //
+//      This is the implementation file for the settings kept in the         //
+//      eeprom. It uses the eeprom of hal.h.                                 //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <Arduino.h>
+
+#include "crc.h"
+#include "hal.h"
+#include "settings.h"
+#include "uart.h"
+
+
+/*  static float motorSetting(const motorData& axisMotor, const int setting)
+    > gets a setting of a motor
+    args:
+      const motorData& axisMotor: the motor
+      const int setting: the setting, see MotorSetting
+    returns the value, 0 for an unknown setting
+*/
+static float motorSetting(const motorData& axisMotor, const int setting){
+  switch(setting){
+    case ST_STEP_PER_REV:
+      return axisMotor.stepPerRev;
+    case ST_MICROSTEP:
+      return axisMotor.microstepFactor;
+    case ST_GBOX_REDUCTION:
+      return axisMotor.gboxReductionFactor;
+    case ST_GBOX_INCREASE:
+      return axisMotor.gboxIncreaseFactor;
+    case ST_MAX_SPEED:
+      return axisMotor.maxSpeedStep;
+    case ST_MAX_ACCEL:
+      return axisMotor.maxAccelStep;
+    case ST_TRAVEL_PER_REV:
+      return axisMotor.travelPerRev;
+    case ST_MAX_JERK:
+      return axisMotor.maxJerkStep;
+  }
+  return 0;
+} //end motorSetting(const motorData&, const int)
+
+
+/*  static bool isGearingValid(const motorData& axisMotor)
+    > checks whether the gearing of a motor fits the unit scale, at most
+      256 steps per thousandth of a unit
+    args:
+      const motorData& axisMotor: the motor
+    returns true if it fits
+*/
+static bool isGearingValid(const motorData& axisMotor){
+  uint64_t stepPerRev = (uint64_t)axisMotor.stepPerRev * axisMotor.microstepFactor
+                        * axisMotor.gboxReductionFactor;
+  uint64_t unitPerRev = (uint64_t)max(axisMotor.gboxIncreaseFactor, 1)
+                        * (axisMotor.travelPerRev > 0 ? axisMotor.travelPerRev : 360000UL);
+  if(stepPerRev > 0xFFFFFFFFULL || unitPerRev > 0xFFFFFFFFULL) return false;
+  return ((stepPerRev << UNIT_FRAC_BITS) / unitPerRev) <= 0xFFFFFFFFULL;
+} //end isGearingValid(const motorData&)
+
+
+/*  static void copyStored(const axisSettings& stored, motorData* axisMotor)
+    > copies the motor settings of an axis as stored into a motor
+    args:
+      const axisSettings& stored: the settings in the block
+      motorData* axisMotor: the motor
+    returns nothing
+*/
+static void copyStored(const axisSettings& stored, motorData* axisMotor){
+  axisMotor->stepPerRev = stored.stepPerRev;
+  axisMotor->microstepFactor = stored.microstepFactor;
+  axisMotor->gboxReductionFactor = stored.gboxReductionFactor;
+  axisMotor->gboxIncreaseFactor = stored.gboxIncreaseFactor;
+  axisMotor->maxSpeedStep = stored.maxSpeed;
+  axisMotor->maxAccelStep = stored.maxAccel;
+  axisMotor->travelPerRev = stored.travelPerRev;
+  axisMotor->maxJerkStep = stored.maxJerk;
+  return;
+} //end copyStored(const axisSettings&, motorData*)
+
+
+/*  static bool isBlockValid(const settingsBlock& block, Atrox* atroxPtr)
+    > checks every field of a block that checked out, each motor setting
+      of the axes used as M561-M568 would, and the modes and tolerance
+    args:
+      const settingsBlock& block: the block
+      Atrox* atroxPtr: address of the system
+    returns true if every field can be loaded
+*/
+static bool isBlockValid(const settingsBlock& block, Atrox* atroxPtr){
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(!isAxisUsed(axis)) continue;
+    motorData checked = atroxPtr->motor[axis];
+    copyStored(block.axis[axis], &checked);
+    for(int setting{}; setting < SETTING_COUNT; setting++){
+      if(!isSettingValid(setting, motorSetting(checked, setting))) return false;
+    }
+    if(!isGearingValid(checked)) return false;
+  }
+  return (block.posMode == ABSOLUTE_POS || block.posMode == RELATIVE_POS)
+         && (block.linUnit == MM || block.linUnit == IN)
+         && (block.angUnit == STEP || block.angUnit == DEGREE)
+         && block.arcTolerance >= 1 && block.arcTolerance <= 1000;
+} //end isBlockValid(const settingsBlock&, Atrox*)
+
+
+/*  int settingsLoad(Atrox* atroxPtr)
+    > reads the settings block from the eeprom and loads it into the
+      motion tables of the system, the unit scales are derived once here
+      a block that does not check out, or was saved by another machine
+      profile, is not loaded and the settings in use are kept. a block
+      with a field out of range is not loaded either, the settings of
+      the machine profile are restored
+    args:
+      Atrox* atroxPtr: address of the system
+    returns int of load status
+      status -1 indicates no valid block, nothing was loaded
+      status 1 indicates the block was loaded
+*/
+int settingsLoad(Atrox* atroxPtr){
+  settingsBlock block;
+  halEepromRead(SETTINGS_ADDRESS, &block, sizeof(block));
+  if(block.magic != SETTINGS_MAGIC || block.version != SETTINGS_VERSION
+     || block.size != sizeof(block)){
+    return -1;
+  }
+  if(crc16((const uint8_t*)&block, offsetof(settingsBlock, crc)) != block.crc) return -1;
+  if(block.machine != ATROX_MACHINE || block.axisBits != machineAxisBits()) return -1;
+  if(!isBlockValid(block, atroxPtr)){
+    atroxPtr->loadProfile();
+    return -1;
+  }
+
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(!isAxisUsed(axis)) continue;
+    copyStored(block.axis[axis], &atroxPtr->motor[axis]);
+    atroxPtr->setupAxis((Axis)axis);
+  }
+  atroxPtr->posMode = (PosMode)block.posMode;
+  atroxPtr->linUnit = (LinUnit)block.linUnit;
+  atroxPtr->angUnit = (AngUnit)block.angUnit;
+  atroxPtr->arcTolerance = block.arcTolerance;
+  return 1;
+} //end settingsLoad(Atrox*)
+
+
+/*  void settingsSave(Atrox* atroxPtr)
+    > saves the settings in use to the eeprom
+      only the bytes that change are written, saving the same settings
+      again does not wear the eeprom
+      writing a byte takes about 3.4ms, this blocks while it writes
+    args:
+      Atrox* atroxPtr: address of the system
+    returns nothing
+*/
+void settingsSave(Atrox* atroxPtr){
+  settingsBlock block;
+  memset(&block, 0, sizeof(block)); //padding is covered by the crc
+  block.magic = SETTINGS_MAGIC;
+  block.version = SETTINGS_VERSION;
+  block.size = sizeof(block);
+  block.machine = ATROX_MACHINE;
+  block.axisBits = machineAxisBits();
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    const motorData& axisMotor = atroxPtr->motor[axis];
+    axisSettings& stored = block.axis[axis];
+    stored.stepPerRev = axisMotor.stepPerRev;
+    stored.microstepFactor = axisMotor.microstepFactor;
+    stored.gboxReductionFactor = axisMotor.gboxReductionFactor;
+    stored.gboxIncreaseFactor = axisMotor.gboxIncreaseFactor;
+    stored.maxSpeed = axisMotor.maxSpeedStep;
+    stored.maxAccel = axisMotor.maxAccelStep;
+    stored.travelPerRev = axisMotor.travelPerRev;
+    stored.maxJerk = axisMotor.maxJerkStep;
+  }
+  block.posMode = atroxPtr->posMode;
+  block.linUnit = atroxPtr->linUnit;
+  block.angUnit = atroxPtr->angUnit;
+  block.arcTolerance = atroxPtr->arcTolerance;
+  block.crc = crc16((const uint8_t*)&block, offsetof(settingsBlock, crc));
+  halEepromWrite(SETTINGS_ADDRESS, &block, sizeof(block));
+  return;
+} //end settingsSave(Atrox*)
+
+
+/*  void settingsReset(Atrox* atroxPtr)
+    > restores the settings of the machine profile, the eeprom is left
+      as it is until settingsSave()
+    args:
+      Atrox* atroxPtr: address of the system
+    returns nothing
+*/
+void settingsReset(Atrox* atroxPtr){
+  atroxPtr->loadProfile();
+  return;
+} //end settingsReset(Atrox*)
+
+
+/*  bool isSettingValid(const int setting, const float val)
+    > checks whether a value can be given to a setting
+      counts are whole and from 1 to 32767, limits above 0, jerk and
+      travel not negative and travel whole
+    args:
+      const int setting: the setting, see MotorSetting
+      const float val: the value
+    returns true if the value is valid
+*/
+bool isSettingValid(const int setting, const float val){
+  if(!isfinite(val)) return false;
+  switch(setting){
+    case ST_STEP_PER_REV:
+    case ST_MICROSTEP:
+    case ST_GBOX_REDUCTION:
+    case ST_GBOX_INCREASE:
+      return val >= 1 && val <= 32767 && val == floor(val);
+    case ST_MAX_SPEED:
+    case ST_MAX_ACCEL:
+      return val > 0;
+    case ST_TRAVEL_PER_REV:
+      return val >= 0 && val <= 2000000000.0 && val == floor(val);
+    case ST_MAX_JERK:
+      return val >= 0;
+  }
+  return false;
+} //end isSettingValid(const int, const float)
+
+
+/*  bool settingsWrite(Atrox* atroxPtr, const int setting, const Axis axis, const float val)
+    > changes a setting of an axis in use, the unit scales and limits of
+      the axis are derived again. the eeprom is not written
+      a value is refused if the gearing it makes does not fit the unit
+      scale, over 256 steps per thousandth of a unit
+    args:
+      Atrox* atroxPtr: address of the system
+      const int setting: the setting, see MotorSetting
+      const Axis axis: the axis
+      const float val: the value
+    returns true if the setting was changed
+*/
+bool settingsWrite(Atrox* atroxPtr, const int setting, const Axis axis, const float val){
+  if(!isSettingValid(setting, val)) return false;
+  motorData& axisMotor = atroxPtr->motor[axis];
+  motorData changed = axisMotor;
+  switch(setting){
+    case ST_STEP_PER_REV:
+      changed.stepPerRev = val;
+      break;
+    case ST_MICROSTEP:
+      changed.microstepFactor = val;
+      break;
+    case ST_GBOX_REDUCTION:
+      changed.gboxReductionFactor = val;
+      break;
+    case ST_GBOX_INCREASE:
+      changed.gboxIncreaseFactor = val;
+      break;
+    case ST_MAX_SPEED:
+      changed.maxSpeedStep = val;
+      break;
+    case ST_MAX_ACCEL:
+      changed.maxAccelStep = val;
+      break;
+    case ST_TRAVEL_PER_REV:
+      changed.travelPerRev = val;
+      break;
+    case ST_MAX_JERK:
+      changed.maxJerkStep = val;
+      break;
+  }
+
+  if(!isGearingValid(changed)) return false;
+
+  axisMotor = changed;
+  atroxPtr->setupAxis(axis);
+  return true;
+} //end settingsWrite(Atrox*, const int, const Axis, const float)
+
+
+/*  float settingsRead(Atrox* atroxPtr, const int setting, const Axis axis)
+    > gets a setting of an axis in use
+    args:
+      Atrox* atroxPtr: address of the system
+      const int setting: the setting, see MotorSetting
+      const Axis axis: the axis
+    returns the value, 0 for an unknown setting
+*/
+float settingsRead(Atrox* atroxPtr, const int setting, const Axis axis){
+  return motorSetting(atroxPtr->motor[axis], setting);
+} //end settingsRead(Atrox*, const int, const Axis)
+
+
+/*  void settingsReport(Atrox* atroxPtr)
+    > prints the settings in use as the g-code that sets them, a line
+      per setting with the axes of the machine profile, eg
+        G91
+        G21
+        G220
+        M570 S20
+        M561 W200 P200
+    args:
+      Atrox* atroxPtr: address of the system
+    returns nothing
+*/
+void settingsReport(Atrox* atroxPtr){
+  uart.println(atroxPtr->posMode == ABSOLUTE_POS ? F("G90") : F("G91"));
+  uart.println(atroxPtr->linUnit == IN ? F("G20") : F("G21"));
+  uart.println(atroxPtr->angUnit == DEGREE ? F("G221") : F("G220"));
+  uart.print(F("M570 S"));
+  uart.println(atroxPtr->arcTolerance);
+  for(int setting{}; setting < SETTING_COUNT; setting++){
+    uart.print('M');
+    uart.print(SETTING_FIRST_MCODE + setting);
+    for(int axis{}; axis < AXIS_COUNT; axis++){
+      if(!isAxisUsed(axis)) continue;
+      float val = settingsRead(atroxPtr, setting, (Axis)axis);
+      uart.print(' ');
+      uart.print(AXIS_LETTER[axis]);
+      if(setting == ST_MAX_SPEED || setting == ST_MAX_ACCEL || setting == ST_MAX_JERK){
+        uart.print(val);
+      }else{
+        uart.print((long)val);
+      }
+    }
+    uart.println();
+  }
+  return;
+} //end settingsReport(Atrox*)
@@ -0,0 +1,93 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// settings.h                                                                //
+//                                                                           //
+// Description:                                                              //
+//      This is the header file for the settings kept in the eeprom.         //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _SETTINGS_H
+#define _SETTINGS_H
+
+#include <Arduino.h>
+
+#include "atrox.h"
+#include "hal.h"
+
+//settings block, at the start of the eeprom
+const uint16_t SETTINGS_ADDRESS = 0;
+const uint16_t SETTINGS_MAGIC = 0xA7C5;
+//bump when settingsBlock changes, older blocks are then not loaded
+const uint8_t SETTINGS_VERSION = 4;
+
+//motor settings that can be changed at run time, set with M561 to M568
+enum MotorSetting {ST_STEP_PER_REV, ST_MICROSTEP, ST_GBOX_REDUCTION, ST_GBOX_INCREASE,
+                   ST_MAX_SPEED, ST_MAX_ACCEL, ST_TRAVEL_PER_REV, ST_MAX_JERK};
+const int SETTING_COUNT = 8;
+const int SETTING_FIRST_MCODE = 561;
+
+/*  struct axisSettings
+    > contains the motor settings of an axis as stored in the eeprom
+*/
+struct axisSettings{
+  int16_t stepPerRev;
+  int16_t microstepFactor;
+  int16_t gboxReductionFactor;
+  int16_t gboxIncreaseFactor;
+  float maxSpeed;         //in step per sec
+  float maxAccel;         //in step per sec per sec
+  int32_t travelPerRev;   //in um per output rev, 0 for a rotary axis
+  float maxJerk;          //in step per sec per sec per sec, 0 for trapezoid ramps
+};
+
+/*  struct settingsBlock
+    > contains the settings as stored in the eeprom
+      the block is taken only if its magic, version, size and crc match
+      and it was saved by a build of the same machine profile, with the
+      same axes
+*/
+struct settingsBlock{
+  uint16_t magic;
+  uint8_t version;
+  uint8_t size;                    //sizeof(settingsBlock)
+  uint8_t machine;                 //ATROX_MACHINE of the build that saved it
+  uint8_t axisBits;                //machineAxisBits() of that build
+  axisSettings axis[AXIS_COUNT];
+  uint8_t posMode;
+  uint8_t linUnit;
+  uint8_t angUnit;
+  int32_t arcTolerance;            //in um
+  uint16_t crc;                    //CRC-16 of the bytes before it
+};
+static_assert(SETTINGS_ADDRESS + sizeof(settingsBlock) <= HAL_JOB_ADDRESS,
+              "the settings block runs into the job storage, see HAL_JOB_ADDRESS");
+static_assert(sizeof(settingsBlock) <= 0xFF, "the settings block is too long for settingsBlock::size");
+
+/*  settings
+      int settingsLoad(Atrox*): loads the block from the eeprom into the motion tables
+      void settingsSave(Atrox*): saves the settings in use to the eeprom
+      void settingsReset(Atrox*): restores the settings of the machine profile, the eeprom is left as it is
+      bool isSettingValid(const int, const float): checks whether a value can be given to a setting
+      bool settingsWrite(Atrox*, const int, const Axis, const float): changes a setting of an axis
+      float settingsRead(Atrox*, const int, const Axis): gets a setting of an axis
+      void settingsReport(Atrox*): prints the settings in use as the g-code setting them
+
+    the settings in use are the motion tables of Atrox, in ram. the eeprom
+    is only read at boot and on settingsLoad(), and only written on
+    settingsSave()
+*/
+int settingsLoad(Atrox* atroxPtr);
+void settingsSave(Atrox* atroxPtr);
+void settingsReset(Atrox* atroxPtr);
+bool isSettingValid(const int setting, const float val);
+bool settingsWrite(Atrox* atroxPtr, const int setting, const Axis axis, const float val);
+float settingsRead(Atrox* atroxPtr, const int setting, const Axis axis);
+void settingsReport(Atrox* atroxPtr);
+
+#endif //_SETTINGS_H
@@ -0,0 +1,171 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// stats.cpp                                                                 //
+//                                                                           //
+// Description:                                                              //
+//      This is the implementation file for the statistics counters.         //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <Arduino.h>
+
+#include "hal.h"
+#include "stats.h"
+#include "uart.h"
+
+
+Stats stats;
+
+
+/*  void Stats::lineParsed(const unsigned long startAt)
+    > times the loading of a command, which then waits to be executed
+    args:
+      const unsigned long startAt: micros() the loading started at
+    returns nothing
+*/
+void Stats::lineParsed(const unsigned long startAt){
+  loadedAt = micros();
+  addTime(&parseTime, loadedAt - startAt);
+  return;
+} //end Stats::lineParsed(const unsigned long)
+
+
+/*  void Stats::commandExecuted(const unsigned long startAt)
+    > times a command waiting since it was loaded, for room in the planner
+      or the moves to end, and executing
+    args:
+      const unsigned long startAt: micros() Command::execute() was called at
+    returns nothing
+*/
+void Stats::commandExecuted(const unsigned long startAt){
+  lineCount++;
+  addTime(&waitTime, startAt - loadedAt);
+  addTime(&executeTime, micros() - startAt);
+  return;
+} //end Stats::commandExecuted(const unsigned long)
+
+
+/*  void Stats::sample(const int depth, const bool isMoving)
+    > takes the number of blocks in the planner, and times the motion from
+      the axes starting until they are all at rest. micros() is read only
+      when the motion starts or ends
+    args:
+      const int depth: blocks queued in the planner
+      const bool isMoving: whether any move is queued or running
+    returns nothing
+*/
+void Stats::sample(const int depth, const bool isMoving){
+  plannerDepth = depth;
+  plannerPeak = max(plannerPeak, plannerDepth);
+  if(isMoving == isMotionOn) return;
+  isMotionOn = isMoving;
+  if(isMoving){
+    motionStartAt = micros();
+  }else{
+    addTime(&motionTime, (micros() - motionStartAt) / 1000);
+  }
+  return;
+} //end Stats::sample(const int, const bool)
+
+
+/*  void Stats::clear()
+    > clears every counter and the longest times, a motion under way is
+      still timed
+    no args
+    returns nothing
+*/
+void Stats::clear(){
+  lineCount = 0;
+  parseTime = statsTime{};
+  waitTime = statsTime{};
+  executeTime = statsTime{};
+  motionTime = statsTime{};
+  plannerPeak = plannerDepth;
+  noInterrupts();
+  rxPeak = 0;
+  underrunCount = 0;
+  overrunCount = 0;
+  interrupts();
+  return;
+} //end Stats::clear()
+
+
+/*  void Stats::report()
+    > prints the counters, last then longest for the times, eg
+        STATS T81234 LINES 42
+        PARSE US 212 MAX 836
+        WAIT US 0 MAX 1204316
+        EXEC US 52 MAX 4104
+        MOTION MS 1520 MAX 2312
+        PLANNER 3 MAX 8
+        RX MAX 96
+        UNDERRUNS 0 OVERRUNS 0
+        FREE RAM 614
+      T is millis() when printed. the counters of the step isr are read
+      with interrupts off, a 16 bit read could be torn by it
+    no args
+    returns nothing
+*/
+void Stats::report(){
+  noInterrupts();
+  uint16_t underruns = underrunCount;
+  uint16_t overruns = overrunCount;
+  interrupts();
+
+  uart.print(F("STATS T"));
+  uart.print(millis());
+  uart.print(F(" LINES "));
+  uart.println(lineCount);
+  printTime(F("PARSE US "), parseTime);
+  printTime(F("WAIT US "), waitTime);
+  printTime(F("EXEC US "), executeTime);
+  printTime(F("MOTION MS "), motionTime);
+  uart.print(F("PLANNER "));
+  uart.print(plannerDepth);
+  uart.print(F(" MAX "));
+  uart.println(plannerPeak);
+  uart.print(F("RX MAX "));
+  uart.println(rxPeak);
+  uart.print(F("UNDERRUNS "));
+  uart.print(underruns);
+  uart.print(F(" OVERRUNS "));
+  uart.println(overruns);
+  uart.print(F("FREE RAM "));
+  uart.println(halFreeRam());
+  return;
+} //end Stats::report()
+
+
+/*  protected void Stats::addTime(statsTime* time, const unsigned long duration)
+    > keeps a duration as the last, and as the longest if it is
+    args:
+      statsTime* time: the time to keep it in
+      const unsigned long duration: the duration
+    returns nothing
+*/
+void Stats::addTime(statsTime* time, const unsigned long duration){
+  time->last = duration;
+  time->peak = max(time->peak, duration);
+  return;
+} //end Stats::addTime(statsTime*, const unsigned long)
+
+
+/*  protected void Stats::printTime(const __FlashStringHelper* name, const statsTime& time)
+    > prints a line of a time, its name then the last and the longest
+    args:
+      const __FlashStringHelper* name: the name, ending with a space
+      const statsTime& time: the time
+    returns nothing
+*/
+void Stats::printTime(const __FlashStringHelper* name, const statsTime& time){
+  uart.print(name);
+  uart.print(time.last);
+  uart.print(F(" MAX "));
+  uart.println(time.peak);
+  return;
+} //end Stats::printTime(const __FlashStringHelper*, const statsTime&)
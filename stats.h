@@ -0,0 +1,84 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// stats.h                                                                   //
+//                                                                           //
+// Description:                                                              //
+//      This is the header file for the statistics counters, where the time  //
+//      between a line arriving and its steps ending goes.                   //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _STATS_H
+#define _STATS_H
+
+#include <Arduino.h>
+
+/*  struct statsTime
+    > contains a duration measured again and again, the last and the
+      longest since the counters were cleared
+*/
+struct statsTime{
+  unsigned long last{};
+  unsigned long peak{};
+};
+
+/*  class Stats
+    > counters and timestamps left on in every build, each costs a few
+      cycles where it is taken. micros() is only read at the ends of what
+      is timed, on the target it counts in 4us
+    > the owners of what is counted write to it: the loaders and
+      executePendingCommand() time the commands, Atrox::run() samples the
+      planner and the motion, the serial port and the step isr count
+      their own events straight into the public members
+    > on the host, time only passes between passes of loop(), what is
+      timed within one pass reads 0
+    public members:
+      volatile uint8_t rxPeak         most bytes waiting in the receive buffer, see uart.h
+      volatile uint16_t underrunCount times the step timer ran dry with the axes still moving,
+                                      their next steps came late
+      volatile uint16_t overrunCount  times the step isr ran past the next step it was due to send
+    public methods:
+      void lineParsed(const unsigned long): times the loading of a command, from the micros() given
+      void commandExecuted(const unsigned long): times a command waiting and executing, from the micros() given
+      void sample(const int, const bool): takes the planner depth and times the motion, on every loop
+      void clear(): clears every counter
+      void report(): prints the counters, see Command
+    usage:
+      stats: the one set of counters
+*/
+class Stats{
+  unsigned long lineCount{};
+  unsigned long loadedAt{};      //micros() the command waiting was loaded at
+  unsigned long motionStartAt{};
+  bool isMotionOn{false};
+
+  statsTime parseTime;           //in us, loading a command
+  statsTime waitTime;            //in us, from loaded to executed
+  statsTime executeTime;         //in us, Command::execute()
+  statsTime motionTime;          //in ms, from the axes starting to all at rest
+  uint8_t plannerDepth{};
+  uint8_t plannerPeak{};
+
+  public:
+    volatile uint8_t rxPeak{};
+    volatile uint16_t underrunCount{};
+    volatile uint16_t overrunCount{};
+
+    void lineParsed(const unsigned long startAt);
+    void commandExecuted(const unsigned long startAt);
+    void sample(const int depth, const bool isMoving);
+    void clear();
+    void report();
+  protected:
+    void addTime(statsTime* time, const unsigned long duration);
+    void printTime(const __FlashStringHelper* name, const statsTime& time);
+};
+
+extern Stats stats;
+
+#endif //_STATS_H
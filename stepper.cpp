@@ -0,0 +1,1222 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// stepper.cpp                                                               //
+//                                                                           //
+// Description:                                                              //
+//      This is the implementation file for the timer interrupt step         //
+//      generator. It uses the step timer of hal.h, timer1 on the target.    //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <Arduino.h>
+
+#include "hal.h"
+#include "kinematics.h"
+#include "stats.h"
+#include "stepper.h"
+#include "planner.h"
+
+
+//the step generator the timer isr services
+static Stepper* isrStepper{nullptr};
+
+ISR(TIMER1_COMPA_vect){
+  isrStepper->isr();
+}
+
+//the end of the step pulses, see hal.h
+ISR(TIMER1_COMPB_vect){
+  isrStepper->pulseIsr();
+}
+
+//the sync line of a cell, see hal.h
+ISR(PCINT2_vect){
+  isrStepper->syncIsr();
+}
+
+//ends of the per axis templates, see the bottom of this file
+template<> void Stepper::setupPins<AXIS_COUNT>(){}
+template<> void Stepper::setDirections<AXIS_COUNT>(){}
+template<> uint8_t Stepper::stepAxes<AXIS_COUNT>(const uint8_t lockedBits){ return 0; }
+template<> void Stepper::endPulses<AXIS_COUNT>(){}
+template<> uint8_t Stepper::readSwitches<AXIS_COUNT>(){ return 0; }
+
+
+/*  Stepper constructor Stepper(Planner*)
+    > constructs an idle step generator and sets the pins of the
+      machine profile, the step and direction pins as outputs and the
+      limit switches as pulled up inputs
+    args:
+      Planner* ptr: address of the planner to take blocks from
+*/
+Stepper::Stepper(Planner* ptr){
+  plannerPtr = ptr;
+  isrStepper = this;
+  setupPins<0>();
+} //end Stepper::Stepper(Planner*)
+
+
+/*  void Stepper::prepare()
+    > cuts the planned blocks into segments until the segment buffer is full
+      and starts the timer if it is idle
+      a block is cut along trapezoid ramps, or along s-curve ramps if it
+      has a jerk. a feed hold always brakes along the trapezoid
+      a tool path block takes a step block per segment, see prepareToolPath()
+      a planner block is freed once all of its segments are prepared
+      while jogging the segments come from the jog speeds instead, a few
+      ahead only, see prepareJog(). while streaming they are appended by
+      streamSegment(), this only starts the timer
+      this is a non-blocking function and must be called on every loop
+    no args
+    returns nothing
+*/
+void Stepper::prepare(){
+  if(isAbortRequested) return;
+  while(isJogOn && segmentCount() < JOG_SEGMENTS_AHEAD + 1 && prepareJog());
+  while(!isJogOn && !isStreamOn && !isSegmentBufferFull()){
+    if(prepBlock == nullptr){
+      prepBlock = plannerPtr->currentBlock();
+      if(prepBlock == nullptr) break;
+      loadBlock();
+    }
+    planBlock& block = *prepBlock;
+    if(isHoldRequested && prepSpeedSqr <= 0) break; //held, at rest
+
+    long stepCount{-1};
+    if(block.jerk > 0 && !isHoldRequested){
+      stepCount = prepareCurve(block);
+    }else{
+      rampTime = 0;
+    }
+    if(stepCount < 0) stepCount = prepareTrapezoid(block);
+
+    prepStepsLeft -= stepCount;
+    isRestPrepared = prepSpeedSqr <= 0;
+    if(prepStepsLeft == 0){
+      if(!isToolPathOn){
+        for(int axis{}; axis < AXIS_COUNT; axis++) prepPosition[axis] += block.steps[axis];
+        prepBlockIndex = (prepBlockIndex + 1) % (SEGMENT_BUFFER_SIZE - 1);
+      }
+      isToolPathOn = false;
+      plannerPtr->discardCurrentBlock();
+      prepBlock = nullptr;
+    }
+  }
+
+  if(!isRunning && segmentHead != segmentTail){
+    startTimer();
+  }
+  return;
+} //end Stepper::prepare()
+
+
+/*  void Stepper::setAxisScale(const int axis, const uint32_t scale)
+    > sets the fixed point unit scale of an axis, tool paths are solved
+      in um and millidegree and stepped with it
+    args:
+      const int axis: the axis
+      const uint32_t scale: steps per thousandth of a unit, see motorData::unitScale
+    returns nothing
+*/
+void Stepper::setAxisScale(const int axis, const uint32_t scale){
+  unitScale[axis] = scale;
+  return;
+} //end Stepper::setAxisScale(const int, const uint32_t)
+
+
+/*  void Stepper::hold()
+    > starts a feed hold, the axes brake along the acceleration of the
+      block being stepped and the rest of the moves is kept
+      this only sets a flag, it is safe to call from an interrupt
+    no args
+    returns nothing
+*/
+void Stepper::hold(){
+  isHoldRequested = true;
+  return;
+} //end Stepper::hold()
+
+
+/*  void Stepper::resume()
+    > ends a feed hold, the moves go on from rest where they were held
+      this only sets a flag, it is safe to call from an interrupt
+    no args
+    returns nothing
+*/
+void Stepper::resume(){
+  isHoldRequested = false;
+  return;
+} //end Stepper::resume()
+
+
+/*  bool Stepper::isHeld()
+    > checks whether a feed hold has come to a stop
+    no args
+    returns true if held and no step is sent anymore
+*/
+bool Stepper::isHeld(){
+  return isHoldRequested && !isBusy();
+} //end Stepper::isHeld()
+
+
+/*  void Stepper::abort()
+    > stops stepping at once, the step timer is stopped right here
+      nothing is prepared or started until reset()
+      it is safe to call from an interrupt
+    no args
+    returns nothing
+*/
+void Stepper::abort(){
+  //interrupts are left as they are, this may run inside one
+  isAbortRequested = true;
+  halTimerStop();
+  isRunning = false;
+  return;
+} //end Stepper::abort()
+
+
+/*  bool Stepper::isAborted()
+    > checks whether stepping was aborted and not reset yet
+    no args
+    returns true if aborted
+*/
+bool Stepper::isAborted(){
+  return isAbortRequested;
+} //end Stepper::isAborted()
+
+
+/*  void Stepper::reset()
+    > drops every prepared segment and the block being prepared, and
+      clears a hold or an abort. call once held or aborted, the planner
+      must then be cleared as well since its current block is dropped
+      the positions are kept, what is prepared next starts from them
+    no args
+    returns nothing
+*/
+void Stepper::reset(){
+  noInterrupts();
+  halTimerStop();
+  isRunning = false;
+  segmentTail = segmentHead;
+  execSegment = nullptr;
+  execBlockIndex = 0xFF;
+  isHoldRequested = false;
+  isAbortRequested = false;
+  isSyncWaiting = false;
+  syncTickCount = 0;
+  interrupts();
+  prepBlock = nullptr;
+  prepStepsLeft = 0;
+  prepSpeedSqr = 0;
+  rampTime = 0;
+  isRestPrepared = true;
+  isToolPathOn = false;
+  isJogOn = false;
+  isStreamOn = false;
+  for(int axis{}; axis < AXIS_COUNT; axis++) prepPosition[axis] = axisState[axis].position;
+  return;
+} //end Stepper::reset()
+
+
+/*  void Stepper::startJog()
+    > leaves the planner and steps the axes at their jog speeds, every
+      target at 0 until jog() is called. the axes must be at rest and
+      the planner empty. the jog runs until reset(), a stop or an abort
+    no args
+    returns nothing
+*/
+void Stepper::startJog(){
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    jogTarget[axis] = 0;
+    jogSpeed[axis] = 0;
+    jogDistance[axis] = 0;
+  }
+  isJogOn = true;
+  return;
+} //end Stepper::startJog()
+
+
+/*  void Stepper::jog(const int axis, const float speed, const float accel)
+    > sets the speed an axis is jogged toward, the next segment prepared
+      takes it
+    args:
+      const int axis: the axis
+      const float speed: in step per sec, negative to step backward
+      const float accel: in step per sec per sec, the speed follows the
+                         target no faster
+    returns nothing
+*/
+void Stepper::jog(const int axis, const float speed, const float accel){
+  jogTarget[axis] = speed;
+  jogAccel[axis] = accel;
+  return;
+} //end Stepper::jog(const int, const float, const float)
+
+
+/*  bool Stepper::isJogging()
+    > checks whether the axes are jogged instead of the planner's moves
+    no args
+    returns true if jogging
+*/
+bool Stepper::isJogging(){
+  return isJogOn;
+} //end Stepper::isJogging()
+
+
+/*  void Stepper::startStream()
+    > leaves the planner and steps the segments given to streamSegment()
+      as they are, see stream.h. the axes must be at rest and the
+      planner empty. the stream runs until endStream(), a stop or an abort
+    no args
+    returns nothing
+*/
+void Stepper::startStream(){
+  isStreamBlockUsed = true; //the next step block takes a slot of its own
+  isStreamOn = true;
+  return;
+} //end Stepper::startStream()
+
+
+/*  bool Stepper::canStream()
+    > checks whether a segment can be streamed now. a hold takes no more
+      segments, the ones streamed cannot be braked and run out
+    no args
+    returns true if there is room for a segment and no hold
+*/
+bool Stepper::canStream(){
+  return isStreamOn && !isHoldRequested && !isAbortRequested && !isSegmentBufferFull();
+} //end Stepper::canStream()
+
+
+/*  void Stepper::streamBlock(const unsigned long steps[], const uint8_t dirnBits, const unsigned long eventCount)
+    > starts a step block, the segments streamed next send its steps
+      with bresenham counters as a planned block's. its step events are
+      those given, or those of its dominant axis if more, at least 1
+      a block no segment was streamed in is overwritten, so the isr always
+      sees a new block index
+    args:
+      const unsigned long steps[]: unsigned steps per axis
+      const uint8_t dirnBits: bit set for axes moving backward
+      const unsigned long eventCount: step events, more than any axis
+                                      steps when the dominant axis is
+                                      another board's of a cell
+    returns nothing
+*/
+void Stepper::streamBlock(const unsigned long steps[], const uint8_t dirnBits, const unsigned long eventCount){
+  if(isStreamBlockUsed) prepBlockIndex = (prepBlockIndex + 1) % (SEGMENT_BUFFER_SIZE - 1);
+  isStreamBlockUsed = false;
+
+  stepBlock& block = blockBuffer[prepBlockIndex];
+  block.stepEventCount = max(eventCount, 1UL);
+  block.dirnBits = dirnBits;
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    block.steps[axis] = isAxisUsed(axis) ? steps[axis] : 0;
+    block.stepEventCount = max(block.stepEventCount, block.steps[axis]);
+  }
+  return;
+} //end Stepper::streamBlock(const unsigned long[], const uint8_t, const unsigned long)
+
+
+/*  void Stepper::streamSegment(const uint16_t stepCount, const uint8_t prescaler, const uint16_t ticks)
+    > appends a timed segment of the step block last started, check
+      canStream() first. the timer is started by prepare()
+    args:
+      const uint16_t stepCount: step events, at least 1
+      const uint8_t prescaler: timer clock select bits, see hal.h
+      const uint16_t ticks: timer ticks between step events
+    returns nothing
+*/
+void Stepper::streamSegment(const uint16_t stepCount, const uint8_t prescaler, const uint16_t ticks){
+  stepSegment& segment = segmentBuffer[segmentHead];
+  segment.stepCount = stepCount;
+  segment.timerTicks = ticks;
+  segment.prescaler = prescaler;
+  segment.blockIndex = prepBlockIndex;
+  isStreamBlockUsed = true;
+  isRestPrepared = false;
+  segmentHead = (segmentHead + 1) % SEGMENT_BUFFER_SIZE;
+  return;
+} //end Stepper::streamSegment(const uint16_t, const uint8_t, const uint16_t)
+
+
+/*  void Stepper::streamRest()
+    > marks the last segment streamed as ending at rest, the isr running
+      dry after it is not counted as an underrun
+    no args
+    returns nothing
+*/
+void Stepper::streamRest(){
+  isRestPrepared = true;
+  return;
+} //end Stepper::streamRest()
+
+
+/*  void Stepper::endStream()
+    > goes back to the planner's moves, call once the segments streamed
+      were stepped to the end. the sync line of a cell is let go
+    no args
+    returns nothing
+*/
+void Stepper::endStream(){
+  if(isStreamBlockUsed) prepBlockIndex = (prepBlockIndex + 1) % (SEGMENT_BUFFER_SIZE - 1);
+  isStreamOn = false;
+  if(isSyncLeadOn || isSyncFollowOn) halSyncEnd();
+  noInterrupts();
+  isSyncLeadOn = false;
+  isSyncFollowOn = false;
+  isSyncWaiting = false;
+  isSyncLostOn = false;
+  interrupts();
+  return;
+} //end Stepper::endStream()
+
+
+/*  bool Stepper::isStreaming()
+    > checks whether segments are streamed instead of the planner's moves
+    no args
+    returns true if streaming
+*/
+bool Stepper::isStreaming(){
+  return isStreamOn;
+} //end Stepper::isStreaming()
+
+
+/*  void Stepper::startSync(const bool isLead)
+    > steps the segments streamed in lockstep with the other boards of a
+      cell, over the sync line, call after startStream(). the lead ticks
+      the line as it starts a segment, a follower starts each segment on
+      a tick of the lead, the first one included
+      a follower held steps the segments it has left on its own timer,
+      the lead may have stopped ticking
+    args:
+      const bool isLead: true for the lead, false for a follower
+    returns nothing
+*/
+void Stepper::startSync(const bool isLead){
+  noInterrupts();
+  syncTickCount = 0;
+  isSyncWaiting = false;
+  isSyncLostOn = false;
+  isSyncLeadOn = isLead;
+  isSyncFollowOn = !isLead;
+  interrupts();
+  halSyncBegin(isLead);
+  return;
+} //end Stepper::startSync(const bool)
+
+
+/*  bool Stepper::isSyncFollowing()
+    > checks whether the segments streamed start on the ticks of a lead
+    no args
+    returns true if following
+*/
+bool Stepper::isSyncFollowing(){
+  return isSyncFollowOn;
+} //end Stepper::isSyncFollowing()
+
+
+/*  bool Stepper::isSyncLost()
+    > checks whether a follower ran dry in the middle of the stream, its
+      segments left start a tick late from then on
+    no args
+    returns true if lockstep was lost
+*/
+bool Stepper::isSyncLost(){
+  return isSyncLostOn;
+} //end Stepper::isSyncLost()
+
+
+/*  void Stepper::syncIsr()
+    > counts a tick of the lead, and starts the timer again if it was
+      stopped for it, the segment is started on the first interrupt
+      called from the sync line's pin change interrupt only
+    no args
+    returns nothing
+*/
+void Stepper::syncIsr(){
+  if(!isSyncFollowOn) return;
+  syncTickCount++;
+  if(isSyncWaiting && !isAbortRequested && !isPulseUp){
+    isSyncWaiting = false;
+    halTimerStart();
+  }
+  return;
+} //end Stepper::syncIsr()
+
+
+/*  bool Stepper::isBusy()
+    > checks whether prepared segments are still being stepped
+    no args
+    returns true if the timer is stepping
+*/
+bool Stepper::isBusy(){
+  return isRunning || segmentHead != segmentTail;
+} //end Stepper::isBusy()
+
+
+/*  long Stepper::position(const int axis)
+    > gets the position of an axis, counted by the isr
+    args:
+      const int axis: the axis
+    returns the position in step
+*/
+long Stepper::position(const int axis){
+  noInterrupts();
+  long axisStep = axisState[axis].position;
+  interrupts();
+  return axisStep;
+} //end Stepper::position(const int)
+
+
+/*  void Stepper::setPosition(const int axis, const long step)
+    > sets the position of an axis, eg once homed. the axis must be at rest
+    args:
+      const int axis: the axis
+      const long step: the position in step
+    returns nothing
+*/
+void Stepper::setPosition(const int axis, const long step){
+  noInterrupts();
+  axisState[axis].position = step;
+  interrupts();
+  prepPosition[axis] = step;
+  return;
+} //end Stepper::setPosition(const int, const long)
+
+
+/*  void Stepper::watchLimits(const uint8_t axisBits)
+    > has the isr read the limit switches of the axes given before every
+      step event. an axis is locked once its switch is pressed, and
+      stays locked until releaseLimits()
+    args:
+      const uint8_t axisBits: bit set for axes to watch
+    returns nothing
+*/
+void Stepper::watchLimits(const uint8_t axisBits){
+  noInterrupts();
+  lockBits &= ~axisBits;
+  watchBits = axisBits;
+  interrupts();
+  return;
+} //end Stepper::watchLimits(const uint8_t)
+
+
+/*  uint8_t Stepper::lockedAxes()
+    > gets the axes locked on their limit switch
+    no args
+    returns bit set for axes locked
+*/
+uint8_t Stepper::lockedAxes(){
+  return lockBits;
+} //end Stepper::lockedAxes()
+
+
+/*  void Stepper::releaseLimits()
+    > stops reading the limit switches and unlocks every axis
+    no args
+    returns nothing
+*/
+void Stepper::releaseLimits(){
+  noInterrupts();
+  watchBits = 0;
+  lockBits = 0;
+  interrupts();
+  return;
+} //end Stepper::releaseLimits()
+
+
+/*  uint8_t Stepper::readLimits()
+    > reads the limit switches of the machine profile now
+    no args
+    returns bit set for axes whose switch is pressed
+*/
+uint8_t Stepper::readLimits(){
+  return readSwitches<0>();
+} //end Stepper::readLimits()
+
+
+/*  void Stepper::isr()
+    > sends one step event, called from the timer interrupt only
+      the dominant axis steps on every event, the other axes when their
+      bresenham counter overflows. the step pins are raised and the pulse
+      interrupt is set to drop them STEP_PULSE_US later, the drivers get
+      the pulse width they need however short the bookkeeping. a block
+      that turns an axis waits DIRN_SETUP_US after the direction pins
+    no args
+    returns nothing
+*/
+void Stepper::isr(){
+  if(execSegment == nullptr){
+    if(segmentHead == segmentTail){
+      //ran dry, the main loop fell behind if the axes were still moving
+      if(!isRestPrepared){
+        stats.underrunCount++;
+        if(isSyncFollowOn) isSyncLostOn = true; //the lead went on
+      }
+      stopTimer();
+      halSegmentEvent(0, 0, 0, nullptr, 0);
+      return;
+    }
+    if(isSyncFollowOn && !isHoldRequested){
+      //a follower starts the segment on the lead's tick
+      if(syncTickCount == 0){
+        waitSync();
+        return;
+      }
+      syncTickCount--;
+    }
+    if(isSyncLeadOn) halSyncToggle();
+    execSegment = &segmentBuffer[segmentTail];
+    halTimerSet(execSegment->prescaler, execSegment->timerTicks);
+    execStepsLeft = execSegment->stepCount;
+
+    //new block, reset the counters and set the direction pins
+    if(execSegment->blockIndex != execBlockIndex){
+      execBlockIndex = execSegment->blockIndex;
+      execBlock = &blockBuffer[execBlockIndex];
+      setDirections<0>();
+      if(((execBlock->dirnBits ^ dirnPinBits) & machineAxisBits()) != 0){
+        dirnPinBits = execBlock->dirnBits;
+        halDirnSetup(DIRN_SETUP_US);
+      }
+      halSegmentEvent(execSegment->prescaler, execSegment->timerTicks, execStepsLeft,
+                      execBlock->steps, execBlock->dirnBits);
+    }else{
+      halSegmentEvent(execSegment->prescaler, execSegment->timerTicks, execStepsLeft, nullptr, 0);
+    }
+  }
+
+  if(watchBits != 0){
+    uint8_t hitBits = readSwitches<0>() & watchBits;
+    lockBits |= hitBits;
+    watchBits &= ~hitBits;
+  }
+  uint8_t stepBits = stepAxes<0>(lockBits);
+  halStepEvent(stepBits, execBlock->dirnBits);
+  if(stepBits != 0){
+    //armed before the timer may be stopped below, it runs on for the pulse
+    isPulseUp = true;
+    if(!halPulseStart(STEP_PULSE_US)) pulseIsr(); //late, the next event is due already
+  }
+
+  if(--execStepsLeft == 0){
+    segmentTail = (segmentTail + 1) % SEGMENT_BUFFER_SIZE;
+    execSegment = nullptr;
+    //a follower does not time the end of the segment, the lead's tick does
+    if(isSyncFollowOn && !isHoldRequested && syncTickCount == 0 && segmentHead != segmentTail) waitSync();
+  }
+
+  if(halTimerIsLate()) stats.overrunCount++;
+  return;
+} //end Stepper::isr()
+
+
+/*  void Stepper::pulseIsr()
+    > ends the step pulses, called from the pulse interrupt only
+      a follower whose lead ticked while the pulses were up starts its
+      segment now, so a step never comes while its pin is still high
+    no args
+    returns nothing
+*/
+void Stepper::pulseIsr(){
+  endPulses<0>();
+  halPulseEnd();
+  isPulseUp = false;
+  if(isSyncWaiting && syncTickCount > 0 && !isAbortRequested){
+    isSyncWaiting = false;
+    halTimerStart();
+  }
+  return;
+} //end Stepper::pulseIsr()
+
+
+/*  protected bool Stepper::isSegmentBufferFull()
+    > checks whether no more segment can be prepared
+    no args
+    returns true if the segment buffer is full
+*/
+bool Stepper::isSegmentBufferFull(){
+  return (segmentHead + 1) % SEGMENT_BUFFER_SIZE == segmentTail;
+} //end Stepper::isSegmentBufferFull()
+
+
+/*  protected int Stepper::segmentCount()
+    > counts the segments prepared and not stepped to the end yet
+    no args
+    returns the number of segments
+*/
+int Stepper::segmentCount(){
+  return (segmentHead + SEGMENT_BUFFER_SIZE - segmentTail) % SEGMENT_BUFFER_SIZE;
+} //end Stepper::segmentCount()
+
+
+/*  protected void Stepper::waitSync()
+    > stops the timer of a follower until the lead's tick, the axes are
+      still busy meanwhile. called from the isr only
+    no args
+    returns nothing
+*/
+void Stepper::waitSync(){
+  halTimerStop();
+  isSyncWaiting = true;
+  return;
+} //end Stepper::waitSync()
+
+
+/*  protected bool Stepper::prepareJog()
+    > prepares the next jog segment, 1 / SEGMENTS_PER_SEC sec long
+      the speed of each axis moves toward its target by at most its
+      acceleration over the segment, toward 0 on a hold. the distance at
+      the average speed is added to what is left of a step, whole steps
+      are sent and the fraction kept. the segment gets a step block of its
+      own, so every axis has its own step count and direction in it
+      nothing is prepared once every axis is at rest at a target of 0
+    no args
+    returns true if a segment was prepared
+*/
+bool Stepper::prepareJog(){
+  const float segmentTime = 1.0 / SEGMENTS_PER_SEC;
+  stepBlock& block = blockBuffer[prepBlockIndex];
+  block.stepEventCount = 0;
+  block.dirnBits = 0;
+  bool isAtRest{true};
+  bool isEndAtRest{true};
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    if(!isAxisUsed(axis)) continue;
+    float target = isHoldRequested ? 0 : jogTarget[axis];
+    float speed = jogSpeed[axis];
+    float change = jogAccel[axis] * segmentTime;
+    float endSpeed = constrain(target, speed - change, speed + change);
+    if(speed != 0 || endSpeed != 0) isAtRest = false;
+    if(endSpeed != 0) isEndAtRest = false;
+
+    jogDistance[axis] += (speed + endSpeed) / 2 * segmentTime;
+    long stepCount = (long)jogDistance[axis];
+    jogDistance[axis] -= stepCount;
+    jogSpeed[axis] = endSpeed;
+
+    block.steps[axis] = labs(stepCount);
+    if(stepCount < 0) block.dirnBits |= 1 << axis;
+    block.stepEventCount = max(block.stepEventCount, block.steps[axis]);
+  }
+  if(isAtRest) return false;
+
+  //no axis steps, a single event keeps the time
+  long eventCount = max(block.stepEventCount, 1UL);
+  block.stepEventCount = eventCount;
+  pushSegment(eventCount, eventCount / segmentTime);
+  prepBlockIndex = (prepBlockIndex + 1) % (SEGMENT_BUFFER_SIZE - 1);
+  isRestPrepared = isEndAtRest;
+  return true;
+} //end Stepper::prepareJog()
+
+
+/*  protected void Stepper::loadBlock()
+    > copies the bresenham data of the planner's current block out for the isr
+      the block starts at the speed the previous one was left at,
+      capped by its planned entry speed
+      a tool path block has its ends solved for the tool pose instead
+    no args
+    returns nothing
+*/
+void Stepper::loadBlock(){
+  if(!isBusy()){
+    //idle, the block starts from rest where the axes are
+    prepSpeedSqr = 0;
+    for(int axis{}; axis < AXIS_COUNT; axis++) prepPosition[axis] = position(axis);
+  }
+  if(isKinematic() && prepBlock->isToolPath) loadToolPath();
+
+  stepBlock& block = blockBuffer[prepBlockIndex];
+  block.stepEventCount = prepBlock->stepEventCount;
+  block.dirnBits = 0;
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    block.steps[axis] = labs(prepBlock->steps[axis]);
+    if(prepBlock->steps[axis] < 0) block.dirnBits |= 1 << axis;
+  }
+
+  prepStepsLeft = prepBlock->stepEventCount;
+  prepStepLength = prepBlock->length / prepBlock->stepEventCount;
+  prepSpeedSqr = min(prepSpeedSqr, prepBlock->entrySpeedSqr);
+  rampTime = 0;
+  return;
+} //end Stepper::loadBlock()
+
+
+/*  protected void Stepper::loadToolPath()
+    > works out the tool pose at the ends of the tool path block being
+      loaded, from the positions the block starts and ends at, see
+      kinematics in kinematics.h. the pose is interpolated between them
+      segment by segment
+      this divides in 64 bit, once per block
+    no args
+    returns nothing
+*/
+void Stepper::loadToolPath(){
+  long startOffset[3];
+  long endOffset[3];
+  for(int axis{}; axis < AXIS_COUNT; axis++) toolStart[axis] = prepPosition[axis];
+  for(int index{}; index < 2; index++){
+    int axis = W_AXIS + index;
+    headStart[index] = stepToMilli(toolStart[axis], unitScale[axis]);
+    headChange[index] = stepToMilli(toolStart[axis] + prepBlock->steps[axis], unitScale[axis]) - headStart[index];
+  }
+  toolOffset(headStart[0], headStart[1], startOffset);
+  toolOffset(headStart[0] + headChange[0], headStart[1] + headChange[1], endOffset);
+  for(int axis{}; axis <= Z_AXIS; axis++){
+    tipStart[axis] = stepToMilli(toolStart[axis], unitScale[axis]) + startOffset[axis];
+    tipChange[axis] = stepToMilli(toolStart[axis] + prepBlock->steps[axis], unitScale[axis]) + endOffset[axis]
+                      - tipStart[axis];
+  }
+  isToolPathOn = true;
+  return;
+} //end Stepper::loadToolPath()
+
+
+/*  protected long Stepper::prepareToolPath(const long stepCount)
+    > fills a step block of its own for the next segment of a tool path
+      block, from the tool pose at the end of the segment
+      the pose is taken at the fraction of the block's dominant axis
+      steps done by then: the tip on the straight line between its ends,
+      the head axes on theirs. the carriage goes where the tip less the
+      tool offset at the head's angles is, the head axes are not solved.
+      the last segment ends exactly where the block was planned to
+    args:
+      const long stepCount: steps of the block's dominant axis in the segment
+    returns the step events of the segment, at least 1
+*/
+long Stepper::prepareToolPath(const long stepCount){
+  long stepsDone = prepBlock->stepEventCount - prepStepsLeft + stepCount;
+  float fraction = (float)stepsDone / prepBlock->stepEventCount;
+  long target[AXIS_COUNT];
+  if(stepsDone >= prepBlock->stepEventCount){
+    for(int axis{}; axis < AXIS_COUNT; axis++) target[axis] = toolStart[axis] + prepBlock->steps[axis];
+  }else{
+    for(int axis{}; axis < AXIS_COUNT; axis++){
+      target[axis] = toolStart[axis] + lround(fraction * prepBlock->steps[axis]);
+    }
+    long offset[3];
+    toolOffset(headStart[0] + lround(fraction * headChange[0]), headStart[1] + lround(fraction * headChange[1]),
+               offset);
+    for(int axis{}; axis <= Z_AXIS; axis++){
+      long tip = tipStart[axis] + lround(fraction * tipChange[axis]);
+      target[axis] = milliToStep(tip - offset[axis], unitScale[axis]);
+    }
+  }
+
+  stepBlock& block = blockBuffer[prepBlockIndex];
+  block.stepEventCount = 0;
+  block.dirnBits = 0;
+  for(int axis{}; axis < AXIS_COUNT; axis++){
+    long axisSteps = target[axis] - prepPosition[axis];
+    prepPosition[axis] = target[axis];
+    block.steps[axis] = labs(axisSteps);
+    if(axisSteps < 0) block.dirnBits |= 1 << axis;
+    block.stepEventCount = max(block.stepEventCount, block.steps[axis]);
+  }
+  //no axis steps, a single event keeps the time
+  block.stepEventCount = max(block.stepEventCount, 1UL);
+  return block.stepEventCount;
+} //end Stepper::prepareToolPath(const long)
+
+
+/*  protected long Stepper::prepareTrapezoid(const planBlock& block)
+    > prepares the next segment of a block along trapezoid ramps
+      the segment lasts about 1 / SEGMENTS_PER_SEC sec at the speed the
+      path is at. its end speed is the highest that still respects the
+      acceleration from the block's entry speed, the cruise speed and the
+      deceleration to the planned exit speed. its steps are sent at the
+      average of its start and end speed
+      on a feed hold the end speed brakes toward rest instead
+    args:
+      const planBlock& block: the block being prepared
+    returns the steps of the dominant axis in the segment
+*/
+long Stepper::prepareTrapezoid(const planBlock& block){
+  float speed = sqrt(prepSpeedSqr);
+  long stepCount = (long)(speed / (SEGMENTS_PER_SEC * prepStepLength));
+  stepCount = constrain(stepCount, 1L, min(prepStepsLeft, 0xFFFFL));
+
+  float accelSpeedSqr = prepSpeedSqr + 2 * block.acceleration * stepCount * prepStepLength;
+  float decelSpeedSqr = plannerPtr->exitSpeedSqr() + 2 * block.acceleration * (prepStepsLeft - stepCount) * prepStepLength;
+  if(isHoldRequested){
+    //brake to rest, the last segment ends where the speed runs out
+    long stopSteps = (long)ceil(prepSpeedSqr / (2 * block.acceleration * prepStepLength));
+    stepCount = constrain(stopSteps, 1L, stepCount);
+    accelSpeedSqr = max(prepSpeedSqr - 2 * block.acceleration * stepCount * prepStepLength, 0.0f);
+  }
+  float endSpeedSqr = min(block.nominalSpeedSqr, min(accelSpeedSqr, decelSpeedSqr));
+
+  //a lone step from rest takes as long as accelerating then braking over it
+  float avgSpeed = max((speed + sqrt(endSpeedSqr)) / 2, 0.5 * sqrt(block.acceleration * prepStepLength));
+  pushSegment(stepCount, avgSpeed / prepStepLength);
+
+  prepSpeedSqr = endSpeedSqr;
+  return stepCount;
+} //end Stepper::prepareTrapezoid(const planBlock&)
+
+
+/*  protected long Stepper::prepareCurve(const planBlock& block)
+    > prepares the next segment of a block along s-curve ramps
+      a ramp changes speed in 7 segments: the acceleration builds up at
+      the block's jerk, holds at the block's acceleration, then falls
+      back to 0 at the same jerk, so the speed never turns a corner.
+      with no ramp under way, a ramp is started up to the highest speed
+      that leaves room to ramp down to the exit speed, or the path cruises
+      until only that room is left, then ramps down
+      a ramp is cut into segments of about 1 / SEGMENTS_PER_SEC sec, as
+      many steps as the speed covers in that time. the ramp is solved for
+      the time the last step of the segment is due at, the steps are sent
+      at an even rate in between. the isr stays as cheap as for a trapezoid
+      a block entered too fast to ramp down along the curve, eg since its
+      exit speed dropped, is left to the trapezoid
+    args:
+      const planBlock& block: the block being prepared
+    returns the steps of the dominant axis in the segment, -1 if the
+      segment must be prepared along the trapezoid
+*/
+long Stepper::prepareCurve(const planBlock& block){
+  const float segmentTime = 1.0 / SEGMENTS_PER_SEC;
+  if(rampTime <= 0){
+    float speed = sqrt(prepSpeedSqr);
+    float exitSpeed = sqrt(plannerPtr->exitSpeedSqr());
+    float length = prepStepsLeft * prepStepLength;
+    float brakeLength = rampLength(speed, exitSpeed, block);
+    if(brakeLength > length + prepStepLength) return -1;
+
+    //highest speed that leaves room to ramp down, a step is kept for rounding
+    float room = length - prepStepLength;
+    float peakSpeed = sqrt(block.nominalSpeedSqr);
+    if(rampLength(speed, peakSpeed, block) + rampLength(peakSpeed, exitSpeed, block) > room){
+      float lowSpeed = max(speed, exitSpeed);
+      float highSpeed = peakSpeed;
+      for(int i{}; i < 12; i++){
+        peakSpeed = (lowSpeed + highSpeed) / 2;
+        if(rampLength(speed, peakSpeed, block) + rampLength(peakSpeed, exitSpeed, block) > room){
+          highSpeed = peakSpeed;
+        }else{
+          lowSpeed = peakSpeed;
+        }
+      }
+      peakSpeed = lowSpeed;
+    }
+
+    if(peakSpeed > speed * 1.001 && rampLength(speed, peakSpeed, block) >= prepStepLength){
+      startRamp(speed, peakSpeed, block);
+    }else{
+      long cruiseSteps = (long)((length - brakeLength) / prepStepLength);
+      if(speed > 0 && cruiseSteps > 0){
+        long stepCount = (long)(speed * segmentTime / prepStepLength);
+        stepCount = constrain(stepCount, 1L, min(cruiseSteps, 0xFFFFL));
+        pushSegment(stepCount, speed / prepStepLength);
+        return stepCount;
+      }
+      if(brakeLength < prepStepLength) return -1; //under a step left to ramp over
+      startRamp(speed, exitSpeed, block);
+    }
+  }
+
+  //as many steps as the path covers in a segment time, the ramp is solved
+  //for the time they are done at
+  long stepCount = (long)(sqrt(prepSpeedSqr) * segmentTime / prepStepLength);
+  stepCount = constrain(stepCount, 1L, min(rampStepCount - rampSteps, min(prepStepsLeft, 0xFFFFL)));
+  float startTime = rampElapsed;
+  rampSteps += stepCount;
+  float distance = rampSteps * prepStepLength;
+  float rampEnd = rampDistance(rampTime);
+  float speed;
+  if(distance < rampEnd){
+    rampElapsed = rampTimeAt(distance);
+    speed = rampSpeed(rampElapsed);
+  }else{
+    //the steps rounded past the end of the ramp are sent at its end speed
+    speed = rampSpeed(rampTime);
+    rampElapsed = rampTime + (speed > 0 ? (distance - rampEnd) / speed : 0);
+  }
+
+  pushSegment(stepCount, stepCount / (rampElapsed - startTime));
+  prepSpeedSqr = speed * speed;
+  if(rampSteps >= rampStepCount) rampTime = 0;
+  return stepCount;
+} //end Stepper::prepareCurve(const planBlock&)
+
+
+/*  protected float Stepper::rampLength(const float fromSpeed, const float toSpeed, const planBlock& block)
+    > gets the path length an s-curve ramp takes between two speeds
+      the jerk phases last tj = min(a/j, sqrt(dv/j)) and the ramp
+      dv/(j*tj) + tj. the ramp is symmetric so its length is its time at
+      the average speed
+    args:
+      const float fromSpeed: speed the ramp starts at, in step per sec
+      const float toSpeed: speed the ramp ends at, in step per sec
+      const planBlock& block: the block, for its acceleration and jerk
+    returns the length in step
+*/
+float Stepper::rampLength(const float fromSpeed, const float toSpeed, const planBlock& block){
+  float delta = fabs(toSpeed - fromSpeed);
+  if(delta <= 0) return 0;
+  float jerkTime = min(block.acceleration / block.jerk, sqrt(delta / block.jerk));
+  return (fromSpeed + toSpeed) / 2 * (delta / (block.jerk * jerkTime) + jerkTime);
+} //end Stepper::rampLength(const float, const float, const planBlock&)
+
+
+/*  protected void Stepper::startRamp(const float fromSpeed, const float toSpeed, const planBlock& block)
+    > starts an s-curve ramp between two speeds, see rampLength()
+    args:
+      const float fromSpeed: speed the ramp starts at, in step per sec
+      const float toSpeed: speed the ramp ends at, in step per sec
+      const planBlock& block: the block, for its acceleration and jerk
+    returns nothing
+*/
+void Stepper::startRamp(const float fromSpeed, const float toSpeed, const planBlock& block){
+  float delta = fabs(toSpeed - fromSpeed);
+  rampJerkTime = min(block.acceleration / block.jerk, sqrt(delta / block.jerk));
+  rampPeakAccel = block.jerk * rampJerkTime;
+  rampTime = delta / rampPeakAccel + rampJerkTime;
+  rampStartSpeed = fromSpeed;
+  rampDelta = toSpeed - fromSpeed;
+  rampElapsed = 0;
+  rampSteps = 0;
+  rampStepCount = max(lround(rampDistance(rampTime) / prepStepLength), 1L);
+  //a step left over at the end of the block is taken into the ramp
+  if(prepStepsLeft - rampStepCount <= 1) rampStepCount = prepStepsLeft;
+  return;
+} //end Stepper::startRamp(const float, const float, const planBlock&)
+
+
+/*  protected float Stepper::rampDistance(const float time)
+    > gets the path length covered since the start of the ramp
+      the length gained over the start speed is j*t^3/6 while the
+      acceleration builds up, a parabola while it holds, and mirrors the
+      build up toward the end of the ramp
+    args:
+      const float time: time since the start of the ramp, in sec
+    returns the length in step
+*/
+float Stepper::rampDistance(const float time){
+  float delta = fabs(rampDelta);
+  float jerk = rampPeakAccel / rampJerkTime;
+  float gain;
+  if(time <= rampJerkTime){
+    gain = jerk * time * time * time / 6;
+  }else if(time <= rampTime - rampJerkTime){
+    float holdTime = time - rampJerkTime;
+    gain = rampPeakAccel * (rampJerkTime * rampJerkTime / 6 + rampJerkTime * holdTime / 2
+                            + holdTime * holdTime / 2);
+  }else{
+    float timeLeft = rampTime - time;
+    gain = delta * (rampTime / 2 - timeLeft) + jerk * timeLeft * timeLeft * timeLeft / 6;
+  }
+  return rampStartSpeed * time + (rampDelta < 0 ? -gain : gain);
+} //end Stepper::rampDistance(const float)
+
+
+/*  protected float Stepper::rampSpeed(const float time)
+    > gets the path speed since the start of the ramp
+    args:
+      const float time: time since the start of the ramp, in sec
+    returns the speed in step per sec
+*/
+float Stepper::rampSpeed(const float time){
+  float jerk = rampPeakAccel / rampJerkTime;
+  float gain;
+  if(time <= rampJerkTime){
+    gain = jerk * time * time / 2;
+  }else if(time <= rampTime - rampJerkTime){
+    gain = rampPeakAccel * (time - rampJerkTime / 2);
+  }else{
+    float timeLeft = rampTime - time;
+    gain = fabs(rampDelta) - jerk * timeLeft * timeLeft / 2;
+  }
+  return rampStartSpeed + (rampDelta < 0 ? -gain : gain);
+} //end Stepper::rampSpeed(const float)
+
+
+/*  protected float Stepper::rampTimeAt(const float distance)
+    > gets the time the ramp covers a path length at, by newton's method
+      kept inside the bounds it has narrowed down. the time is found
+      within a hundredth of a step in a few rounds
+    args:
+      const float distance: path length since the start of the ramp, in step
+    returns the time since the start of the ramp, in sec
+*/
+float Stepper::rampTimeAt(const float distance){
+  float lowTime{rampElapsed};
+  float highTime{rampTime};
+  float time = lowTime + (highTime - lowTime) / 2;
+  for(int i{}; i < 8; i++){
+    float error = rampDistance(time) - distance;
+    if(fabs(error) < 0.01 * prepStepLength) break;
+    if(error > 0){
+      highTime = time;
+    }else{
+      lowTime = time;
+    }
+    float speed = rampSpeed(time);
+    float nextTime = speed > 0 ? time - error / speed : 0;
+    time = (nextTime > lowTime && nextTime < highTime) ? nextTime : lowTime + (highTime - lowTime) / 2;
+  }
+  return time;
+} //end Stepper::rampTimeAt(const float)
+
+
+/*  protected void Stepper::pushSegment(const long stepCount, const float stepRate)
+    > appends a segment to the segment buffer
+      the step rate is turned into timer ticks, picking the finest timer
+      prescaler that can time it
+      a segment of a tool path block gets its own step block, its step
+      events are sent over the same time
+    args:
+      const long stepCount: steps of the dominant axis
+      const float stepRate: step rate of the dominant axis in step per sec
+    returns nothing
+*/
+void Stepper::pushSegment(const long stepCount, const float stepRate){
+  long eventCount{stepCount};
+  float eventRate{stepRate};
+  if(isToolPathOn){
+    eventCount = prepareToolPath(stepCount);
+    eventRate = stepRate * eventCount / stepCount;
+  }
+
+  stepSegment& segment = segmentBuffer[segmentHead];
+  segment.stepCount = eventCount;
+  segment.blockIndex = prepBlockIndex;
+
+  unsigned long cycles = F_CPU / min(eventRate, MAX_STEP_RATE);
+  if(cycles < 0x10000UL * 8){
+    segment.prescaler = TIMER_CLK_DIV8;
+    segment.timerTicks = cycles >> 3;
+  }else if(cycles < 0x10000UL * 64){
+    segment.prescaler = TIMER_CLK_DIV64;
+    segment.timerTicks = cycles >> 6;
+  }else{
+    segment.prescaler = TIMER_CLK_DIV256; //slowest rate is 0.95 step/sec
+    segment.timerTicks = min(cycles >> 8, 0xFFFFUL);
+  }
+
+  segmentHead = (segmentHead + 1) % SEGMENT_BUFFER_SIZE;
+  if(isToolPathOn) prepBlockIndex = (prepBlockIndex + 1) % (SEGMENT_BUFFER_SIZE - 1);
+  return;
+} //end Stepper::pushSegment(const long, const float)
+
+
+/*  protected void Stepper::startTimer()
+    > starts the step timer, the first step event follows right away
+    no args
+    returns nothing
+*/
+void Stepper::startTimer(){
+  noInterrupts();
+  if(!isAbortRequested){ //an abort may come in from an interrupt
+    isRunning = true;
+    halTimerStart();
+  }
+  interrupts();
+  return;
+} //end Stepper::startTimer()
+
+
+/*  protected void Stepper::stopTimer()
+    > stops the step timer once the segment buffer ran dry
+    no args
+    returns nothing
+*/
+void Stepper::stopTimer(){
+  halTimerStop();
+  isRunning = false;
+  return;
+} //end Stepper::stopTimer()
+
+
+/*  protected template<int AXIS> void Stepper::setupPins()
+    > sets the step and direction pins of AXIS and the axes after it
+      as outputs
+    no args
+    returns nothing
+*/
+template<int AXIS> void Stepper::setupPins(){
+  if(isAxisUsed(AXIS)){
+    pinMode(MACHINE_AXES[AXIS].stepPin, OUTPUT);
+    pinMode(MACHINE_AXES[AXIS].dirnPin, OUTPUT);
+  }
+  if(isAxisHomed(AXIS)) pinMode(MACHINE_HOMING[AXIS].limitPin, INPUT_PULLUP);
+  setupPins<AXIS + 1>();
+  return;
+} //end Stepper::setupPins<int>()
+
+
+/*  protected template<int AXIS> void Stepper::setDirections()
+    > resets the bresenham counters of AXIS and the axes after it, and
+      sets their direction pins for the block being stepped
+    no args
+    returns nothing
+*/
+template<int AXIS> void Stepper::setDirections(){
+  if(isAxisUsed(AXIS)){
+    axisState[AXIS].counter = -(long)(execBlock->stepEventCount >> 1);
+    if(execBlock->dirnBits & (1 << AXIS)){
+      halPinLow<MACHINE_AXES[AXIS].dirnPin>();
+    }else{
+      halPinHigh<MACHINE_AXES[AXIS].dirnPin>();
+    }
+  }
+  setDirections<AXIS + 1>();
+  return;
+} //end Stepper::setDirections<int>()
+
+
+/*  protected template<int AXIS> uint8_t Stepper::stepAxes(const uint8_t lockedBits)
+    > raises the step pins of AXIS and the axes after it whose bresenham
+      counter overflows, and counts their position
+      a locked axis keeps its counter going but is not stepped
+    args:
+      const uint8_t lockedBits: bit set for axes locked on their limit switch
+    returns the bits of the axes stepped
+*/
+template<int AXIS> uint8_t Stepper::stepAxes(const uint8_t lockedBits){
+  uint8_t stepBits{};
+  if(isAxisUsed(AXIS)){
+    stepAxis& state = axisState[AXIS];
+    state.counter += execBlock->steps[AXIS];
+    if(state.counter > 0){
+      state.counter -= execBlock->stepEventCount;
+      if(!(lockedBits & (1 << AXIS))){
+        halPinHigh<MACHINE_AXES[AXIS].stepPin>();
+        state.position += (execBlock->dirnBits & (1 << AXIS)) ? -1 : 1;
+        stepBits = 1 << AXIS;
+      }
+    }
+  }
+  return stepBits | stepAxes<AXIS + 1>(lockedBits);
+} //end Stepper::stepAxes<int>(const uint8_t)
+
+
+/*  protected template<int AXIS> void Stepper::endPulses()
+    > drops the step pins of AXIS and the axes after it
+    no args
+    returns nothing
+*/
+template<int AXIS> void Stepper::endPulses(){
+  if(isAxisUsed(AXIS)) halPinLow<MACHINE_AXES[AXIS].stepPin>();
+  endPulses<AXIS + 1>();
+  return;
+} //end Stepper::endPulses<int>()
+
+
+/*  protected template<int AXIS> uint8_t Stepper::readSwitches()
+    > reads the limit switches of AXIS and the axes after it, a pressed
+      switch pulls its pin low. axes without a switch are left out
+    no args
+    returns the bits of the axes whose switch is pressed
+*/
+template<int AXIS> uint8_t Stepper::readSwitches(){
+  uint8_t hitBits{};
+  if(isAxisHomed(AXIS) && !halPinRead<MACHINE_HOMING[AXIS].limitPin>()) hitBits = 1 << AXIS;
+  return hitBits | readSwitches<AXIS + 1>();
+} //end Stepper::readSwitches<int>()
@@ -0,0 +1,286 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// stepper.h                                                                 //
+//                                                                           //
+// Description:                                                              //
+//      This is the header file for the timer interrupt step generator.      //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _STEPPER_H
+#define _STEPPER_H
+
+#include <Arduino.h>
+
+#include "atrox.h"
+#include "machine.h"
+#include "planner.h"
+
+//step generator settings
+//number of prepared segments. the segments buffer keeps the isr fed while
+//the main loop is busy, for up to SEGMENT_BUFFER_SIZE / SEGMENTS_PER_SEC sec
+const int SEGMENT_BUFFER_SIZE = 6;
+//segments are cut to last about 1 / SEGMENTS_PER_SEC sec each
+const float SEGMENTS_PER_SEC = 200.0;
+//highest step rate the isr is allowed to run at, in step per sec
+constexpr float MAX_STEP_RATE = 30000.0;
+//driver timing, in us: how long a step pin is held high, and how long a
+//direction pin must settle before the next step. 2 and 1 suit the A4988
+//and the DRV8825, an opto coupled driver wants 5 or more of each
+const uint8_t STEP_PULSE_US = 2;
+const uint8_t DIRN_SETUP_US = 1;
+static_assert(STEP_PULSE_US + DIRN_SETUP_US < 1000000.0 / MAX_STEP_RATE / 2,
+              "the step pulses must end well before the next step at MAX_STEP_RATE");
+//segments prepared ahead while jogging, fewer than for moves so a change
+//of the joystick reaches the steps within (JOG_SEGMENTS_AHEAD + 1) segments
+const int JOG_SEGMENTS_AHEAD = 2;
+
+/*  struct stepBlock
+    > contains the bresenham data of a planned block, copied out of the
+      planner so the block can be freed once its segments are prepared
+*/
+struct stepBlock{
+  unsigned long steps[AXIS_COUNT]{};  //unsigned steps per axis
+  unsigned long stepEventCount{};     //steps of the dominant axis
+  uint8_t dirnBits{};                 //bit set for axes moving backward
+};
+
+/*  struct stepAxis
+    > contains what the isr touches of an axis on every step event, kept
+      together so an axis is one contiguous run of memory
+      the pins come from the machine profile at compile time
+*/
+struct stepAxis{
+  long counter{};            //bresenham counter
+  volatile long position{};  //position in step
+};
+
+/*  struct stepSegment
+    > contains a run of steps of the dominant axis sent at a constant rate
+*/
+struct stepSegment{
+  uint16_t stepCount{};   //steps of the dominant axis
+  uint16_t timerTicks{};  //timer ticks between steps
+  uint8_t prescaler{};    //timer clock select bits
+  uint8_t blockIndex{};   //stepBlock the segment belongs to
+};
+
+/*  class Stepper
+    > step pulse generator driven by a hardware timer interrupt
+    > the main loop cuts the planned blocks into segments of constant step
+      rate that follow the planned ramps. the timer isr only reads the
+      segments and distributes the steps to the axes with bresenham
+      counters, so step timing does not depend on the main loop
+    > the isr is unrolled per axis at compile time from the machine
+      profile, axes without pins are left out of it
+    > a block with a jerk is cut along s-curve ramps instead, the speed
+      follows a 7 segment jerk limited profile sampled once per segment,
+      see prepareCurve(). the isr is the same for both
+    > a feed hold brakes the segments still to be prepared along the
+      block's acceleration, the segments already prepared run out first.
+      an abort stops the timer at once, no matter the speed
+    > while jogging the planner is left out: each segment is worked out
+      from a speed per axis that follows its jog target within its
+      acceleration, its steps per axis are sent with the same bresenham
+      isr. a segment in which no axis steps is a single event that steps
+      nothing, so slow axes keep their timing. a hold brakes the targets
+      to 0, reset() ends the jog
+    > a tool path block is cut along its ramps as any other, but each
+      segment gets a step block of its own: the tool pose is interpolated
+      between the block's ends at the fraction of the block done, and the
+      carriage is solved for it, see prepareToolPath(). the tool tip goes
+      straight at segment resolution, where the block's own line would
+      bow as the head turns
+    > while streaming the planner is left out as well: the segments and
+      their step blocks come timed from a compiled stream, see stream.h,
+      and are sent by the same isr. they cannot be braked, a hold lets
+      the segments prepared run out
+    > a stream may be stepped in lockstep by the boards of a cell, each
+      stepping its own axes along the same segments. the lead ticks the
+      sync line as it starts a segment. a follower stops its timer after
+      the last step event of a segment and starts the next one on the
+      lead's tick, so its crystal is off by a segment's worth at most and
+      the error does not add up. a follower that runs dry while the lead
+      steps has lost lockstep, see isSyncLost()
+    > the isr raises the step pins and the compare interrupt of the step
+      timer drops them STEP_PULSE_US later, see pulseIsr(). a new block
+      that turns an axis waits DIRN_SETUP_US after its direction pin
+      before the first step
+    > the isr counts into stats when it runs dry before the axes were
+      prepared to rest, and when it runs past the next step, see stats.h
+    > while homing, the isr reads the limit switches watched before every
+      step event. an axis whose switch is pressed is locked, it is not
+      stepped anymore while the other axes go on
+    public methods:
+      void prepare(): cuts planned blocks into segments and starts the timer. call this on every loop
+      void setAxisScale(const int, const uint32_t): sets the fixed point unit scale of an axis, see motorData::unitScale
+      bool isBusy(): checks whether segments are still being stepped
+      long position(const int): gets the position of an axis, in step
+      void setPosition(const int, const long): sets the position of an axis at rest, in step
+      void hold(): brakes to a stop and keeps what is left of the moves. safe in an isr
+      void resume(): goes on with the moves held. safe in an isr
+      bool isHeld(): checks whether a hold has come to a stop
+      void abort(): stops stepping at once. safe in an isr
+      bool isAborted(): checks whether stepping was aborted and not reset yet
+      void reset(): drops every segment and the block being prepared, after a hold or an abort
+      void startJog(): leaves the planner and steps the axes at their jog speeds, from rest
+      void jog(const int, const float, const float): sets the jog target speed of an axis and its acceleration
+      bool isJogging(): checks whether the axes are jogged
+      void startStream(): leaves the planner and takes timed segments from streamSegment(), from rest
+      bool canStream(): checks whether a segment can be streamed, there is room and no hold
+      void streamBlock(const unsigned long[], const uint8_t, const unsigned long): starts a step block for the segments streamed next
+      void streamSegment(const uint16_t, const uint8_t, const uint16_t): appends a timed segment to the step block
+      void streamRest(): marks the last segment streamed as ending at rest
+      void endStream(): goes back to the planner, at rest
+      bool isStreaming(): checks whether segments are streamed
+      void startSync(const bool): steps the segments streamed in lockstep with the boards of a cell, as the lead or a follower
+      bool isSyncFollowing(): checks whether the segments streamed start on the lead's ticks
+      bool isSyncLost(): checks whether a follower ran dry while its lead stepped
+      void syncIsr(): counts a tick of the lead. called from the sync line's pin change interrupt only
+      void watchLimits(const uint8_t): locks the axes given as their limit switch is pressed
+      uint8_t lockedAxes(): gets the bits of the axes locked on their limit switch
+      void releaseLimits(): stops watching the limit switches and unlocks every axis
+      uint8_t readLimits(): gets the bits of the axes whose limit switch is pressed
+      void isr(): steps the axes. called from the timer interrupt only
+      void pulseIsr(): ends the step pulses. called from the timer's pulse interrupt only
+    usage:
+      Stepper(Planner*): initializes a step generator taking blocks from a planner
+*/
+class Stepper{
+  Planner* plannerPtr;
+
+  //buffers shared with the isr
+  stepBlock blockBuffer[SEGMENT_BUFFER_SIZE - 1];
+  stepSegment segmentBuffer[SEGMENT_BUFFER_SIZE];
+  volatile uint8_t segmentHead{};
+  volatile uint8_t segmentTail{};
+  volatile bool isRunning{false};
+  volatile bool isHoldRequested{false};
+  volatile bool isAbortRequested{false};
+  volatile uint8_t watchBits{};  //axes whose limit switch is read by the isr
+  volatile uint8_t lockBits{};   //axes not stepped, their switch was pressed
+  volatile bool isRestPrepared{true};  //the last segment prepared ends at rest
+
+  //isr state
+  stepSegment* execSegment{nullptr};
+  stepBlock* execBlock{nullptr};
+  uint8_t execBlockIndex{0xFF};
+  uint16_t execStepsLeft{};
+  stepAxis axisState[AXIS_COUNT];
+
+  //segment preparation state
+  planBlock* prepBlock{nullptr};
+  uint8_t prepBlockIndex{};
+  long prepStepsLeft{};
+  float prepStepLength{};
+  float prepSpeedSqr{};
+
+  //s-curve ramp being prepared, from its start
+  float rampTime{};        //length of the ramp in sec, 0 when no ramp is under way
+  float rampElapsed{};     //time prepared, in sec
+  float rampStartSpeed{};  //in step per sec
+  float rampDelta{};       //speed change, negative to slow down
+  float rampJerkTime{};    //time the acceleration takes to build up, in sec
+  float rampPeakAccel{};   //in step per sec per sec
+  long rampSteps{};        //steps of the dominant axis prepared
+  long rampStepCount{};    //steps of the dominant axis the ramp covers
+
+  //positions at the end of the segments prepared, moved on as a block
+  //is done or as a tool path segment is prepared, in step
+  long prepPosition[AXIS_COUNT]{};
+  uint32_t unitScale[AXIS_COUNT]{};
+
+  //tool path block being prepared, from its start, see prepareToolPath()
+  bool isToolPathOn{false};
+  long toolStart[AXIS_COUNT]{};  //positions the block starts at, in step
+  long tipStart[3]{};            //tool tip along x, y, z, in um
+  long tipChange[3]{};
+  long headStart[2]{};           //yaw and pitch, in millidegree
+  long headChange[2]{};
+
+  //jog, per axis, in step per sec and step
+  bool isJogOn{false};
+  float jogTarget[AXIS_COUNT]{};
+  float jogAccel[AXIS_COUNT]{};
+  float jogSpeed[AXIS_COUNT]{};
+  float jogDistance[AXIS_COUNT]{};  //fraction of a step not sent yet
+
+  //stream of timed segments
+  bool isStreamOn{false};
+  bool isStreamBlockUsed{false};  //a segment was streamed in the step block at prepBlockIndex
+
+  //lockstep of a cell, shared with the isrs
+  volatile bool isSyncLeadOn{false};
+  volatile bool isSyncFollowOn{false};
+  volatile bool isSyncWaiting{false};  //the timer is stopped until the lead's tick
+  volatile bool isSyncLostOn{false};
+  volatile uint8_t syncTickCount{};    //ticks of the lead whose segment is not started yet
+
+  //step pulses, shared with the isrs
+  volatile bool isPulseUp{false};  //step pins raised, not dropped yet
+  uint8_t dirnPinBits{0xFF};       //axes whose direction pin is low, backward
+
+  public:
+    Stepper(Planner* ptr);
+    void prepare();
+    void setAxisScale(const int axis, const uint32_t scale);
+    bool isBusy();
+    long position(const int axis);
+    void setPosition(const int axis, const long step);
+    void hold();
+    void resume();
+    bool isHeld();
+    void abort();
+    bool isAborted();
+    void reset();
+    void startJog();
+    void jog(const int axis, const float speed, const float accel);
+    bool isJogging();
+    void startStream();
+    bool canStream();
+    void streamBlock(const unsigned long steps[], const uint8_t dirnBits, const unsigned long eventCount);
+    void streamSegment(const uint16_t stepCount, const uint8_t prescaler, const uint16_t ticks);
+    void streamRest();
+    void endStream();
+    bool isStreaming();
+    void startSync(const bool isLead);
+    bool isSyncFollowing();
+    bool isSyncLost();
+    void syncIsr();
+    void watchLimits(const uint8_t axisBits);
+    uint8_t lockedAxes();
+    void releaseLimits();
+    uint8_t readLimits();
+    void isr();
+    void pulseIsr();
+  protected:
+    bool isSegmentBufferFull();
+    int segmentCount();
+    void waitSync();
+    bool prepareJog();
+    void loadBlock();
+    void loadToolPath();
+    long prepareToolPath(const long stepCount);
+    long prepareTrapezoid(const planBlock& block);
+    long prepareCurve(const planBlock& block);
+    float rampLength(const float fromSpeed, const float toSpeed, const planBlock& block);
+    void startRamp(const float fromSpeed, const float toSpeed, const planBlock& block);
+    float rampDistance(const float time);
+    float rampSpeed(const float time);
+    float rampTimeAt(const float distance);
+    void pushSegment(const long stepCount, const float stepRate);
+    void startTimer();
+    void stopTimer();
+    template<int AXIS> void setupPins();
+    template<int AXIS> void setDirections();
+    template<int AXIS> uint8_t stepAxes(const uint8_t lockedBits);
+    template<int AXIS> void endPulses();
+    template<int AXIS> uint8_t readSwitches();
+};
+
+#endif //_STEPPER_H
@@ -0,0 +1,233 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// stream.cpp                                                                //
+//                                                                           //
+// Description:                                                              //
+//      This is the implementation file for the step stream player.          //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <Arduino.h>
+
+#include "stream.h"
+
+
+/*  StreamReader constructor StreamReader(Stepper*)
+    > constructs a player waiting for the header of a stream
+    args:
+      Stepper* ptr: address of the step generator to stream into
+*/
+StreamReader::StreamReader(Stepper* ptr){
+  stepperPtr = ptr;
+} //end StreamReader::StreamReader(Stepper*)
+
+
+/*  int StreamReader::play(const uint8_t data[], const uint8_t length)
+    > plays the records of a checked frame into the step generator, from
+      the record the last call stopped at, until it has no room or a rest
+      is waited for. the header is read from the first frame
+      a stream refused or stopped, or whose lockstep was lost, has its
+      frames skipped
+    args:
+      const uint8_t data[]: payload of the frame
+      const uint8_t length: bytes of payload
+    returns int of play status
+      status 2 indicates records are left, call again with the same frame
+      status 8 indicates the frame was played or skipped
+*/
+int StreamReader::play(const uint8_t data[], const uint8_t length){
+  if(!isRefused && (!stepperPtr->isStreaming() || stepperPtr->isSyncLost())) refuse(); //stopped meanwhile
+  if(!isRefused && !isHeaderRead){
+    if(length < STREAM_HEADER_SIZE || (data[0] | ((uint16_t)data[1] << 8)) != STREAM_MAGIC
+       || data[2] != STREAM_VERSION || data[3] == 0 || (data[3] & ~streamAxisBits()) != 0
+       || data[4] != F_CPU / 1000000UL){
+      refuse();
+    }
+    axisBits = data[3];
+    index = STREAM_HEADER_SIZE;
+    isHeaderRead = true;
+  }
+
+  while(!isRefused && index < length){
+    int recordStatus = playRecord(data, length);
+    if(recordStatus == 2) return 2;
+    if(recordStatus == -1) refuse();
+  }
+  index = 0;
+  return 8;
+} //end StreamReader::play(const uint8_t[], const uint8_t)
+
+
+/*  void StreamReader::end()
+    > marks the stream as ended by its empty frame, the mode is left once
+      the axes are at rest
+    no args
+    returns nothing
+*/
+void StreamReader::end(){
+  isEnded = true;
+  return;
+} //end StreamReader::end()
+
+
+/*  bool StreamReader::isEnding()
+    > checks whether the empty frame ended the stream
+    no args
+    returns true if ended
+*/
+bool StreamReader::isEnding(){
+  return isEnded;
+} //end StreamReader::isEnding()
+
+
+/*  bool StreamReader::isPlayed()
+    > checks whether every record of the stream was played, call before
+      the stream is ended
+    no args
+    returns true if the stream was neither refused nor stopped, and a
+      follower of a cell kept lockstep
+*/
+bool StreamReader::isPlayed(){
+  return !isRefused && !stepperPtr->isSyncLost();
+} //end StreamReader::isPlayed()
+
+
+/*  void StreamReader::begin()
+    > starts over, the next frame played starts with the header of a
+      new stream
+    no args
+    returns nothing
+*/
+void StreamReader::begin(){
+  index = 0;
+  isHeaderRead = false;
+  isBlockSet = false;
+  isRefused = false;
+  isEnded = false;
+  axisBits = 0;
+  prescaler = 0;
+  ticks = 0;
+  tickChange = 0;
+  stepCount = 0;
+  isResting = false;
+  return;
+} //end StreamReader::begin()
+
+
+/*  protected int StreamReader::playRecord(const uint8_t data[], const uint8_t length)
+    > plays the record at index once the step generator has room for it,
+      a rest waits first for the axes to stop, then for its time. a
+      follower of a cell does not wait, its next segment waits for the
+      lead's tick
+      index moves past the record once played
+    args:
+      const uint8_t data[]: payload of the frame
+      const uint8_t length: bytes of payload
+    returns int of play status
+      status -1 indicates a record that cannot be played
+      status 1 indicates the record was played
+      status 2 indicates no room yet, or a rest being waited for
+*/
+int StreamReader::playRecord(const uint8_t data[], const uint8_t length){
+  if(isResting){
+    if(stepperPtr->isBusy()) return 2;
+    if(!isRestTimed){
+      restAt = millis();
+      isRestTimed = true;
+    }
+    if(millis() - restAt < restTime) return 2;
+    isResting = false;
+  }
+  if(!stepperPtr->canStream()) return 2;
+
+  uint8_t start = index;
+  uint8_t tag = data[start++];
+  uint32_t value{};
+  if(tag == STREAM_BLOCK || tag == STREAM_EVENT_BLOCK){
+    if(start >= length) return -1;
+    uint8_t dirnBits = data[start++];
+    uint32_t eventCount{};
+    if(tag == STREAM_EVENT_BLOCK && !readVarint(data, length, &start, &eventCount)) return -1;
+    unsigned long steps[AXIS_COUNT]{};
+    for(int axis{}; axis < AXIS_COUNT; axis++){
+      if(!(axisBits & (1 << axis))) continue;
+      if(!readVarint(data, length, &start, &value)) return -1;
+      steps[axis] = value;
+    }
+    stepperPtr->streamBlock(steps, dirnBits, eventCount);
+    isBlockSet = true;
+  }else if(tag == STREAM_REST){
+    if(!readVarint(data, length, &start, &value)) return -1;
+    stepperPtr->streamRest();
+    isResting = !stepperPtr->isSyncFollowing();
+    isRestTimed = false;
+    restTime = value;
+  }else{
+    //a segment at the last rate, along the ramp or at a new rate
+    long rateTicks{ticks};
+    if(tag >= STREAM_SEGMENT){
+      value = tag - STREAM_SEGMENT;
+      if(value == 0 && !readVarint(data, length, &start, &value)) return -1;
+    }else if(tag >= STREAM_RAMP){
+      uint8_t change = tag - STREAM_RAMP;
+      value = stepCount;
+      rateTicks += tickChange + ((change >> 1) ^ -(change & 1));
+    }else if(tag >= STREAM_RATE && tag < STREAM_RATE + STREAM_PRESCALER_COUNT){
+      uint32_t change{};
+      if(!readVarint(data, length, &start, &change) || !readVarint(data, length, &start, &value)) return -1;
+      rateTicks += (long)(change >> 1) ^ -(long)(change & 1);
+      prescaler = STREAM_PRESCALERS[tag - STREAM_RATE];
+    }else{
+      return -1;
+    }
+    if(!isBlockSet || prescaler == 0 || rateTicks < 1 || rateTicks > 0xFFFF || value == 0 || value > 0xFFFF){
+      return -1;
+    }
+    tickChange = rateTicks - ticks;
+    ticks = rateTicks;
+    stepCount = value;
+    stepperPtr->streamSegment(stepCount, prescaler, ticks);
+  }
+  index = start;
+  return 1;
+} //end StreamReader::playRecord(const uint8_t[], const uint8_t)
+
+
+/*  protected bool StreamReader::readVarint(const uint8_t data[], const uint8_t length, uint8_t* start,
+                                            uint32_t* value)
+    > reads a varint of the frame, see stream.h
+    args:
+      const uint8_t data[]: payload of the frame
+      const uint8_t length: bytes of payload
+      uint8_t* start: index of the varint, moved past it
+      uint32_t* value: where the number goes
+    returns true if read, false if it runs over the frame or 32 bits
+*/
+bool StreamReader::readVarint(const uint8_t data[], const uint8_t length, uint8_t* start, uint32_t* value){
+  *value = 0;
+  for(uint8_t shift{}; shift < 32; shift += 7){
+    if(*start >= length) return false;
+    uint8_t incoming = data[(*start)++];
+    *value |= (uint32_t)(incoming & 0x7F) << shift;
+    if(!(incoming & 0x80)) return true;
+  }
+  return false;
+} //end StreamReader::readVarint(const uint8_t[], const uint8_t, uint8_t*, uint32_t*)
+
+
+/*  protected void StreamReader::refuse()
+    > refuses the rest of the stream, the step generator takes no more
+      segments and the ones streamed run out
+    no args
+    returns nothing
+*/
+void StreamReader::refuse(){
+  isRefused = true;
+  if(stepperPtr->isStreaming()) stepperPtr->hold();
+  return;
+} //end StreamReader::refuse()
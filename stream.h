@@ -0,0 +1,151 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// stream.h                                                                  //
+//                                                                           //
+// Description:                                                              //
+//      This is the header file for the step stream player. A stream holds   //
+//      step segments timed ahead by host/compile.cpp, they are handed to    //
+//      the step generator as they are, with no parsing or planning.         //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _STREAM_H
+#define _STREAM_H
+
+#include <Arduino.h>
+
+#include "hal.h"
+#include "machine.h"
+#include "stepper.h"
+
+/*  stream mode, entered with M721 and left with an empty frame
+    the stream comes in binary frames, see binproto.h, a record never
+    runs over the end of its frame. a frame is answered with BIN_ACK as
+    soon as it is checked, it is played from memory while the next one
+    comes in. the empty frame is answered once the axes are at rest:
+    BIN_ACK if the stream was played, BIN_CAN if it was refused or stopped
+
+    header: magic low | magic high | version | axis bits | cpu mhz
+            at the start of the first frame. the axis bits are the axes
+            the stream steps, the machine profile's or fewer on a board
+            of a cell. a stream of other axes, or of another cpu clock,
+            is refused
+
+    records:
+      STREAM_BLOCK | dirn bits | steps of each axis of the header's axis bits
+            starts a step block, see Stepper::streamBlock()
+      STREAM_EVENT_BLOCK | dirn bits | step events | steps of each axis
+            starts a step block with more step events than its axes
+            step, on a board of a cell whose dominant axis is another's
+      STREAM_RATE + prescaler | tick change | step events
+            a segment at a new rate, prescaler 0-2 for clk/8, /64 and /256,
+            the ticks are changed from the last rate, from 0 at first
+      STREAM_RAMP + zigzag coded change, 0-63
+            a segment of as many step events at the last prescaler, its
+            ticks changed by as much as the last segment's were, and by
+            -32 to 31 more. one byte per segment along a ramp
+      STREAM_SEGMENT + step events, 1-127
+            a segment at the last rate
+      STREAM_SEGMENT | step events
+            a segment at the last rate, 128-65535 step events
+      STREAM_REST | ms
+            the axes come to rest after the last segment, and wait as long
+            before the next one
+
+    numbers are varints: 7 bits a byte, low bits first, the high bit set
+    on every byte but the last. the tick change is zigzag coded, 0 -1 1
+    -2 as 0 1 2 3
+
+    a stop, a feed hold or an emergency stop cannot brake the segments
+    streamed, they run out, a few 1 / SEGMENTS_PER_SEC sec, and the rest
+    of the stream is skipped
+
+    a cell is several boards sharing a job, each stepping some of its
+    axes, with MACHINE_SYNC_PIN wired together. each board plays a stream
+    of its own axes along the same segments, see host/cell.cpp. the lead,
+    M721 S1, ticks the line as it starts a segment and times the rests,
+    the followers, M721 S2, start each segment on its tick, see
+    Stepper::startSync(). a follower must hold its first frame before the
+    lead starts, and a stop is sent to every board
+*/
+const uint16_t STREAM_MAGIC = 0x5A7E;
+const uint8_t STREAM_VERSION = 1;
+const int STREAM_HEADER_SIZE = 5;
+
+const uint8_t STREAM_BLOCK = 0x01;
+const uint8_t STREAM_REST = 0x02;
+const uint8_t STREAM_EVENT_BLOCK = 0x03;
+const uint8_t STREAM_RATE = 0x10;
+const uint8_t STREAM_RAMP = 0x40;
+const uint8_t STREAM_SEGMENT = 0x80;
+
+//timer clock select bits of the prescalers of STREAM_RATE
+const uint8_t STREAM_PRESCALERS[] = {TIMER_CLK_DIV8, TIMER_CLK_DIV64, TIMER_CLK_DIV256};
+const int STREAM_PRESCALER_COUNT = 3;
+
+/*  constexpr uint8_t streamAxisBits(const int axis)
+    > gets the axes of the machine profile a stream carries steps for
+    args:
+      const int axis: first axis, 0 for all of them
+    returns bit set for each axis used from axis on
+*/
+constexpr uint8_t streamAxisBits(const int axis = 0){
+  return machineAxisBits(axis);
+}
+
+/*  class StreamReader
+    > plays the records of a stream's frames into the step generator,
+      as far as it has room. a frame is played over as many calls as it
+      takes, a rest waits for the axes to stop and for its time
+    > the stream is refused on a header of another machine, or a record
+      that cannot be played, or once a follower of a cell lost lockstep.
+      the step generator is then held, the segments streamed run out and
+      the frames left are skipped
+    public methods:
+      int play(const uint8_t[], const uint8_t): plays the records of a frame from where the last call stopped
+      void end(): marks the stream as ended, by its empty frame
+      bool isEnding(): checks whether the stream was ended
+      bool isPlayed(): checks whether the stream was played, not refused nor stopped nor out of lockstep
+      void begin(): starts over, waiting for the header of a new stream
+    usage:
+      StreamReader(Stepper*): initializes a player waiting for a stream
+*/
+class StreamReader{
+  Stepper* stepperPtr;
+
+  uint8_t index{};         //next record of the frame being played
+  bool isHeaderRead{false};
+  bool isBlockSet{false};  //segments have a step block to go in
+  bool isRefused{false};
+  bool isEnded{false};
+  uint8_t axisBits{};      //of the header
+  uint8_t prescaler{};
+  uint16_t ticks{};
+  long tickChange{};       //from the segment before the last one
+  uint16_t stepCount{};    //of the last segment
+
+  //rest being waited for
+  bool isResting{false};
+  bool isRestTimed{false};  //the axes came to rest, at restAt
+  unsigned long restAt{};
+  unsigned long restTime{}; //in ms
+
+  public:
+    StreamReader(Stepper* ptr);
+    int play(const uint8_t data[], const uint8_t length);
+    void end();
+    bool isEnding();
+    bool isPlayed();
+    void begin();
+  protected:
+    int playRecord(const uint8_t data[], const uint8_t length);
+    bool readVarint(const uint8_t data[], const uint8_t length, uint8_t* start, uint32_t* value);
+    void refuse();
+};
+
+#endif //_STREAM_H
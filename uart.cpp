@@ -0,0 +1,294 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// uart.cpp                                                                  //
+//                                                                           //
+// Description:                                                              //
+//      This is the implementation file for the interrupt driven serial      //
+//      port. It uses the serial port of hal.h, usart0 on the target.        //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#include <Arduino.h>
+
+#include "binproto.h"
+#include "hal.h"
+#include "stats.h"
+#include "uart.h"
+
+
+Uart uart;
+
+ISR(USART_RX_vect){
+  uart.rxIsr(halUartRead());
+}
+
+ISR(USART_UDRE_vect){
+  uart.txIsr();
+}
+
+
+/*  void Uart::begin(const unsigned long baud)
+    > starts the serial port in 8N1, with the receive interrupt on
+    args:
+      const unsigned long baud: baud rate
+    returns nothing
+*/
+void Uart::begin(const unsigned long baud){
+  halUartBegin(baud);
+  return;
+} //end Uart::begin(const unsigned long)
+
+
+/*  void Uart::setRawMode(const bool isRaw)
+    > switches raw mode on or off
+      bytes received so far are dropped, the host must wait for the answer
+      to the switching command before sending in the new mode
+    args:
+      const bool isRaw: true for raw mode
+    returns nothing
+*/
+void Uart::setRawMode(const bool isRaw){
+  noInterrupts();
+  isRawMode = isRaw;
+  rawLeft = 0;
+  rxTail = rxHead;
+  rxLines = 0;
+  rxLineStart = rxHead;
+  isLineDropped = false;
+  isLineEmpty = true;
+  interrupts();
+  if(isXoff){
+    isXoff = false;
+    sendFlowChar(XON_CHAR);
+  }
+  return;
+} //end Uart::setRawMode(const bool)
+
+
+/*  void Uart::setRealtimeHandler(void (*handler)(const uint8_t))
+    > sets the function real-time bytes are handed to
+      it runs in the receive interrupt, so it must only set flags or stop
+      what cannot wait
+    args:
+      void (*handler)(const uint8_t): the function, given the byte
+    returns nothing
+*/
+void Uart::setRealtimeHandler(void (*handler)(const uint8_t)){
+  noInterrupts();
+  realtimeHandler = handler;
+  interrupts();
+  return;
+} //end Uart::setRealtimeHandler(void (*)(const uint8_t))
+
+
+/*  int Uart::available()
+    > gets the number of bytes that can be read
+      only bytes of complete lines count, unless in raw mode
+    no args
+    returns the number of bytes
+*/
+int Uart::available(){
+  if(!isRawMode && rxLines == 0) return 0;
+  noInterrupts();
+  int count = (rxHead + RX_BUFFER_SIZE - rxTail) % RX_BUFFER_SIZE;
+  interrupts();
+  return count;
+} //end Uart::available()
+
+
+/*  int Uart::lineCount()
+    > gets the number of complete lines waiting to be read
+    no args
+    returns the number of lines
+*/
+int Uart::lineCount(){
+  return rxLines;
+} //end Uart::lineCount()
+
+
+/*  int Uart::rxFree()
+    > gets the free room in the receive buffer
+    no args
+    returns the free room in bytes
+*/
+int Uart::rxFree(){
+  noInterrupts();
+  int free = (rxTail + RX_BUFFER_SIZE - rxHead - 1) % RX_BUFFER_SIZE;
+  interrupts();
+  return free;
+} //end Uart::rxFree()
+
+
+/*  int Uart::read()
+    > reads one byte of a complete line
+      bytes of the line still being received are not given out,
+      unless in raw mode
+    no args
+    returns the byte read, -1 if no byte can be read
+*/
+int Uart::read(){
+  if(isRawMode){
+    if(rxHead == rxTail) return -1;
+  }else if(rxLines == 0){
+    return -1;
+  }
+
+  uint8_t data = rxBuffer[rxTail];
+  noInterrupts();
+  rxTail = (rxTail + 1) % RX_BUFFER_SIZE;
+  if(!isRawMode && data == '\n') rxLines--;
+  interrupts();
+
+  if(USE_XONXOFF && isXoff && rxFree() >= 2 * RX_XOFF_MARGIN){
+    isXoff = false;
+    sendFlowChar(XON_CHAR);
+  }
+  return data;
+} //end Uart::read()
+
+
+/*  size_t Uart::write(uint8_t data)
+    > queues one byte to be sent by the transmit interrupt
+      waits for room if the send buffer is full
+    args:
+      uint8_t data: the byte to send
+    returns the number of bytes written
+*/
+size_t Uart::write(uint8_t data){
+  uint8_t nextHead = (txHead + 1) % TX_BUFFER_SIZE;
+  while(nextHead == txTail){
+    //called with interrupts off, send by polling
+    if(halUartCanPoll()) txIsr();
+  }
+  txBuffer[txHead] = data;
+  txHead = nextHead;
+  halUartTxInterrupt(true);
+  return 1;
+} //end Uart::write(uint8_t)
+
+
+/*  void Uart::rxIsr(const uint8_t data)
+    > stores a received byte and splits lines, called from the receive interrupt only
+      two bytes are always kept free so that a dropped line can be replaced
+      by LINE_DROPPED_CHAR and its line end
+    args:
+      const uint8_t data: the byte received
+    returns nothing
+*/
+void Uart::rxIsr(const uint8_t data){
+  if(isRawMode){
+    //follow the frames: sync, length, payload and two crc bytes
+    if(rawLeft == 0){
+      if(isRealtime(data)){
+        if(realtimeHandler != nullptr) realtimeHandler(data);
+        return;
+      }
+      if(data == BIN_SYNC) rawLeft = 0xFF; //length next
+    }else if(rawLeft == 0xFF){
+      rawLeft = min(data, (uint8_t)BINARY_FRAME_SIZE) + 2;
+    }else{
+      rawLeft--;
+    }
+
+    uint8_t nextHead = (rxHead + 1) % RX_BUFFER_SIZE;
+    if(nextHead != rxTail){
+      rxBuffer[rxHead] = data;
+      rxHead = nextHead;
+      uint8_t count = (rxHead + RX_BUFFER_SIZE - rxTail) % RX_BUFFER_SIZE;
+      if(count > stats.rxPeak) stats.rxPeak = count;
+    }
+    return;
+  }
+
+  if(isRealtime(data)){
+    if(realtimeHandler != nullptr) realtimeHandler(data);
+    return;
+  }
+
+  if(data == '\n' || data == '\r'){
+    if(isLineDropped){
+      rxHead = rxLineStart;
+      rxBuffer[rxHead] = LINE_DROPPED_CHAR;
+      rxHead = (rxHead + 1) % RX_BUFFER_SIZE;
+      isLineEmpty = false;
+      isLineDropped = false;
+    }
+    if(!isLineEmpty){
+      rxBuffer[rxHead] = '\n';
+      rxHead = (rxHead + 1) % RX_BUFFER_SIZE;
+      rxLines++;
+    }
+    isLineEmpty = true;
+    rxLineStart = rxHead;
+    return;
+  }
+
+  if(isLineDropped || data <= ' ' || data == 0x7F) return; //whitespace and control bytes
+
+  int free = (rxTail + RX_BUFFER_SIZE - rxHead - 1) % RX_BUFFER_SIZE;
+  if(free <= 2){
+    isLineDropped = true;
+    return;
+  }
+  rxBuffer[rxHead] = data;
+  rxHead = (rxHead + 1) % RX_BUFFER_SIZE;
+  isLineEmpty = false;
+  if(RX_BUFFER_SIZE - free > stats.rxPeak) stats.rxPeak = RX_BUFFER_SIZE - free;
+
+  if(USE_XONXOFF && !isXoff && free <= RX_XOFF_MARGIN){
+    isXoff = true;
+    sendFlowChar(XOFF_CHAR);
+  }
+  return;
+} //end Uart::rxIsr(const uint8_t)
+
+
+/*  void Uart::txIsr()
+    > sends the next byte, called from the transmit interrupt only
+      a pending xon or xoff is sent ahead of the buffer
+    no args
+    returns nothing
+*/
+void Uart::txIsr(){
+  if(flowChar != 0){
+    halUartWrite(flowChar);
+    flowChar = 0;
+    return;
+  }
+  if(txHead == txTail){
+    halUartTxInterrupt(false);
+    return;
+  }
+  halUartWrite(txBuffer[txTail]);
+  txTail = (txTail + 1) % TX_BUFFER_SIZE;
+  return;
+} //end Uart::txIsr()
+
+
+/*  protected void Uart::sendFlowChar(const uint8_t flow)
+    > sends xon or xoff ahead of the bytes waiting in the send buffer
+    args:
+      const uint8_t flow: XON_CHAR or XOFF_CHAR
+    returns nothing
+*/
+void Uart::sendFlowChar(const uint8_t flow){
+  flowChar = flow;
+  halUartTxInterrupt(true);
+  return;
+} //end Uart::sendFlowChar(const uint8_t)
+
+
+/*  protected bool Uart::isRealtime(const uint8_t data)
+    > checks whether a byte is a real-time byte
+    args:
+      const uint8_t data: the byte
+    returns true if it is one
+*/
+bool Uart::isRealtime(const uint8_t data){
+  return data == RT_FEED_HOLD || data == RT_RESUME || data == RT_STOP || data == RT_ESTOP;
+} //end Uart::isRealtime(const uint8_t)
@@ -0,0 +1,106 @@
+// PROJECT ATROX v0.001.1
+//***************************************************************************//
+// uart.h                                                                    //
+//                                                                           //
+// Description:                                                              //
+//      This is the header file for the interrupt driven serial port.        //
+//                                                                           //
+// Written by Antares Husky (antares xavier kiriakov)                        //
+// Distributed under the GNU AGPLv3 license                                  //
+// xray77n@gmail.com                                                         //
+// 17 OCT 2026; Last revision: 17 OCT 2026                                   //
+//***************************************************************************//
+
+
+#ifndef _UART_H
+#define _UART_H
+
+#include <Arduino.h>
+
+//serial port settings
+//the host may keep up to RX_BUFFER_SIZE - 1 bytes in flight when counting
+//characters. with xon/xoff it may stream freely
+const int RX_BUFFER_SIZE = 128;
+const int TX_BUFFER_SIZE = 64;
+//send xoff when less than this many bytes are free, xon when twice as many are
+const int RX_XOFF_MARGIN = 24;
+const bool USE_XONXOFF = true;
+
+const uint8_t XON_CHAR = 0x11;
+const uint8_t XOFF_CHAR = 0x13;
+const uint8_t LINE_DROPPED_CHAR = 0x15; //stands for a line lost to an overflow
+
+//real-time bytes, acted on by the receive interrupt as they arrive and never
+//stored, so they do not wait behind the lines received before them
+const uint8_t RT_FEED_HOLD = '!';   //M76
+const uint8_t RT_RESUME = '~';      //M108
+const uint8_t RT_STOP = 0x85;       //M0
+const uint8_t RT_ESTOP = 0x18;      //M112
+
+/*  class Uart
+    > serial port owned by the firmware, replacing the core's Serial
+    > received bytes are stored by the receive interrupt in a ring buffer
+      larger than the core's. lines are split as they arrive: line ends
+      are unified to '\n', empty lines and whitespace are dropped and
+      complete lines are counted, so the parser only takes whole lines
+    > a line that does not fit in the buffer is replaced by
+      LINE_DROPPED_CHAR, which the parser rejects
+    > sends xoff when the buffer is nearly full and xon once it drained
+    > the most bytes waiting in the buffer is kept in stats, see stats.h
+    > in raw mode bytes are stored as they are, for the binary protocol.
+      there is no line splitting and no xon/xoff
+    > real-time bytes are handed to the real-time handler from the receive
+      interrupt. in raw mode only in between binary frames, the frames
+      are followed by their length for that
+    public methods:
+      void begin(const unsigned long): starts the port at a baud rate
+      void setRawMode(const bool): switches raw mode on or off, dropping the received bytes
+      void setRealtimeHandler(void (*)(const uint8_t)): sets the function real-time bytes are handed to
+      int available(): gets the number of bytes that can be read
+      int lineCount(): gets the number of complete lines received
+      int rxFree(): gets the free room in the receive buffer
+      int read(): reads one byte of a complete line, or any byte in raw mode. -1 if there is none
+      size_t write(uint8_t): sends one byte, waits if the send buffer is full
+      void rxIsr(const uint8_t): stores a received byte. called from the receive interrupt only
+      void txIsr(): sends the next byte. called from the transmit interrupt only
+    usage:
+      uart: the one serial port, used as Serial would be
+*/
+class Uart : public Print{
+  uint8_t rxBuffer[RX_BUFFER_SIZE];
+  volatile uint8_t rxHead{};
+  volatile uint8_t rxTail{};
+  volatile uint8_t rxLines{};
+  uint8_t rxLineStart{};      //where the line being received starts
+  bool isLineDropped{false};  //line being received overflowed
+  bool isLineEmpty{true};     //no byte stored since the last line end
+  volatile bool isRawMode{false};
+  uint8_t rawLeft{};          //bytes left of the binary frame being received
+  void (*realtimeHandler)(const uint8_t){nullptr};
+
+  uint8_t txBuffer[TX_BUFFER_SIZE];
+  volatile uint8_t txHead{};
+  volatile uint8_t txTail{};
+  volatile uint8_t flowChar{};   //xon or xoff waiting to be sent ahead of the buffer
+  volatile bool isXoff{false};
+
+  public:
+    void begin(const unsigned long baud);
+    void setRawMode(const bool isRaw);
+    void setRealtimeHandler(void (*handler)(const uint8_t));
+    int available();
+    int lineCount();
+    int rxFree();
+    int read();
+    size_t write(uint8_t data);
+    using Print::write;
+    void rxIsr(const uint8_t data);
+    void txIsr();
+  protected:
+    void sendFlowChar(const uint8_t flow);
+    bool isRealtime(const uint8_t data);
+};
+
+extern Uart uart;
+
+#endif //_UART_H